@@ -8,6 +8,8 @@
 #include "VectorMath.h"
 #include <vector>
 #include <stack>
+#include <cmath>
+#include <cfloat>
 
 #include "AABB.h"
 
@@ -167,6 +169,12 @@ class PYBIND11_EXPORT AABBTree
         //! Update the AABB of a particle
         inline void update(unsigned int idx, const AABB& aabb);
 
+        //! Refit the tree to a new list of AABBs
+        inline void refit(const AABB *aabbs, unsigned int N);
+
+        //! Get the surface area cost of the tree
+        inline Scalar getCost() const;
+
         //! Get the height of a given particle's leaf node
         inline unsigned int height(unsigned int idx);
 
@@ -240,7 +248,7 @@ class PYBIND11_EXPORT AABBTree
             {
             return (m_nodes[node].particle_tags[j]);
             }
-    private:
+    protected:
         AABBNode *m_nodes;                  //!< The nodes of the tree
         unsigned int m_num_nodes;           //!< Number of nodes
         unsigned int m_node_capacity;       //!< Capacity of the nodes array
@@ -350,6 +358,63 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+
+    Recomputes the boxes of all nodes bottom up from the new particle boxes. refit() keeps the tree topology, so
+    it requires the same particles at the same indices as the last buildTree(). Unlike update(), it also shrinks
+    the node boxes. The query efficiency degrades when particles move far from their initial neighbors, check
+    getCost() to decide when to rebuild the tree.
+*/
+inline void AABBTree::refit(const AABB *aabbs, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    // buildNode() allocates the children after their parent
+    for (int node_idx = int(m_num_nodes) - 1; node_idx >= 0; node_idx--)
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (node.left == INVALID_NODE)
+            {
+            node.aabb = aabbs[node.particles[0]];
+            for (unsigned int i = 1; i < node.num_particles; i++)
+                node.aabb = merge(node.aabb, aabbs[node.particles[i]]);
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
+/*! \returns The expected number of box and particle tests in a query of a random box
+
+    The cost is the surface area heuristic: the surface area of every internal node plus the surface area of every
+    leaf node times its number of particles, relative to the surface area of the root.
+*/
+inline Scalar AABBTree::getCost() const
+    {
+    if (m_num_nodes == 0)
+        return Scalar(0.0);
+
+    Scalar cost(0.0);
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        vec3<Scalar> l = m_nodes[node_idx].aabb.getUpper() - m_nodes[node_idx].aabb.getLower();
+        Scalar area = l.x*l.y + l.y*l.z + l.z*l.x;
+        if (m_nodes[node_idx].left == INVALID_NODE)
+            area *= Scalar(m_nodes[node_idx].num_particles);
+        cost += area;
+        }
+
+    vec3<Scalar> l = m_nodes[m_root].aabb.getUpper() - m_nodes[m_root].aabb.getLower();
+    Scalar root_area = l.x*l.y + l.y*l.z + l.z*l.x;
+    if (root_area <= Scalar(0.0))
+        return Scalar(0.0);
+
+    return cost / root_area;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -608,6 +673,441 @@ inline unsigned int AABBTree::allocateNode()
     return m_num_nodes-1;
     }
 
+//! Number of children of a node in an AABBTreeWide
+#if defined(__AVX__)
+const unsigned int WIDE_NODE_WIDTH = 8;
+#else
+const unsigned int WIDE_NODE_WIDTH = 4;
+#endif
+
+const unsigned int WIDE_LEAF_FLAG = 0x80000000; //!< Marks children of an AABBNodeWide that are leaves of the binary tree
+const unsigned int WIDE_STACK_SIZE = 256;        //!< Size of the traversal stack of AABBTreeWide
+
+//! Node in an AABBTreeWide
+/*! The bounding boxes of all children are stored in structure of arrays layout and in single precision, so that a query
+    box can be tested against all of them at once with a few vector instructions. The boxes are rounded outward when
+    they are stored, so that the test never misses an overlap. Unused children have empty boxes.
+*/
+struct PYBIND11_EXPORT AABBNodeWide
+    {
+    //! Default constructor
+    AABBNodeWide()
+        : parent(INVALID_NODE), parent_slot(0), num_children(0)
+        {
+        for (unsigned int k = 0; k < WIDE_NODE_WIDTH; k++)
+            {
+            lower_x[k] = lower_y[k] = lower_z[k] = FLT_MAX;
+            upper_x[k] = upper_y[k] = upper_z[k] = -FLT_MAX;
+            child[k] = INVALID_NODE;
+            }
+        }
+
+    float lower_x[WIDE_NODE_WIDTH];     //!< Lower x bound of the children
+    float lower_y[WIDE_NODE_WIDTH];     //!< Lower y bound of the children
+    float lower_z[WIDE_NODE_WIDTH];     //!< Lower z bound of the children
+    float upper_x[WIDE_NODE_WIDTH];     //!< Upper x bound of the children
+    float upper_y[WIDE_NODE_WIDTH];     //!< Upper y bound of the children
+    float upper_z[WIDE_NODE_WIDTH];     //!< Upper z bound of the children
+    unsigned int child[WIDE_NODE_WIDTH]; //!< Wide node index of each child, or binary leaf node index | WIDE_LEAF_FLAG
+    unsigned int parent;                //!< Index of the parent node
+    unsigned int parent_slot;           //!< Child slot of this node in its parent
+    unsigned int num_children;          //!< Number of children in use
+    };
+
+//! Round a coordinate down to single precision
+/*! The result is smaller than or equal to \a x. It is at most a few ulps smaller, which avoids the cost of exact
+    directed rounding.
+*/
+inline float round_down(Scalar x)
+    {
+    return float(x - std::abs(x)*Scalar(FLT_EPSILON));
+    }
+
+//! Round a coordinate up to single precision
+/*! The result is larger than or equal to \a x.
+*/
+inline float round_up(Scalar x)
+    {
+    return float(x + std::abs(x)*Scalar(FLT_EPSILON));
+    }
+
+//! Test a query box against all children of a wide node
+/*! \param node Node to test
+    \param lower Lower corner of the query box (x, y, z, rounded down)
+    \param upper Upper corner of the query box (x, y, z, rounded up)
+    \returns A bit mask of the children that overlap the query box
+*/
+inline unsigned int overlap(const AABBNodeWide& node, const float *lower, const float *upper)
+    {
+    #if defined(__AVX__)
+    __m256 r = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(node.lower_x), _mm256_set1_ps(upper[0]), _CMP_LE_OQ),
+                             _mm256_cmp_ps(_mm256_loadu_ps(node.upper_x), _mm256_set1_ps(lower[0]), _CMP_GE_OQ));
+    r = _mm256_and_ps(r, _mm256_cmp_ps(_mm256_loadu_ps(node.lower_y), _mm256_set1_ps(upper[1]), _CMP_LE_OQ));
+    r = _mm256_and_ps(r, _mm256_cmp_ps(_mm256_loadu_ps(node.upper_y), _mm256_set1_ps(lower[1]), _CMP_GE_OQ));
+    r = _mm256_and_ps(r, _mm256_cmp_ps(_mm256_loadu_ps(node.lower_z), _mm256_set1_ps(upper[2]), _CMP_LE_OQ));
+    r = _mm256_and_ps(r, _mm256_cmp_ps(_mm256_loadu_ps(node.upper_z), _mm256_set1_ps(lower[2]), _CMP_GE_OQ));
+    return (unsigned int)_mm256_movemask_ps(r);
+
+    #elif defined(__SSE__)
+    __m128 r = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(node.lower_x), _mm_set1_ps(upper[0])),
+                          _mm_cmpge_ps(_mm_loadu_ps(node.upper_x), _mm_set1_ps(lower[0])));
+    r = _mm_and_ps(r, _mm_cmple_ps(_mm_loadu_ps(node.lower_y), _mm_set1_ps(upper[1])));
+    r = _mm_and_ps(r, _mm_cmpge_ps(_mm_loadu_ps(node.upper_y), _mm_set1_ps(lower[1])));
+    r = _mm_and_ps(r, _mm_cmple_ps(_mm_loadu_ps(node.lower_z), _mm_set1_ps(upper[2])));
+    r = _mm_and_ps(r, _mm_cmpge_ps(_mm_loadu_ps(node.upper_z), _mm_set1_ps(lower[2])));
+    return (unsigned int)_mm_movemask_ps(r);
+
+    #else
+    unsigned int mask = 0;
+    for (unsigned int k = 0; k < WIDE_NODE_WIDTH; k++)
+        {
+        if (   node.lower_x[k] <= upper[0] && node.upper_x[k] >= lower[0]
+            && node.lower_y[k] <= upper[1] && node.upper_y[k] >= lower[1]
+            && node.lower_z[k] <= upper[2] && node.upper_z[k] >= lower[2])
+            mask |= 1 << k;
+        }
+    return mask;
+
+    #endif
+    }
+
+//! AABB Tree with wide nodes
+/*! AABBTreeWide is an AABBTree that additionally collapses the binary tree into a tree with up to WIDE_NODE_WIDTH
+    (4 with SSE, 8 with AVX) children per node. The children of a wide node are tested against a query box in one
+    vector operation (see AABBNodeWide), which visits far fewer nodes than the stackless traversal of the binary tree.
+
+    The leaves of the wide tree are the leaf nodes of the binary tree. queryNodes() returns the indices of the leaf
+    nodes that overlap a box, and their particles are accessed with the usual getNodeNumParticles(),
+    getNodeParticle(), and getNodeParticleTag() methods. All methods of AABBTree remain available, so code that
+    traverses the binary tree works on an AABBTreeWide unchanged.
+
+    The wide tree is traversed with a fixed size stack. In the rare case that the tree is too deep for it,
+    queryNodes() falls back to the stackless traversal of the binary tree.
+*/
+class PYBIND11_EXPORT AABBTreeWide : public AABBTree
+    {
+    public:
+        //! Construct an AABBTreeWide
+        AABBTreeWide()
+            : m_wide_root(INVALID_NODE), m_wide_depth(0)
+            {
+            }
+
+        //! Build a tree smartly from a list of AABBs
+        inline void buildTree(AABB *aabbs, unsigned int N);
+
+        //! Find all leaf nodes that overlap with the query AABB
+        inline unsigned int queryNodes(std::vector<unsigned int>& hits, const AABB& aabb) const;
+
+        //! Find all particles that overlap with the query AABB
+        inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
+
+        //! Update the AABB of a particle
+        inline void update(unsigned int idx, const AABB& aabb);
+
+        //! Refit the tree to a new list of AABBs
+        inline void refit(const AABB *aabbs, unsigned int N);
+
+        //! Get the number of wide nodes
+        inline unsigned int getNumWideNodes() const
+            {
+            return (unsigned int)m_wide_nodes.size();
+            }
+
+    protected:
+        std::vector<AABBNodeWide> m_wide_nodes;     //!< The nodes of the wide tree
+        unsigned int m_wide_root;                   //!< Index of the root of the wide tree
+        unsigned int m_wide_depth;                  //!< Depth of the wide tree
+        std::vector<unsigned int> m_leaf_node;      //!< Wide node containing each binary leaf node
+        std::vector<unsigned int> m_leaf_slot;      //!< Child slot of each binary leaf node in its wide node
+        std::vector<unsigned int> m_child_node;     //!< Binary node of each child slot (WIDE_NODE_WIDTH per wide node)
+
+        //! Build a wide node from a binary subtree recursively
+        inline unsigned int buildWideNode(unsigned int node, unsigned int parent, unsigned int parent_slot,
+                                          unsigned int depth);
+
+        //! Set the box of a child of a wide node
+        inline void setChildAABB(AABBNodeWide& node, unsigned int slot, const AABB& aabb);
+    };
+
+/*! \param aabbs List of AABBs for each particle (must be 32-byte aligned)
+    \param N Number of AABBs in the list
+
+    Builds the binary tree with AABBTree::buildTree() and collapses it into the wide tree.
+*/
+inline void AABBTreeWide::buildTree(AABB *aabbs, unsigned int N)
+    {
+    AABBTree::buildTree(aabbs, N);
+
+    m_wide_nodes.clear();
+    m_wide_depth = 0;
+    m_leaf_node.assign(m_num_nodes, INVALID_NODE);
+    m_leaf_slot.assign(m_num_nodes, 0);
+    m_child_node.clear();
+    m_wide_root = INVALID_NODE;
+
+    if (m_num_nodes > 0)
+        m_wide_root = buildWideNode(m_root, INVALID_NODE, 0, 0);
+    }
+
+/*! \param node Root of the binary subtree
+    \param parent Index of the parent wide node
+    \param parent_slot Child slot of the new node in \a parent
+    \param depth Depth of the new node
+    \returns The index of the new wide node
+
+    The children of the wide node are found by repeatedly replacing the internal binary node with the largest
+    surface area by its two children, until there are WIDE_NODE_WIDTH children or all of them are leaves.
+*/
+inline unsigned int AABBTreeWide::buildWideNode(unsigned int node,
+                                                unsigned int parent,
+                                                unsigned int parent_slot,
+                                                unsigned int depth)
+    {
+    unsigned int my_idx = (unsigned int)m_wide_nodes.size();
+    m_wide_nodes.push_back(AABBNodeWide());
+    m_child_node.resize(m_child_node.size() + WIDE_NODE_WIDTH, INVALID_NODE);
+    m_wide_nodes[my_idx].parent = parent;
+    m_wide_nodes[my_idx].parent_slot = parent_slot;
+    m_wide_depth = std::max(m_wide_depth, depth);
+
+    // collect the children
+    unsigned int children[WIDE_NODE_WIDTH];
+    unsigned int n_children = 0;
+    if (isNodeLeaf(node))
+        children[n_children++] = node;
+    else
+        {
+        children[n_children++] = m_nodes[node].left;
+        children[n_children++] = m_nodes[node].right;
+        }
+
+    while (n_children < WIDE_NODE_WIDTH)
+        {
+        // find the internal node with the largest surface area
+        unsigned int expand = WIDE_NODE_WIDTH;
+        Scalar max_area = Scalar(-1.0);
+        for (unsigned int k = 0; k < n_children; k++)
+            {
+            if (isNodeLeaf(children[k]))
+                continue;
+            vec3<Scalar> l = m_nodes[children[k]].aabb.getUpper() - m_nodes[children[k]].aabb.getLower();
+            Scalar area = l.x*l.y + l.y*l.z + l.z*l.x;
+            if (area > max_area)
+                {
+                max_area = area;
+                expand = k;
+                }
+            }
+
+        if (expand == WIDE_NODE_WIDTH)
+            break;
+
+        // replace it by its children, keeping the order of the binary tree
+        for (unsigned int k = n_children; k > expand + 1; k--)
+            children[k] = children[k-1];
+        unsigned int expand_node = children[expand];
+        children[expand] = m_nodes[expand_node].left;
+        children[expand+1] = m_nodes[expand_node].right;
+        n_children++;
+        }
+
+    for (unsigned int k = 0; k < n_children; k++)
+        {
+        unsigned int child;
+        if (isNodeLeaf(children[k]))
+            {
+            child = children[k] | WIDE_LEAF_FLAG;
+            m_leaf_node[children[k]] = my_idx;
+            m_leaf_slot[children[k]] = k;
+            }
+        else
+            {
+            // note: buildWideNode may reallocate m_wide_nodes
+            child = buildWideNode(children[k], my_idx, k, depth+1);
+            }
+
+        m_wide_nodes[my_idx].child[k] = child;
+        m_child_node[my_idx*WIDE_NODE_WIDTH + k] = children[k];
+        setChildAABB(m_wide_nodes[my_idx], k, m_nodes[children[k]].aabb);
+        }
+    m_wide_nodes[my_idx].num_children = n_children;
+
+    return my_idx;
+    }
+
+/*! \param node Wide node
+    \param slot Child slot
+    \param aabb Box to set, rounded outward to single precision
+*/
+inline void AABBTreeWide::setChildAABB(AABBNodeWide& node, unsigned int slot, const AABB& aabb)
+    {
+    vec3<Scalar> lower = aabb.getLower();
+    vec3<Scalar> upper = aabb.getUpper();
+    node.lower_x[slot] = round_down(lower.x);
+    node.lower_y[slot] = round_down(lower.y);
+    node.lower_z[slot] = round_down(lower.z);
+    node.upper_x[slot] = round_up(upper.x);
+    node.upper_y[slot] = round_up(upper.y);
+    node.upper_z[slot] = round_up(upper.z);
+    }
+
+/*! \param hits Output vector of the indices of overlapping leaf nodes
+    \param aabb The AABB to query
+    \returns the number of box overlap checks made during the traversal
+
+    The *hits* vector is not cleared, elements are only added with push_back.
+*/
+inline unsigned int AABBTreeWide::queryNodes(std::vector<unsigned int>& hits, const AABB& aabb) const
+    {
+    unsigned int box_overlap_counts = 0;
+
+    if (m_wide_root == INVALID_NODE)
+        return 0;
+
+    // a node at depth d leaves at most d*(WIDE_NODE_WIDTH-1) entries on the stack
+    if ((m_wide_depth+1)*(WIDE_NODE_WIDTH-1)+1 > WIDE_STACK_SIZE)
+        {
+        // stackless search of the binary tree
+        for (unsigned int current_node_idx = 0; current_node_idx < m_num_nodes; current_node_idx++)
+            {
+            box_overlap_counts++;
+            if (overlap(m_nodes[current_node_idx].aabb, aabb))
+                {
+                if (m_nodes[current_node_idx].left == INVALID_NODE)
+                    hits.push_back(current_node_idx);
+                }
+            else
+                {
+                current_node_idx += m_nodes[current_node_idx].skip;
+                }
+            }
+        return box_overlap_counts;
+        }
+
+    vec3<Scalar> l = aabb.getLower();
+    vec3<Scalar> u = aabb.getUpper();
+    const float lower[3] = {round_down(l.x), round_down(l.y), round_down(l.z)};
+    const float upper[3] = {round_up(u.x), round_up(u.y), round_up(u.z)};
+
+    // avoid pointer indirection overhead of std::vector
+    const AABBNodeWide *nodes = &m_wide_nodes[0];
+
+    unsigned int stack[WIDE_STACK_SIZE];
+    unsigned int stack_size = 0;
+    stack[stack_size++] = m_wide_root;
+
+    while (stack_size > 0)
+        {
+        const AABBNodeWide& current_node = nodes[stack[--stack_size]];
+
+        box_overlap_counts += current_node.num_children;
+        unsigned int mask = overlap(current_node, lower, upper);
+
+        // push the children in reverse, so that they are visited in order
+        while (mask)
+            {
+            unsigned int k = 31 - __builtin_clz(mask);
+            mask &= ~(1u << k);
+
+            unsigned int child = current_node.child[k];
+            if (child & WIDE_LEAF_FLAG)
+                hits.push_back(child & ~WIDE_LEAF_FLAG);
+            else
+                stack[stack_size++] = child;
+            }
+        }
+
+    return box_overlap_counts;
+    }
+
+/*! \param hits Output vector of positive hits.
+    \param aabb The AABB to query
+    \returns the number of box overlap checks made during the traversal
+
+    The *hits* vector is not cleared, elements are only added with push_back. The index of each particle in a leaf
+    node that intersects *aabb* is added to the hits vector.
+*/
+inline unsigned int AABBTreeWide::query(std::vector<unsigned int>& hits, const AABB& aabb) const
+    {
+    unsigned int first = (unsigned int)hits.size();
+    unsigned int box_overlap_counts = queryNodes(hits, aabb);
+
+    // replace the leaf nodes by their particles in place, filling from the back. Every leaf holds at least one
+    // particle, so a leaf index is always read before its slot is overwritten
+    unsigned int n_leaves = (unsigned int)hits.size() - first;
+    unsigned int n_hits = 0;
+    for (unsigned int k = first; k < first + n_leaves; k++)
+        n_hits += m_nodes[hits[k]].num_particles;
+    hits.resize(first + n_hits);
+
+    unsigned int out = first + n_hits;
+    for (unsigned int k = first + n_leaves; k-- > first;)
+        {
+        const AABBNode& leaf = m_nodes[hits[k]];
+        for (unsigned int i = leaf.num_particles; i-- > 0;)
+            hits[--out] = leaf.particles[i];
+        }
+
+    return box_overlap_counts;
+    }
+
+/*! \param idx Particle index to update
+    \param aabb New AABB for particle *idx*
+
+    Grows the boxes of the binary and the wide tree that contain particle *idx* to include *aabb*, see
+    AABBTree::update().
+*/
+inline void AABBTreeWide::update(unsigned int idx, const AABB& aabb)
+    {
+    AABBTree::update(idx, aabb);
+
+    unsigned int leaf = m_mapping[idx];
+    unsigned int node = m_leaf_node[leaf];
+    unsigned int slot = m_leaf_slot[leaf];
+
+    vec3<Scalar> l = aabb.getLower();
+    vec3<Scalar> u = aabb.getUpper();
+    const float lower[3] = {round_down(l.x), round_down(l.y), round_down(l.z)};
+    const float upper[3] = {round_up(u.x), round_up(u.y), round_up(u.z)};
+
+    // grow the boxes up to the root
+    while (node != INVALID_NODE)
+        {
+        AABBNodeWide& n = m_wide_nodes[node];
+        if (   n.lower_x[slot] <= lower[0] && n.lower_y[slot] <= lower[1] && n.lower_z[slot] <= lower[2]
+            && n.upper_x[slot] >= upper[0] && n.upper_y[slot] >= upper[1] && n.upper_z[slot] >= upper[2])
+            break;
+
+        n.lower_x[slot] = std::min(n.lower_x[slot], lower[0]);
+        n.lower_y[slot] = std::min(n.lower_y[slot], lower[1]);
+        n.lower_z[slot] = std::min(n.lower_z[slot], lower[2]);
+        n.upper_x[slot] = std::max(n.upper_x[slot], upper[0]);
+        n.upper_y[slot] = std::max(n.upper_y[slot], upper[1]);
+        n.upper_z[slot] = std::max(n.upper_z[slot], upper[2]);
+
+        slot = n.parent_slot;
+        node = n.parent;
+        }
+    }
+
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+
+    Refits the binary tree with AABBTree::refit() and copies the new boxes into the wide nodes.
+*/
+inline void AABBTreeWide::refit(const AABB *aabbs, unsigned int N)
+    {
+    AABBTree::refit(aabbs, N);
+
+    for (unsigned int node_idx = 0; node_idx < m_wide_nodes.size(); node_idx++)
+        {
+        AABBNodeWide& node = m_wide_nodes[node_idx];
+        for (unsigned int k = 0; k < node.num_children; k++)
+            setChildAABB(node, k, m_nodes[m_child_node[node_idx*WIDE_NODE_WIDTH + k]].aabb);
+        }
+    }
+
 // end group overlap
 /*! @}*/
 
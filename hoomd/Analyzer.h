@@ -92,6 +92,13 @@ class PYBIND11_EXPORT Analyzer
         */
         virtual void resetStats(){}
 
+        //! Complete any output in flight
+        /*! Analyzers that write files in the background must implement flush() to wait until all data passed to
+            analyze() is written. System calls flush() at the end of every run() so that files are complete when
+            control returns to the user.
+        */
+        virtual void flush(){}
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file AsyncWriter.cc
+    \brief Defines the AsyncWriter class
+*/
+
+#include "AsyncWriter.h"
+
+AsyncWriter::AsyncWriter()
+    : m_busy(false), m_shutdown(false)
+    {
+    }
+
+AsyncWriter::~AsyncWriter()
+    {
+    if (m_thread.joinable())
+        {
+            {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this]{ return !m_busy; });
+            m_shutdown = true;
+            }
+        m_cond.notify_all();
+        m_thread.join();
+        }
+    }
+
+/*! \param task Task to run
+
+    Errors from the previous task are rethrown before \a task is submitted.
+*/
+void AsyncWriter::submit(const std::function<void ()>& task)
+    {
+    wait();
+
+    if (!m_thread.joinable())
+        m_thread = std::thread(&AsyncWriter::run, this);
+
+        {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_task = task;
+        m_busy = true;
+        }
+    m_cond.notify_all();
+    }
+
+void AsyncWriter::wait()
+    {
+    std::exception_ptr error;
+
+        {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]{ return !m_busy; });
+        error = m_error;
+        m_error = nullptr;
+        }
+
+    if (error)
+        std::rethrow_exception(error);
+    }
+
+bool AsyncWriter::busy()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_busy;
+    }
+
+void AsyncWriter::run()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+        {
+        m_cond.wait(lock, [this]{ return m_busy || m_shutdown; });
+        if (m_shutdown && !m_busy)
+            return;
+
+        // run the task without holding the lock
+        std::function<void ()> task;
+        task.swap(m_task);
+        lock.unlock();
+        try
+            {
+            task();
+            }
+        catch (...)
+            {
+            lock.lock();
+            m_error = std::current_exception();
+            lock.unlock();
+            }
+        lock.lock();
+
+        m_busy = false;
+        m_cond.notify_all();
+        }
+    }
@@ -0,0 +1,67 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file AsyncWriter.h
+    \brief Declares the AsyncWriter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __ASYNC_WRITER_H__
+#define __ASYNC_WRITER_H__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+//! Runs file output tasks on a dedicated thread
+/*! Writers that support asynchronous output copy the data of a frame into a staging buffer and then pass a task that
+    writes the staged data to submit(). The task runs on the writer thread while the caller continues with the
+    simulation. At most one task is in flight: submit() first waits for the previous task to complete, so a writer
+    that double buffers its staging area only blocks when the previous frame has not finished writing.
+
+    An exception thrown by a task is rethrown in the calling thread by the next call to wait() or submit().
+
+    The thread is started on the first call to submit() and joined by the destructor, after the last task completes.
+*/
+class PYBIND11_EXPORT AsyncWriter
+    {
+    public:
+        //! Constructor
+        AsyncWriter();
+
+        //! Destructor
+        ~AsyncWriter();
+
+        //! Wait for the previous task, then run \a task on the writer thread
+        void submit(const std::function<void ()>& task);
+
+        //! Wait until the task in flight (if any) has completed
+        void wait();
+
+        //! Test if a task is in flight
+        bool busy();
+
+    private:
+        std::thread m_thread;                   //!< The writer thread
+        std::mutex m_mutex;                     //!< Protects the members below
+        std::condition_variable m_cond;         //!< Signals changes of m_task and m_busy
+        std::function<void ()> m_task;          //!< Task in flight
+        bool m_busy;                            //!< True while a task is in flight
+        bool m_shutdown;                        //!< True when the thread should exit
+        std::exception_ptr m_error;             //!< Exception thrown by the last task
+
+        //! Main loop of the writer thread
+        void run();
+    };
+
+#endif
@@ -15,6 +15,8 @@
 
 #include "hoomd/extern/pybind/include/pybind11/numpy.h"
 
+#include <algorithm>
+
 #ifdef ENABLE_CUDA
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -303,6 +305,160 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+/*! \param snapshot Snapshot of the groups that have at least one member in the local domain, on every rank
+    \param tags Global tag of every group in \a snapshot
+    \param nglobal Global number of groups
+
+    The particle data must already hold the local particles. Every rank passes all groups with a local member,
+    so the groups are not broadcast from the root rank. The type mapping must be the same on all ranks.
+    Group tags and member tags are checked like in addBondedGroup(), and the groups whose first member is local
+    must add up to \a nglobal over all ranks. Violations are errors on all ranks.
+
+    Without a domain decomposition, \a snapshot must hold all groups in tag order and this is equivalent to
+    initializeFromSnapshot().
+ */
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromLocalSnapshot(const Snapshot& snapshot,
+    const std::vector<unsigned int>& tags,
+    unsigned int nglobal)
+    {
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        if (! snapshot.validate() || tags.size() != snapshot.groups.size())
+            {
+            m_exec_conf->msg->error() << "init.*: invalid " << name << " data snapshot."
+                                    << std::endl << std::endl;
+            throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+            }
+
+        // check the group and member tags, and that every group is passed by the owner of its first member
+        unsigned int n_invalid = 0;
+        unsigned int n_owned = 0;
+            {
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+            unsigned int nglobal_particles = m_pdata->getNGlobal();
+            std::vector<bool> seen(nglobal, false);
+
+            for (unsigned int group_idx = 0; group_idx < tags.size(); ++group_idx)
+                {
+                bool valid = tags[group_idx] < nglobal && !seen[tags[group_idx]];
+                if (valid)
+                    seen[tags[group_idx]] = true;
+
+                const members_t& members = snapshot.groups[group_idx];
+                bool has_local_member = false;
+                for (unsigned int i = 0; i < group_size; ++i)
+                    {
+                    if (members.tag[i] >= nglobal_particles)
+                        {
+                        valid = false;
+                        continue;
+                        }
+
+                    for (unsigned int j = 0; j < i; ++j)
+                        if (members.tag[i] == members.tag[j])
+                            valid = false;
+
+                    if (h_rtag.data[members.tag[i]] != NOT_LOCAL)
+                        has_local_member = true;
+                    }
+
+                if (!valid || !has_local_member)
+                    n_invalid++;
+                else if (h_rtag.data[members.tag[0]] != NOT_LOCAL)
+                    n_owned++;
+                }
+            }
+
+        unsigned int counts[2] = {n_owned, n_invalid};
+        MPI_Allreduce(MPI_IN_PLACE, counts, 2, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+
+        if (counts[1] != 0)
+            {
+            m_exec_conf->msg->error() << "init.*: " << counts[1] << " " << name << "s have tags or member tags that "
+                                      << "are out of range or duplicated, or no local member." << std::endl;
+            throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+            }
+
+        if (counts[0] != nglobal)
+            {
+            m_exec_conf->msg->error() << "init.*: The ranks hold " << counts[0] << " " << name << "s, expected "
+                                      << nglobal << "." << std::endl;
+            throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+            }
+
+        // re-initialize data structures
+        initialize();
+
+        m_type_mapping = snapshot.type_mapping;
+
+        // update list of active tags
+        for (unsigned int tag = 0; tag < nglobal; ++tag)
+            m_tag_set.insert(tag);
+
+        m_n_groups = snapshot.groups.size();
+        m_group_rtag.resize(nglobal);
+        m_groups.resize(m_n_groups);
+        m_group_typeval.resize(m_n_groups);
+        m_group_tag.resize(m_n_groups);
+        m_group_ranks.resize(m_n_groups);
+
+            {
+            ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::overwrite);
+            ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+            ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::overwrite);
+            ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::overwrite);
+
+            for (unsigned int tag = 0; tag < nglobal; ++tag)
+                h_group_rtag.data[tag] = GROUP_NOT_LOCAL;
+
+            for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+                {
+                typeval_t t;
+                if (has_type_mapping)
+                    {
+                    t.type = snapshot.type_id[group_idx];
+                    if (t.type >= m_type_mapping.size())
+                        {
+                        m_exec_conf->msg->error() << name << ".*: Invalid " << name << " type " << t.type
+                            << "! The number of types is " << m_type_mapping.size() << std::endl;
+                        throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+                        }
+                    }
+                else
+                    {
+                    t.val = snapshot.val[group_idx];
+                    }
+
+                // the ranks of the members are filled out by the Communicator
+                ranks_t r;
+                for (unsigned int i = 0; i < group_size; ++i)
+                    r.idx[i] = 0;
+
+                h_group_rtag.data[tags[group_idx]] = group_idx;
+                h_groups.data[group_idx] = snapshot.groups[group_idx];
+                h_typeval.data[group_idx] = t;
+                h_group_tag.data[group_idx] = tags[group_idx];
+                h_group_ranks.data[group_idx] = r;
+                }
+            }
+
+        m_nglobal = nglobal;
+        m_invalid_cached_tags = true;
+
+        // notify observers
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        }
+    else
+    #endif
+        {
+        initializeFromSnapshot(snapshot);
+        }
+    }
+
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
@@ -1313,6 +1469,55 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot::repli
     size = n*old_size;
     }
 
+/*! Groups are replicated as in replicate(). A group of a replica is kept if any of its members is a local
+    particle, all other groups are dropped.
+ */
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot::replicate_local(
+    const std::vector<unsigned int>& replicas,
+    unsigned int old_n_particles,
+    const std::vector<unsigned int>& particle_tags,
+    std::vector<unsigned int>& tags)
+    {
+    unsigned int old_size = size;
+    std::vector<members_t> old_groups;
+    std::vector<unsigned int> old_type_id;
+    std::vector<Scalar> old_val;
+    old_groups.swap(groups);
+    old_type_id.swap(type_id);
+    old_val.swap(val);
+
+    tags.clear();
+    for (unsigned int j : replicas)
+        for (unsigned int i = 0; i < old_size; ++i)
+            {
+            members_t h;
+            bool is_local = false;
+            for (unsigned int k = 0; k < group_size; ++k)
+                {
+                h.tag[k] = old_groups[i].tag[k] + old_n_particles*j;
+                if (std::binary_search(particle_tags.begin(), particle_tags.end(), h.tag[k]))
+                    is_local = true;
+                }
+
+            if (!is_local)
+                continue;
+
+            groups.push_back(h);
+            if (has_type_mapping)
+                {
+                type_id.push_back(old_type_id[i]);
+                }
+            else
+                {
+                val.push_back(old_val[i]);
+                }
+            tags.push_back(old_size*j + i);
+            }
+
+    size = groups.size();
+    }
+
 /*! \returns a numpy array that wraps the type_id data element.
     The raw data is referenced by the numpy array, modifications to the numpy array will modify the snapshot
 */
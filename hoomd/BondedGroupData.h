@@ -199,6 +199,17 @@ class BondedGroupData
              */
             void replicate(unsigned int n, unsigned int old_n_particles);
 
+            //! Replicate this snapshot and keep only the groups with local members
+            /*! \param replicas Indices of the replicas that hold local particles, in ascending order
+             *  \param old_n_particles Number of particles in system to be replicated
+             *  \param particle_tags Tags of the local particles, in ascending order
+             *  \param tags Output: global tags of the local groups, in ascending order
+             */
+            void replicate_local(const std::vector<unsigned int>& replicas,
+                                 unsigned int old_n_particles,
+                                 const std::vector<unsigned int>& particle_tags,
+                                 std::vector<unsigned int>& tags);
+
             #ifdef ENABLE_MPI
             //! Broadcast the snapshot
             /*! \param root the processor to send from
@@ -246,6 +257,11 @@ class BondedGroupData
         //! Initialize from a snapshot
         virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+        //! Initialize from a snapshot that holds only the groups with members in the local domain
+        void initializeFromLocalSnapshot(const Snapshot& snapshot,
+                                         const std::vector<unsigned int>& tags,
+                                         unsigned int nglobal);
+
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
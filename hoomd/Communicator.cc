@@ -1089,6 +1089,8 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_has_ghost_particles(false),
             m_last_flags(0),
             m_comm_pending(false),
+            m_ghost_update_overlap(false),
+            m_persistent_ghost_update(false),
             m_bond_comm(*this, m_sysdef->getBondData()),
             m_angle_comm(*this, m_sysdef->getAngleData()),
             m_dihedral_comm(*this, m_sysdef->getDihedralData()),
@@ -1113,6 +1115,9 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
         m_copy_ghosts[dir].swap(copy_ghosts);
         m_num_copy_ghosts[dir] = 0;
         m_num_recv_ghosts[dir] = 0;
+        m_num_copy_local_ghosts[dir] = 0;
+        m_num_recv_local_ghosts[dir] = 0;
+        m_ghost_update_offset[dir] = 0;
         }
 
     // All buffers corresponding to sending ghosts in reverse
@@ -1202,6 +1207,9 @@ Communicator::~Communicator()
     m_sysdef->getImproperData()->getGroupNumChangeSignal().disconnect<Communicator, &Communicator::setImpropersChanged>(this);
     m_sysdef->getConstraintData()->getGroupNumChangeSignal().disconnect<Communicator, &Communicator::setConstraintsChanged>(this);
     m_sysdef->getPairData()->getGroupNumChangeSignal().disconnect<Communicator, &Communicator::setPairsChanged>(this);
+
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        freeGhostUpdateRequests(dir);
     }
 
 void Communicator::initializeNeighborArrays()
@@ -1297,8 +1305,11 @@ void Communicator::initializeNeighborArrays()
     }
 
 //! Interface to the communication methods.
-void Communicator::communicate(unsigned int timestep)
+void Communicator::communicate(unsigned int timestep, bool defer_ghost_update)
     {
+    // complete a ghost update that is still pending from a previous call
+    finishUpdateGhosts(timestep);
+
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
@@ -1342,7 +1353,9 @@ void Communicator::communicate(unsigned int timestep)
         {
         beginUpdateGhosts(timestep);
 
-        finishUpdateGhosts(timestep);
+        // if requested, the caller overlaps computation with the split update and completes it later
+        if (!defer_ghost_update || !m_ghost_update_overlap)
+            finishUpdateGhosts(timestep);
         }
 
     // Check if migration of particles is requested
@@ -1679,6 +1692,7 @@ void Communicator::exchangeGhosts()
         if (! isCommunicating(dir) ) continue;
 
         m_num_copy_ghosts[dir] = 0;
+        m_num_copy_local_ghosts[dir] = 0;
 
         // resize array of ghost particle tags
         unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
@@ -1749,6 +1763,10 @@ void Communicator::exchangeGhosts()
 
                     h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
                     m_num_copy_ghosts[dir]++;
+
+                    // local particles precede the forwarded ghosts in the list
+                    if (idx < m_pdata->getN())
+                        m_num_copy_local_ghosts[dir]++;
                     }
                 }
             }
@@ -1785,7 +1803,28 @@ void Communicator::exchangeGhosts()
             &req);
         m_reqs.push_back(req);
 
-        m_stats.resize(2);
+        // the number of local particles among the ghosts is only needed for the split ghost update
+        if (m_ghost_update_overlap)
+            {
+            MPI_Isend(&m_num_copy_local_ghosts[dir],
+                sizeof(unsigned int),
+                MPI_BYTE,
+                send_neighbor,
+                0,
+                m_mpi_comm,
+                &req);
+            m_reqs.push_back(req);
+            MPI_Irecv(&m_num_recv_local_ghosts[dir],
+                sizeof(unsigned int),
+                MPI_BYTE,
+                recv_neighbor,
+                0,
+                m_mpi_comm,
+                &req);
+            m_reqs.push_back(req);
+            }
+
+        m_stats.resize(m_reqs.size());
         MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
         if (m_prof)
@@ -2302,6 +2341,46 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
     if (m_prof)
         m_prof->push("comm_ghost_update");
 
+    if (m_ghost_update_overlap)
+        {
+        m_exec_conf->msg->notice(7) << "Communicator: begin split ghost update" << std::endl;
+
+        // every direction packs into its own section of the send buffers, so that all directions
+        // can be in flight at the same time
+        CommFlags flags = getFlags();
+        unsigned int num_tot_copy_ghosts = 0;
+        for (unsigned int dir = 0; dir < 6; dir ++)
+            {
+            m_ghost_update_offset[dir] = num_tot_copy_ghosts;
+            if (isCommunicating(dir))
+                num_tot_copy_ghosts += m_num_copy_ghosts[dir];
+            }
+
+        if (flags[comm_flag::position])
+            m_pos_copybuf.resize(num_tot_copy_ghosts);
+        if (flags[comm_flag::velocity])
+            m_velocity_copybuf.resize(num_tot_copy_ghosts);
+        if (flags[comm_flag::orientation])
+            m_orientation_copybuf.resize(num_tot_copy_ghosts);
+
+        // first stage: ghosts that are local particles on the sending rank do not depend on other directions
+        m_reqs.clear();
+        unsigned int recv_idx = m_pdata->getN();
+        for (unsigned int dir = 0; dir < 6; dir ++)
+            {
+            if (! isCommunicating(dir) ) continue;
+
+            postGhostUpdate(dir, 0, m_num_copy_local_ghosts[dir], recv_idx, m_num_recv_local_ghosts[dir]);
+            recv_idx += m_num_recv_ghosts[dir];
+            }
+
+        m_comm_pending = true;
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
     // update data in these arrays
@@ -2392,9 +2471,18 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         num_tot_recv_ghosts += m_num_recv_ghosts[dir];
 
         size_t sz = 0;
+        if (m_persistent_ghost_update)
+            {
+            exchangeGhostUpdatePersistent(dir, send_neighbor, recv_neighbor, start_idx);
+
+            if (flags[comm_flag::position]) sz += sizeof(Scalar4);
+            if (flags[comm_flag::velocity]) sz += sizeof(Scalar4);
+            if (flags[comm_flag::orientation]) sz += sizeof(Scalar4);
+            }
+
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
+        if (! m_persistent_ghost_update && flags[comm_flag::position])
             {
             m_reqs.resize(2);
             m_stats.resize(2);
@@ -2410,7 +2498,7 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
             sz += sizeof(Scalar4);
             }
 
-        if (flags[comm_flag::velocity])
+        if (! m_persistent_ghost_update && flags[comm_flag::velocity])
             {
             m_reqs.resize(2);
             m_stats.resize(2);
@@ -2426,7 +2514,7 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
             sz += sizeof(Scalar4);
             }
 
-        if (flags[comm_flag::orientation])
+        if (! m_persistent_ghost_update && flags[comm_flag::orientation])
             {
             m_reqs.resize(2);
             m_stats.resize(2);
@@ -2468,6 +2556,251 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
             m_prof->pop();
     }
 
+/*! \param timestep The time step
+
+    Completes a split ghost update started by beginUpdateGhosts(). The forwarded ghosts are sent
+    direction by direction, after the ghosts they were received as have been updated.
+ */
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (! m_comm_pending)
+        return;
+
+    m_comm_pending = false;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    m_exec_conf->msg->notice(7) << "Communicator: finish split ghost update" << std::endl;
+
+    // complete the first stage
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    m_stats.resize(m_reqs.size());
+    if (m_reqs.size())
+        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+    if (m_prof)
+        m_prof->pop();
+
+    unsigned int recv_idx = m_pdata->getN();
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        wrapGhostPositions(recv_idx, recv_idx + m_num_recv_local_ghosts[dir]);
+        recv_idx += m_num_recv_ghosts[dir];
+        }
+
+    // second stage: forwarded ghosts, in the order of the ghost exchange
+    recv_idx = m_pdata->getN();
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        unsigned int n_send = m_num_copy_ghosts[dir] - m_num_copy_local_ghosts[dir];
+        unsigned int n_recv = m_num_recv_ghosts[dir] - m_num_recv_local_ghosts[dir];
+        unsigned int start_idx = recv_idx + m_num_recv_local_ghosts[dir];
+        recv_idx += m_num_recv_ghosts[dir];
+
+        if (! n_send && ! n_recv) continue;
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        m_reqs.clear();
+        postGhostUpdate(dir, m_num_copy_local_ghosts[dir], n_send, start_idx, n_recv);
+
+        m_stats.resize(m_reqs.size());
+        if (m_reqs.size())
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+        if (m_prof)
+            m_prof->pop();
+
+        wrapGhostPositions(start_idx, start_idx + n_recv);
+        }
+
+    m_reqs.clear();
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param dir Direction to send to
+    \param first Index of the first entry of the ghost list to send
+    \param n_send Number of entries of the ghost list to send
+    \param recv_idx Particle index to store the first received ghost at
+    \param n_recv Number of ghosts to receive
+
+    The requests are appended to m_reqs. Messages of zero size are not posted, since the sizes
+    agree with the neighbors' after exchangeGhosts().
+ */
+void Communicator::postGhostUpdate(unsigned int dir,
+                                   unsigned int first,
+                                   unsigned int n_send,
+                                   unsigned int recv_idx,
+                                   unsigned int n_recv)
+    {
+    CommFlags flags = getFlags();
+
+    unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+    // we receive from the direction opposite to the one we send to
+    unsigned int recv_neighbor;
+    if (dir % 2 == 0)
+        recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+    else
+        recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    const unsigned int field_flags[3] = {comm_flag::position, comm_flag::velocity, comm_flag::orientation};
+    const GlobalArray<Scalar4> *field_arrays[3] = {&m_pdata->getPositions(),
+                                                   &m_pdata->getVelocities(),
+                                                   &m_pdata->getOrientationArray()};
+    GlobalVector<Scalar4> *field_copybufs[3] = {&m_pos_copybuf, &m_velocity_copybuf, &m_orientation_copybuf};
+
+    ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (unsigned int field = 0; field < 3; ++field)
+        {
+        if (! flags[field_flags[field]]) continue;
+
+        ArrayHandle<Scalar4> h_data(*field_arrays[field], access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_copybuf(*field_copybufs[field], access_location::host, access_mode::readwrite);
+
+        Scalar4 *sendbuf = h_copybuf.data + m_ghost_update_offset[dir] + first;
+        for (unsigned int ghost_idx = 0; ghost_idx < n_send; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[first + ghost_idx]];
+
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+            sendbuf[ghost_idx] = h_data.data[idx];
+            }
+
+        // the tags are unique per direction and field, as all directions may be in flight at once
+        int tag = 4 + 3*dir + field;
+        MPI_Request req;
+        if (n_send)
+            {
+            MPI_Isend(sendbuf, n_send*sizeof(Scalar4), MPI_BYTE, send_neighbor, tag, m_mpi_comm, &req);
+            m_reqs.push_back(req);
+            }
+        if (n_recv)
+            {
+            MPI_Irecv(h_data.data + recv_idx, n_recv*sizeof(Scalar4), MPI_BYTE, recv_neighbor, tag, m_mpi_comm, &req);
+            m_reqs.push_back(req);
+            }
+        }
+    }
+
+/*! \param dir Direction to send to
+    \param send_neighbor Rank to send to
+    \param recv_neighbor Rank to receive from
+    \param start_idx Particle index to store the first received ghost at
+
+    The send buffers must have been packed. Between migrations, the ghost lists and therefore the message sizes and
+    buffers do not change, so the requests are only recreated when they differ from the ones they were set up with,
+    e.g. after a ghost exchange or a particle sort.
+ */
+void Communicator::exchangeGhostUpdatePersistent(unsigned int dir,
+                                                 unsigned int send_neighbor,
+                                                 unsigned int recv_neighbor,
+                                                 unsigned int start_idx)
+    {
+    CommFlags flags = getFlags();
+
+    // the handles are held until the exchange has completed
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    const unsigned int field_flags[3] = {comm_flag::position, comm_flag::velocity, comm_flag::orientation};
+    Scalar4 *recv_bufs[3] = {h_pos.data, h_vel.data, h_orientation.data};
+    Scalar4 *send_bufs[3] = {h_pos_copybuf.data, h_velocity_copybuf.data, h_orientation_copybuf.data};
+
+    std::vector< std::pair<const void *, unsigned int> > bufs;
+    for (unsigned int field = 0; field < 3; ++field)
+        {
+        if (! flags[field_flags[field]]) continue;
+
+        bufs.push_back(std::make_pair((const void *) send_bufs[field], m_num_copy_ghosts[dir]));
+        bufs.push_back(std::make_pair((const void *) (recv_bufs[field] + start_idx), m_num_recv_ghosts[dir]));
+        }
+
+    std::vector<MPI_Request>& reqs = m_ghost_update_reqs[dir];
+    if (bufs != m_ghost_update_req_bufs[dir])
+        {
+        freeGhostUpdateRequests(dir);
+
+        for (unsigned int field = 0; field < 3; ++field)
+            {
+            if (! flags[field_flags[field]]) continue;
+
+            MPI_Request req;
+            MPI_Send_init(send_bufs[field], m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, field+1,
+                m_mpi_comm, &req);
+            reqs.push_back(req);
+            MPI_Recv_init(recv_bufs[field] + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE,
+                recv_neighbor, field+1, m_mpi_comm, &req);
+            reqs.push_back(req);
+            }
+
+        m_ghost_update_req_bufs[dir] = bufs;
+        }
+
+    if (reqs.size())
+        {
+        m_stats.resize(reqs.size());
+        MPI_Startall(reqs.size(), &reqs.front());
+        MPI_Waitall(reqs.size(), &reqs.front(), &m_stats.front());
+        }
+    }
+
+/*! \param dir Direction of the requests
+ */
+void Communicator::freeGhostUpdateRequests(unsigned int dir)
+    {
+    // requests cannot be freed after MPI has been finalized
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+
+    if (! finalized)
+        {
+        for (unsigned int i = 0; i < m_ghost_update_reqs[dir].size(); ++i)
+            MPI_Request_free(&m_ghost_update_reqs[dir][i]);
+        }
+
+    m_ghost_update_reqs[dir].clear();
+    m_ghost_update_req_bufs[dir].clear();
+    }
+
+/*! \param first Index of the first ghost to wrap
+    \param last One past the index of the last ghost to wrap
+ */
+void Communicator::wrapGhostPositions(unsigned int first, unsigned int last)
+    {
+    if (! getFlags()[comm_flag::position])
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+
+    const BoxDim shifted_box = getShiftedBox();
+    for (unsigned int idx = first; idx < last; idx++)
+        {
+        // wrap particles received across a global boundary
+        int3 img = make_int3(0,0,0);
+        shifted_box.wrap(h_pos.data[idx], img);
+        }
+    }
+
 void Communicator::updateNetForce(unsigned int timestep)
     {
     CommFlags flags = getFlags();
@@ -2891,6 +3224,8 @@ const BoxDim Communicator::getShiftedBox() const
 void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator> >(m,"Communicator")
-    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >());
+    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    .def("setGhostUpdateOverlap", &Communicator::setGhostUpdateOverlap)
+    .def("setPersistentGhostUpdate", &Communicator::setPersistentGhostUpdate);
     }
 #endif // ENABLE_MPI
@@ -279,10 +279,43 @@ class PYBIND11_EXPORT Communicator
          * This method is supposed to be called every time step and automatically performs all necessary
          * communication steps.
          */
-        void communicate(unsigned int timestep);
+        void communicate(unsigned int timestep, bool defer_ghost_update=false);
 
         //@}
 
+        //! Enable or disable overlapping the CPU ghost update with the force computation
+        /*! \param overlap If true, the ghost update is split into a stage for ghosts that are local particles on the
+         *         sending rank, which is posted for all directions at once, and a stage for forwarded ghosts.
+         *         communicate() then leaves the update pending when called with \a defer_ghost_update.
+         *
+         * The number of local particles among the ghosts is only exchanged while the overlap is enabled, so enabling
+         * it forces a full ghost exchange on the next call to communicate().
+         */
+        void setGhostUpdateOverlap(bool overlap)
+            {
+            if (overlap && !m_ghost_update_overlap)
+                forceMigrate();
+            m_ghost_update_overlap = overlap;
+            }
+
+        //! Enable or disable persistent MPI requests for the ghost update
+        /*! \param persistent If true, the messages of every direction are set up once with MPI_Send_init() and
+         *         MPI_Recv_init() and restarted on every ghost update, until the ghost lists or the particle data
+         *         arrays change.
+         *
+         * Persistent requests are ignored while the ghost update overlap is enabled (see setGhostUpdateOverlap()).
+         */
+        void setPersistentGhostUpdate(bool persistent)
+            {
+            m_persistent_ghost_update = persistent;
+            }
+
+        //! Returns true if a ghost update has been started and not yet finished
+        bool isGhostUpdatePending() const
+            {
+            return m_comm_pending;
+            }
+
         //! Force particle migration
         void forceMigrate()
             {
@@ -310,11 +343,7 @@ class PYBIND11_EXPORT Communicator
          *
          * \param timestep The time step
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
 
         /*! Communicate the net particle force
          * \parm timestep The time step
@@ -493,6 +522,9 @@ class PYBIND11_EXPORT Communicator
         GlobalVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
         unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
         unsigned int m_num_recv_ghosts[6];       //!< Number of ghosts received per direction
+        unsigned int m_num_copy_local_ghosts[6]; //!< Number of sent ghosts per direction that are local particles
+        unsigned int m_num_recv_local_ghosts[6]; //!< Number of received ghosts per direction that are local on the sender
+        unsigned int m_ghost_update_offset[6];   //!< Per-direction offset into the send buffers of a split ghost update
 
         GlobalVector<unsigned int> m_plan;          //!< Array of per-direction flags that determine the sending route
 
@@ -547,6 +579,11 @@ class PYBIND11_EXPORT Communicator
         CommFlags m_last_flags;                       //!< Flags of last ghost exchange
 
         bool m_comm_pending;                     //!< If true, a communication is in process
+        bool m_ghost_update_overlap;             //!< True if the CPU ghost update is split into two stages
+        bool m_persistent_ghost_update;          //!< True if the ghost update uses persistent requests
+        std::vector<MPI_Request> m_ghost_update_reqs[6]; //!< Persistent ghost update requests per direction
+        std::vector< std::pair<const void *, unsigned int> >
+            m_ghost_update_req_bufs[6];          //!< Buffers and sizes the persistent requests were created for
         std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
         std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
@@ -654,6 +691,25 @@ class PYBIND11_EXPORT Communicator
         //! Helper function to initialize adjacency arrays
         void initializeNeighborArrays();
 
+        //! Pack and post the messages for a contiguous part of the ghost list of one direction
+        void postGhostUpdate(unsigned int dir,
+                             unsigned int first,
+                             unsigned int n_send,
+                             unsigned int recv_idx,
+                             unsigned int n_recv);
+
+        //! Wrap the positions of ghosts received across a global boundary
+        void wrapGhostPositions(unsigned int first, unsigned int last);
+
+        //! Exchange the ghost update of one direction with persistent requests
+        void exchangeGhostUpdatePersistent(unsigned int dir,
+                                           unsigned int send_neighbor,
+                                           unsigned int recv_neighbor,
+                                           unsigned int start_idx);
+
+        //! Free the persistent ghost update requests of one direction
+        void freeGhostUpdateRequests(unsigned int dir);
+
         //! Method that is called when ghost particles are requested to be removed
         void slotGhostParticlesRemoved()
             {
@@ -33,7 +33,7 @@ using namespace std;
 /*! \param file file to write to
     \param val integer to write
 */
-static void write_int(fstream &file, unsigned int val)
+static void write_int(ostream &file, unsigned int val)
     {
     file.write((char *)&val, sizeof(unsigned int));
     }
@@ -70,7 +70,7 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_start_timestep(0), m_period(period), m_group(group),
       m_num_frames_written(0), m_last_written_step(0), m_appending(false),
       m_unwrap_full(false), m_unwrap_rigid(false), m_angle(false),
-      m_overwrite(overwrite), m_is_initialized(false)
+      m_overwrite(overwrite), m_is_initialized(false), m_async(false), m_frame_buf_idx(0), m_async_error(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DCDDumpWriter: " << fname << " " << period << " " << overwrite << endl;
     }
@@ -132,11 +132,39 @@ DCDDumpWriter::~DCDDumpWriter()
 
     if (m_is_initialized)
         {
+        // finish writing the last frame
+        m_async_writer.wait();
+        if (m_async_error)
+            m_exec_conf->msg->error() << "dump.dcd: I/O error while writing DCD frame data" << endl;
+
         m_file.close();
         delete[] m_staging_buffer;
         }
     }
 
+/*! \param enable True if frames should be written on a background thread
+
+    Any frame that is still being written in the background is completed before switching modes.
+*/
+void DCDDumpWriter::setAsynchronous(bool enable)
+    {
+    waitAsync();
+    m_async = enable;
+    }
+
+//! Wait for the writer thread to complete the previous frame and report any error
+void DCDDumpWriter::waitAsync()
+    {
+    m_async_writer.wait();
+
+    if (m_async_error)
+        {
+        m_async_error = false;
+        m_exec_conf->msg->error() << "dump.dcd: I/O error while writing DCD frame data" << endl;
+        throw runtime_error("Error writing DCD file");
+        }
+    }
+
 /*! \param timestep Current time step of the simulation
     The very first call to analyze() will result in the creation (or overwriting) of the
     file fname and the writing of the current timestep snapshot. After that, each call to analyze
@@ -184,14 +212,35 @@ void DCDDumpWriter::analyze(unsigned int timestep)
     if ( (timestep - m_start_timestep) % m_period != 0)
         m_exec_conf->msg->warning() << "dump.dcd: writing time step " << timestep << " which is not specified in the period of the DCD file: " << m_start_timestep << " + i * " << m_period << endl;
 
-    // write the data for the current time step
-    m_file.seekp(0, std::ios_base::end);
-    write_frame_header(m_file);
-    write_frame_data(m_file, snapshot);
+    if (m_async)
+        {
+        // stage the frame and write it on the writer thread while the previous frame may still be in flight
+        unsigned int buf = m_frame_buf_idx;
+        m_frame_buf_idx ^= 1;
+
+        m_frame_buf[buf].str(std::string());
+        m_frame_buf[buf].clear();
+        write_frame_header(m_frame_buf[buf]);
+        write_frame_data(m_frame_buf[buf], snapshot);
 
-    // update the header with the number of frames written
-    m_num_frames_written++;
-    write_updated_header(m_file, timestep);
+        // report an error in the previous frame before handing over the next one
+        waitAsync();
+
+        m_num_frames_written++;
+        unsigned int num_frames = m_num_frames_written;
+        m_async_writer.submit([this, buf, num_frames, timestep]{ write_staged_frame(buf, num_frames, timestep); });
+        }
+    else
+        {
+        // write the data for the current time step
+        m_file.seekp(0, std::ios_base::end);
+        write_frame_header(m_file);
+        write_frame_data(m_file, snapshot);
+
+        // update the header with the number of frames written
+        m_num_frames_written++;
+        write_updated_header(m_file, m_num_frames_written, timestep);
+        }
 
     if (m_prof)
         m_prof->pop();
@@ -201,7 +250,7 @@ void DCDDumpWriter::analyze(unsigned int timestep)
     Writes the initial DCD header to the beginning of the file. This must be
     called on a newly created (or truncated file).
 */
-void DCDDumpWriter::write_file_header(std::fstream &file)
+void DCDDumpWriter::write_file_header(std::ostream &file)
     {
      m_exec_conf->msg->notice(4) << "dump.dcd: Creating dcd file "
                                  << " | start timestep: " << m_start_timestep
@@ -269,7 +318,7 @@ void DCDDumpWriter::write_file_header(std::fstream &file)
     Writes the header that precedes each snapshot in the file. This header
     includes information on the box size of the simulation.
 */
-void DCDDumpWriter::write_frame_header(std::fstream &file)
+void DCDDumpWriter::write_frame_header(std::ostream &file)
     {
     double unitcell[6];
     BoxDim box = m_pdata->getGlobalBox();
@@ -309,7 +358,7 @@ void DCDDumpWriter::write_frame_header(std::fstream &file)
     \param snapshot Snapshot to write
     Writes the actual particle positions for all particles at the current time step
 */
-void DCDDumpWriter::write_frame_data(std::fstream &file, const SnapshotParticleData<Scalar>& snapshot)
+void DCDDumpWriter::write_frame_data(std::ostream &file, const SnapshotParticleData<Scalar>& snapshot)
     {
     // we need to unsort the positions and write in tag order
     assert(m_staging_buffer);
@@ -395,20 +444,39 @@ void DCDDumpWriter::write_frame_data(std::fstream &file, const SnapshotParticleD
     }
 
 /*! \param file File to write to
+    \param num_frames Number of frames in the file
     \param timestep Current time step of the simulation
 
     Updates the pointers in the main file header to reflect the current number of frames
     written and the last time step written.
 */
-void DCDDumpWriter::write_updated_header(std::fstream &file, unsigned int timestep)
+void DCDDumpWriter::write_updated_header(std::fstream &file, unsigned int num_frames, unsigned int timestep)
     {
     file.seekp(NFILE_POS);
-    write_int(file, m_num_frames_written);
+    write_int(file, num_frames);
 
     file.seekp(NSTEP_POS);
     write_int(file, timestep);
     }
 
+/*! \param buf Staging buffer to write
+    \param num_frames Number of frames in the file after this one is written
+    \param timestep Time step of the staged frame
+
+    Runs on the writer thread. Appends the staged frame to the file and updates the header. Errors are reported by
+    waitAsync(), at the latest in the next call to analyze().
+*/
+void DCDDumpWriter::write_staged_frame(unsigned int buf, unsigned int num_frames, unsigned int timestep)
+    {
+    std::string data = m_frame_buf[buf].str();
+    m_file.seekp(0, std::ios_base::end);
+    m_file.write(data.data(), data.size());
+    write_updated_header(m_file, num_frames, timestep);
+
+    if (!m_file.good())
+        m_async_error = true;
+    }
+
 void export_DCDDumpWriter(py::module& m)
     {
     py::class_<DCDDumpWriter, std::shared_ptr<DCDDumpWriter> >(m,"DCDDumpWriter",py::base<Analyzer>())
@@ -416,5 +484,7 @@ void export_DCDDumpWriter(py::module& m)
     .def("setUnwrapFull", &DCDDumpWriter::setUnwrapFull)
     .def("setUnwrapRigid", &DCDDumpWriter::setUnwrapRigid)
     .def("setAngleZ", &DCDDumpWriter::setAngleZ)
+    .def("setAsynchronous", &DCDDumpWriter::setAsynchronous)
+    .def("flush", &DCDDumpWriter::flush)
     ;
     }
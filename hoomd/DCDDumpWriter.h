@@ -8,11 +8,14 @@
 #define __DCDDUMPWRITER_H__
 
 #include "Analyzer.h"
+#include "AsyncWriter.h"
 #include "ParticleGroup.h"
 
 #include <string>
 #include <memory>
 #include <fstream>
+#include <sstream>
+#include <atomic>
 
 /*! \file DCDDumpWriter.h
     \brief Declares the DCDDumpWriter class
@@ -64,6 +67,12 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
+        //! Wait until the frame being written in the background is in the file
+        virtual void flush()
+            {
+            waitAsync();
+            }
+
         //! Set whether coordinates should be written out wrapped or unwrapped.
         void setUnwrapFull(bool enable)
             {
@@ -82,6 +91,9 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
             m_angle = enable;
             }
 
+        //! Control asynchronous writes
+        void setAsynchronous(bool enable);
+
     private:
         std::string m_fname;                //!< The file name we are writing to
         unsigned int m_start_timestep;      //!< First time step written to the file
@@ -101,16 +113,26 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
         float *m_staging_buffer;            //!< Buffer for staging particle positions in tag order
         std::fstream m_file;                //!< The file object
 
+        bool m_async;                       //!< True if frames are written by the writer thread
+        AsyncWriter m_async_writer;         //!< Writes staged frames in the background
+        std::ostringstream m_frame_buf[2];  //!< Double buffered staged frames
+        unsigned int m_frame_buf_idx;       //!< Buffer the next frame is staged in
+        std::atomic<bool> m_async_error;    //!< True if the writer thread failed to write a frame
+
         // helper functions
 
         //! Initializes the file header
-        void write_file_header(std::fstream &file);
+        void write_file_header(std::ostream &file);
         //! Writes the frame header
-        void write_frame_header(std::fstream &file);
+        void write_frame_header(std::ostream &file);
         //! Writes the particle positions for a frame
-        void write_frame_data(std::fstream &file, const SnapshotParticleData<Scalar>& snapshot);
+        void write_frame_data(std::ostream &file, const SnapshotParticleData<Scalar>& snapshot);
         //! Updates the file header
-        void write_updated_header(std::fstream &file, unsigned int timestep);
+        void write_updated_header(std::fstream &file, unsigned int num_frames, unsigned int timestep);
+        //! Write a staged frame to the file (called on the writer thread)
+        void write_staged_frame(unsigned int buf, unsigned int num_frames, unsigned int timestep);
+        //! Wait for the writer thread and raise an exception if it failed
+        void waitAsync();
         //! Initializes the output file for writing
         void initFileIO(unsigned int timestep);
 
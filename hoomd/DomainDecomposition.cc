@@ -612,6 +612,47 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box, Scalar
     return rank;
     }
 
+/*!
+ * \param global_box The global simulation box
+ * \param pos Particle position, wrapped on output
+ * \param img Particle image, updated on output
+ * \param cart_ranks Map of cartesian rank indices to ranks
+ * \returns the rank of the processor that should receive the particle
+ *
+ * Particles that are exactly on the upper boundary of the global box along a direction are wrapped to the lower
+ * boundary before they are placed, as in the initialization from a snapshot.
+ */
+unsigned int DomainDecomposition::wrapAndPlaceParticle(const BoxDim& global_box,
+                                                       Scalar3& pos,
+                                                       int3& img,
+                                                       const unsigned int *cart_ranks)
+    {
+    Scalar3 f = global_box.makeFraction(pos);
+    int i = f.x * ((Scalar)m_index.getW());
+    int j = f.y * ((Scalar)m_index.getH());
+    int k = f.z * ((Scalar)m_index.getD());
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) m_index.getW())
+        flags.x = 1;
+    if (j == (int) m_index.getH())
+        flags.y = 1;
+    if (k == (int) m_index.getD())
+        flags.z = 1;
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim wrap_box = global_box;
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    wrap_box.setPeriodic(periodic);
+    wrap_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    return placeParticle(global_box, pos, cart_ranks);
+    }
+
 void DomainDecomposition::findCommonNodes()
     {
     // get MPI node name
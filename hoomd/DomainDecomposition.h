@@ -158,6 +158,9 @@ class PYBIND11_EXPORT DomainDecomposition
         //! Get the rank for a particle to be placed
         unsigned int placeParticle(const BoxDim& global_box, Scalar3 pos, const unsigned int *cart_ranks);
 
+        //! Wrap a particle on the upper boundary of the global box and get the rank it should be placed on
+        unsigned int wrapAndPlaceParticle(const BoxDim& global_box, Scalar3& pos, int3& img, const unsigned int *cart_ranks);
+
         //! Get the number of grid cells in each dimension.
         uint3 getGridSize(void)const{return make_uint3(m_nx,m_ny,m_nz);}
     private:
@@ -142,6 +142,14 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             flags[comm_flag::net_force] = 1; // only used if constraints are present
             return flags;
             }
+
+        //! Returns true if compute() may be called while a ghost update is pending
+        /*! Such force computes call Communicator::finishUpdateGhosts() before they access ghost particle data.
+         */
+        virtual bool canOverlapGhostUpdate()
+            {
+            return false;
+            }
         #endif
 
         //! Returns true if this ForceCompute requires anisotropic integration
@@ -0,0 +1,288 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file GSDChunkEncoding.cc
+    \brief Defines functions that encode and decode compressed GSD chunks
+*/
+
+#include "GSDChunkEncoding.h"
+#include "hoomd/extern/gsd.h"
+
+#include <string.h>
+#include <cmath>
+#include <limits>
+
+namespace hoomd
+{
+namespace detail
+{
+
+/*! \param name Name of the plain chunk
+    \returns The name of the chunk that stores the encoded form of \a name
+*/
+std::string encodedChunkName(const std::string& name)
+    {
+    return std::string(GSD_ENCODED_CHUNK_PREFIX) + name;
+    }
+
+/*! \param M Number of columns
+    \returns The offset in bytes of the packed values from the start of a quantized chunk, which holds the header
+             and the lowest value and range width of every column before the packed values
+*/
+size_t quantizedDataOffset(uint32_t M)
+    {
+    return sizeof(EncodedChunkHeader) + 2*M*sizeof(float);
+    }
+
+/*! \param N Number of rows
+    \param M Number of columns
+    \param bits Number of bits per value
+    \returns The size of a quantized chunk in bytes
+*/
+static size_t quantizedSize(uint64_t N, uint32_t M, unsigned int bits)
+    {
+    return quantizedDataOffset(M) + (N*M*bits + 7)/8;
+    }
+
+/*! \param out Buffer to write the encoded chunk to (resized to fit)
+    \param data N x M float values to encode
+    \param N Number of rows
+    \param M Number of columns
+    \param bits Number of bits per value (1 to GSD_QUANTIZE_MAX_BITS)
+
+    Every column is quantized separately: the encoded chunk stores the lowest value of the column and the width of
+    its range, and each value as an unsigned integer with \a bits bits that counts steps of width / (2^bits - 1)
+    from the lowest value. The largest error introduced is half of one step. The integers are packed in row major
+    order, starting at the lowest bit of each byte. Non-finite values are not representable and are stored as the
+    closest end of the range.
+*/
+void encodeQuantized(std::vector<char>& out, const float *data, uint64_t N, uint32_t M, unsigned int bits)
+    {
+    EncodedChunkHeader header;
+    header.codec = GSD_CODEC_QUANTIZE;
+    header.bits = bits;
+    header.type = GSD_TYPE_FLOAT;
+    header.reserved = 0;
+    header.M = M;
+    header.N = N;
+
+    // find the range of every column
+    std::vector<float> lo(M, std::numeric_limits<float>::max());
+    std::vector<float> width(M, 0.0f);
+    std::vector<float> hi(M, -std::numeric_limits<float>::max());
+    for (uint64_t i = 0; i < N; i++)
+        for (uint32_t j = 0; j < M; j++)
+            {
+            float v = data[i*M + j];
+            if (!std::isfinite(v))
+                continue;
+            if (v < lo[j])
+                lo[j] = v;
+            if (v > hi[j])
+                hi[j] = v;
+            }
+
+    for (uint32_t j = 0; j < M; j++)
+        {
+        if (lo[j] > hi[j])
+            {
+            // no finite values in this column
+            lo[j] = 0.0f;
+            hi[j] = 0.0f;
+            }
+        width[j] = hi[j] - lo[j];
+
+        // rounding may leave the stored range short of the largest value, extend it until it covers the column
+        while (lo[j] + width[j] < hi[j])
+            width[j] = std::nextafter(width[j], std::numeric_limits<float>::max());
+        }
+
+    out.resize(quantizedSize(N, M, bits));
+    char *ptr = out.data();
+    memcpy(ptr, &header, sizeof(EncodedChunkHeader));
+    ptr += sizeof(EncodedChunkHeader);
+    memcpy(ptr, lo.data(), M*sizeof(float));
+    ptr += M*sizeof(float);
+    memcpy(ptr, width.data(), M*sizeof(float));
+    ptr += M*sizeof(float);
+
+    // quantize and pack the values
+    const uint32_t q_max = (uint32_t(1) << bits) - 1;
+    std::vector<double> inv_step(M);
+    for (uint32_t j = 0; j < M; j++)
+        inv_step[j] = width[j] > 0.0f ? double(q_max) / double(width[j]) : 0.0;
+
+    uint64_t acc = 0;
+    unsigned int n_acc = 0;
+    for (uint64_t i = 0; i < N; i++)
+        for (uint32_t j = 0; j < M; j++)
+            {
+            double v = (double(data[i*M + j]) - double(lo[j])) * inv_step[j];
+            uint32_t q;
+            if (!(v > 0.0))
+                q = 0;
+            else if (v >= double(q_max))
+                q = q_max;
+            else
+                q = uint32_t(v + 0.5);
+
+            acc |= uint64_t(q) << n_acc;
+            n_acc += bits;
+            while (n_acc >= 8)
+                {
+                *ptr++ = char(acc & 0xff);
+                acc >>= 8;
+                n_acc -= 8;
+                }
+            }
+
+    if (n_acc > 0)
+        *ptr++ = char(acc & 0xff);
+    }
+
+/*! \param header Header to fill out
+    \param in Encoded chunk
+    \returns true if \a in holds a valid encoded chunk with a supported encoding
+*/
+bool readEncodedChunkHeader(EncodedChunkHeader& header, const std::vector<char>& in)
+    {
+    if (in.size() < sizeof(EncodedChunkHeader))
+        return false;
+
+    memcpy(&header, &in[0], sizeof(EncodedChunkHeader));
+    return checkEncodedChunkHeader(header, in.size());
+    }
+
+/*! \param header Header of an encoded chunk
+    \param size Size of the encoded chunk in bytes, including the header
+    \returns true if \a header describes a chunk of \a size bytes with a supported encoding
+*/
+bool checkEncodedChunkHeader(const EncodedChunkHeader& header, uint64_t size)
+    {
+    if (header.codec != GSD_CODEC_QUANTIZE || header.type != GSD_TYPE_FLOAT)
+        return false;
+    if (header.bits == 0 || header.bits > GSD_QUANTIZE_MAX_BITS)
+        return false;
+
+    return size == quantizedSize(header.N, header.M, header.bits);
+    }
+
+/*! \param header Header of a quantized chunk
+    \param first_row First row to decode
+    \param n_rows Number of rows to decode
+    \param first_byte Output: offset of the first byte that holds the rows, relative to quantizedDataOffset()
+    \param n_bytes Output: number of bytes that hold the rows
+
+    Every value has the same number of bits, so the rows are found without decoding the preceding ones. The first
+    and last bytes may be shared with the neighboring rows.
+*/
+void quantizedRowBytes(const EncodedChunkHeader& header,
+                       uint64_t first_row,
+                       uint64_t n_rows,
+                       uint64_t& first_byte,
+                       uint64_t& n_bytes)
+    {
+    uint64_t first_bit = first_row * header.M * header.bits;
+    uint64_t end_bit = (first_row + n_rows) * header.M * header.bits;
+    first_byte = first_bit / 8;
+    n_bytes = (n_rows == 0) ? 0 : (end_bit + 7)/8 - first_byte;
+    }
+
+/*! \param data Buffer to write the decoded n_rows x M values to
+    \param header Header of the quantized chunk
+    \param lo Lowest value of every column
+    \param width Range width of every column
+    \param packed Packed values, starting at the byte given by quantizedRowBytes()
+    \param first_row First row to decode
+    \param n_rows Number of rows to decode
+*/
+void decodeQuantizedRows(float *data,
+                         const EncodedChunkHeader& header,
+                         const float *lo,
+                         const float *width,
+                         const char *packed,
+                         uint64_t first_row,
+                         uint64_t n_rows)
+    {
+    const uint32_t M = header.M;
+    const unsigned int bits = header.bits;
+    if (n_rows == 0 || M == 0)
+        return;
+
+    const uint32_t q_max = (uint32_t(1) << bits) - 1;
+    std::vector<double> step(M);
+    for (uint32_t j = 0; j < M; j++)
+        step[j] = double(width[j]) / double(q_max);
+
+    // skip the bits of the preceding rows in the first byte
+    const char *ptr = packed;
+    unsigned int skip = (first_row * M * bits) % 8;
+    uint64_t acc = uint64_t((unsigned char)*ptr++) >> skip;
+    unsigned int n_acc = 8 - skip;
+
+    for (uint64_t i = 0; i < n_rows; i++)
+        for (uint32_t j = 0; j < M; j++)
+            {
+            while (n_acc < bits)
+                {
+                acc |= uint64_t((unsigned char)*ptr++) << n_acc;
+                n_acc += 8;
+                }
+            uint32_t q = uint32_t(acc & q_max);
+            acc >>= bits;
+            n_acc -= bits;
+
+            data[i*M + j] = float(double(lo[j]) + double(q) * step[j]);
+            }
+    }
+
+/*! \param data Buffer to write the decoded N x M values to
+    \param in Encoded chunk
+
+    \returns true on success, false if \a in is not a valid encoded chunk
+*/
+bool decodeChunk(void *data, const std::vector<char>& in)
+    {
+    EncodedChunkHeader header;
+    if (!readEncodedChunkHeader(header, in))
+        return false;
+
+    const uint32_t M = header.M;
+    const char *ptr = in.data() + sizeof(EncodedChunkHeader);
+
+    std::vector<float> lo(M), width(M);
+    memcpy(lo.data(), ptr, M*sizeof(float));
+    ptr += M*sizeof(float);
+    memcpy(width.data(), ptr, M*sizeof(float));
+    ptr += M*sizeof(float);
+
+    decodeQuantizedRows((float *)data, header, lo.data(), width.data(), ptr, 0, header.N);
+    return true;
+    }
+
+/*! \param data N x 4 quaternions to normalize in place
+    \param N Number of quaternions
+
+    Quantization rounds every component separately, so decoded quaternions are not of unit length. Quaternions with
+    zero norm are left unchanged.
+*/
+void normalizeQuaternions(float *data, uint64_t N)
+    {
+    for (uint64_t i = 0; i < N; i++)
+        {
+        float *q = data + i*4;
+        double norm2 = double(q[0])*q[0] + double(q[1])*q[1] + double(q[2])*q[2] + double(q[3])*q[3];
+        if (norm2 == 0.0)
+            continue;
+
+        double inv_norm = 1.0 / std::sqrt(norm2);
+        for (unsigned int j = 0; j < 4; j++)
+            q[j] = float(q[j] * inv_norm);
+        }
+    }
+
+} // end namespace detail
+} // end namespace hoomd
@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file GSDChunkEncoding.h
+    \brief Declares functions that encode and decode compressed GSD chunks
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __GSD_CHUNK_ENCODING_H__
+#define __GSD_CHUNK_ENCODING_H__
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+namespace hoomd
+{
+namespace detail
+{
+
+//! Prefix of the names of encoded chunks
+/*! An encoded chunk is stored under the name of the plain chunk with this prefix, as a GSD_TYPE_UINT8 chunk with
+    N bytes and M = 1. The bytes start with an EncodedChunkHeader that gives the type and shape of the decoded data.
+    The standard chunk names only ever hold plain data, so other GSD readers never see encoded bytes.
+*/
+const char GSD_ENCODED_CHUNK_PREFIX[] = "encoded/";
+
+//! Schema of GSD files that may contain encoded chunks
+/*! Other readers of the hoomd schema would silently return the values of frame 0 for frames that store a quantity
+    only in an encoded chunk. Files written with encoded chunks therefore use this schema, which those readers reject.
+    The schema version is the same as that of the hoomd schema.
+*/
+const char GSD_ENCODED_SCHEMA[] = "hoomd_encoded";
+
+//! Encodings of compressed chunks
+enum gsd_chunk_codec
+    {
+    GSD_CODEC_QUANTIZE = 1      //!< Fixed precision quantization of float data
+    };
+
+//! Header at the beginning of every encoded chunk
+struct EncodedChunkHeader
+    {
+    uint8_t codec;      //!< Encoding (gsd_chunk_codec)
+    uint8_t bits;       //!< Number of bits per value
+    uint8_t type;       //!< gsd_type of the decoded data
+    uint8_t reserved;   //!< Unused, must be 0
+    uint32_t M;         //!< Number of columns of the decoded data
+    uint64_t N;         //!< Number of rows of the decoded data
+    };
+
+//! Maximum number of bits per value supported by the quantization encoding
+const unsigned int GSD_QUANTIZE_MAX_BITS = 24;
+
+//! Get the name of the encoded chunk that stores the chunk \a name
+PYBIND11_EXPORT std::string encodedChunkName(const std::string& name);
+
+//! Encode float data with fixed precision quantization
+PYBIND11_EXPORT void encodeQuantized(std::vector<char>& out,
+                                     const float *data,
+                                     uint64_t N,
+                                     uint32_t M,
+                                     unsigned int bits);
+
+//! Read and validate the header of an encoded chunk
+PYBIND11_EXPORT bool readEncodedChunkHeader(EncodedChunkHeader& header, const std::vector<char>& in);
+
+//! Validate the header of an encoded chunk of the given size in bytes
+PYBIND11_EXPORT bool checkEncodedChunkHeader(const EncodedChunkHeader& header, uint64_t size);
+
+//! Get the offset of the packed values in a quantized chunk
+PYBIND11_EXPORT size_t quantizedDataOffset(uint32_t M);
+
+//! Get the range of packed bytes that holds the given rows of a quantized chunk
+PYBIND11_EXPORT void quantizedRowBytes(const EncodedChunkHeader& header,
+                                       uint64_t first_row,
+                                       uint64_t n_rows,
+                                       uint64_t& first_byte,
+                                       uint64_t& n_bytes);
+
+//! Decode rows of a quantized chunk
+PYBIND11_EXPORT void decodeQuantizedRows(float *data,
+                                         const EncodedChunkHeader& header,
+                                         const float *lo,
+                                         const float *width,
+                                         const char *packed,
+                                         uint64_t first_row,
+                                         uint64_t n_rows);
+
+//! Decode an encoded chunk
+PYBIND11_EXPORT bool decodeChunk(void *data, const std::vector<char>& in);
+
+//! Scale decoded quaternions back to unit length
+PYBIND11_EXPORT void normalizeQuaternions(float *data, uint64_t N);
+
+} // end namespace detail
+} // end namespace hoomd
+
+#endif
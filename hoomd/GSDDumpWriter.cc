@@ -9,6 +9,7 @@
 */
 
 #include "GSDDumpWriter.h"
+#include "GSDChunkEncoding.h"
 #include "Filesystem.h"
 #include "HOOMDVersion.h"
 
@@ -22,6 +23,7 @@
 #include <string.h>
 #include <stdexcept>
 #include <list>
+#include <algorithm>
 using namespace std;
 namespace py = pybind11;
 
@@ -44,8 +46,18 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
-                        m_group(group)
+                        m_streaming(false),
+                        m_stream_block_size(1 << 20),
+                        m_async(false),
+                        m_quantize_bits(0),
+                        m_nframes(0),
+                        m_group(group),
+                        m_stage_buf(0),
+                        m_staging(false),
+                        m_async_retval(0),
+                        m_async_errno(0)
     {
+    m_n_staged[0] = m_n_staged[1] = 0;
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
     }
 
@@ -76,9 +88,11 @@ void GSDDumpWriter::initFileIO()
         o << "HOOMD-blue " << HOOMD_VERSION_LONG;
 
         m_exec_conf->msg->notice(3) << "dump.gsd: create gsd file " << m_fname << endl;
+        // only HOOMD reads the encoded chunks of quantized frames, see GSD_ENCODED_SCHEMA
+        const char *schema = writesEncodedChunks() ? hoomd::detail::GSD_ENCODED_SCHEMA : "hoomd";
         retval = gsd_create(m_fname.c_str(),
                             o.str().c_str(),
-                            "hoomd",
+                            schema,
                             gsd_make_version(1,3));
         if (retval != 0)
             {
@@ -125,7 +139,8 @@ void GSDDumpWriter::initFileIO()
         }
 
     // validate schema
-    if (string(m_handle.header.schema) != string("hoomd"))
+    if (string(m_handle.header.schema) != string("hoomd")
+        && string(m_handle.header.schema) != string(hoomd::detail::GSD_ENCODED_SCHEMA))
         {
         m_exec_conf->msg->error() << "dump.gsd: " << "Invalid schema in " << m_fname << endl;
         throw runtime_error("Error opening GSD file");
@@ -136,6 +151,15 @@ void GSDDumpWriter::initFileIO()
         throw runtime_error("Error opening GSD file");
         }
 
+    // quantized frames appended to a hoomd schema file would read as frame 0 in other readers
+    if (writesEncodedChunks() && string(m_handle.header.schema) == string("hoomd"))
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << "Cannot append quantized frames to " << m_fname
+                                  << ", which uses the hoomd schema" << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
     }
 
@@ -150,11 +174,76 @@ GSDDumpWriter::~GSDDumpWriter()
 
     if (root && m_is_initialized)
         {
+        // finish writing the last frame
+        m_async_writer.wait();
+        if (m_async_retval != 0)
+            m_exec_conf->msg->error() << "dump.gsd: " << strerror(m_async_errno) << " - " << m_fname << endl;
+
         m_exec_conf->msg->notice(5) << "dump.gsd: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
     }
 
+/*! \param b True if frames should be written on a background thread
+
+    Any frame that is still being written in the background is completed before switching modes.
+*/
+void GSDDumpWriter::setAsynchronous(bool b)
+    {
+    if (b && m_streaming)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: asynchronous writes are not supported when streaming" << endl;
+        throw runtime_error("Error setting asynchronous writes");
+        }
+
+    if (m_is_initialized)
+        waitAsync();
+    m_async = b;
+    }
+
+void GSDDumpWriter::flush()
+    {
+    if (m_is_initialized)
+        waitAsync();
+    }
+
+/*! \param bits Number of bits per value, 0 to store float particle data as is
+
+    Positions, orientations, velocities, and angular momenta are stored with the fixed precision quantization
+    encoding of GSDChunkEncoding.h when \a bits is not 0. The file is then created with the GSD_ENCODED_SCHEMA
+    schema, which only HOOMD reads, so quantization must be enabled before the first frame is written.
+*/
+void GSDDumpWriter::setQuantizeBits(unsigned int bits)
+    {
+    if (bits > hoomd::detail::GSD_QUANTIZE_MAX_BITS)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: quantization must use at most " << hoomd::detail::GSD_QUANTIZE_MAX_BITS
+                                  << " bits" << std::endl;
+        throw std::runtime_error("Error setting quantization");
+        }
+    if (bits > 0 && m_is_initialized && string(m_handle.header.schema) == string("hoomd"))
+        {
+        m_exec_conf->msg->error() << "dump.gsd: quantization must be enabled before the first frame is written"
+                                  << std::endl;
+        throw std::runtime_error("Error setting quantization");
+        }
+    m_quantize_bits = bits;
+    }
+
+//! Wait for the writer thread to complete the previous frame and report any error
+void GSDDumpWriter::waitAsync()
+    {
+    m_async_writer.wait();
+
+    if (m_async_retval != 0)
+        {
+        int retval = m_async_retval;
+        m_async_retval = 0;
+        errno = m_async_errno;
+        checkError(retval);
+        }
+    }
+
 /*! \param timestep Current time step of the simulation
 
     The first call to analyze() will create or overwrite the file and write out the current system configuration
@@ -168,10 +257,14 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+    // take particle data snapshot, unless the particle data is streamed from the local data
     SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
+    std::map<unsigned int, unsigned int> map;
+    if (!m_streaming)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+        map = m_pdata->takeSnapshot<float>(snapshot);
+        }
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -182,9 +275,17 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (! m_is_initialized && root)
         initFileIO();
 
+    // when writing asynchronously, the frame is staged and the writer thread writes it to the file
+    m_staging = m_async && root;
+    if (m_staging)
+        m_n_staged[m_stage_buf] = 0;
+
     // truncate the file if requested
     if (m_truncate && root)
         {
+        // the writer thread must be done with the previous frame
+        waitAsync();
+
         m_exec_conf->msg->notice(10) << "dump.gsd: truncating file" << endl;
         retval = gsd_truncate(&m_handle);
         if (retval == -1)
@@ -217,12 +318,13 @@ void GSDDumpWriter::analyze(unsigned int timestep)
             m_exec_conf->msg->error() << "dump.gsd: " << "Unknown error opening: " << m_fname << endl;
             throw runtime_error("Error opening GSD file");
             }
+        m_nframes = 0;
         }
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "dump.gsd: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -236,12 +338,28 @@ void GSDDumpWriter::analyze(unsigned int timestep)
         writeFrameHeader(timestep);
 
         // only write out data chunk categories if requested, or if on frame 0
+        if (!m_streaming)
+            {
+            if (m_write_attribute || nframes == 0)
+                writeAttributes(snapshot, map);
+            if (m_write_property || nframes == 0)
+                writeProperties(snapshot, map);
+            if (m_write_momentum || nframes == 0)
+                writeMomenta(snapshot, map);
+            }
+        }
+
+    if (m_streaming)
+        {
+        // all ranks take part in writing the streamed chunks
+        buildStreamRows();
+
         if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
+            writeAttributesStreamed(nframes, root);
         if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
+            writePropertiesStreamed(nframes, root);
         if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+            writeMomentaStreamed(nframes, root);
         }
 
     // topology is only meaningful if this is the all group
@@ -269,6 +387,10 @@ void GSDDumpWriter::analyze(unsigned int timestep)
             writeTopology(bdata_snapshot, adata_snapshot, ddata_snapshot, idata_snapshot, cdata_snapshot, pdata_snapshot);
         }
 
+    // slots write to the file directly, so the writer thread must be done with the previous frame
+    if (m_staging && m_write_signal.getNumSlots() > 0)
+        waitAsync();
+
     // emit on all ranks, the slot needs to handle the mpi logic.
     m_write_signal.emit(m_handle);
 
@@ -276,9 +398,26 @@ void GSDDumpWriter::analyze(unsigned int timestep)
 
     if (root)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        checkError(retval);
+        if (m_async)
+            {
+            // hand the staged frame to the writer thread and stage the next frame in the other buffer
+            unsigned int buf = m_stage_buf;
+            m_stage_buf ^= 1;
+            m_staging = false;
+
+            // report an error in the previous frame before handing over the next one
+            waitAsync();
+
+            m_exec_conf->msg->notice(10) << "dump.gsd: writing frame in the background" << endl;
+            m_async_writer.submit([this, buf]{ writeStagedFrame(buf); });
+            }
+        else
+            {
+            m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
+            retval = gsd_end_frame(&m_handle);
+            checkError(retval);
+            }
+        m_nframes++;
         }
 
     if (m_prof)
@@ -286,6 +425,170 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     }
 
 
+/*! \param name Name of the data chunk
+    \param type Type of the data in the chunk
+    \param N Number of rows in the chunk
+    \param M Number of columns in the chunk
+    \param flags Chunk flags
+    \param data Data buffer
+
+    Writes the chunk to the current frame. While staging a frame for the writer thread, \a data is copied to the
+    staging buffer instead.
+
+    \returns The return value of gsd_write_chunk(), 0 when staging
+*/
+int GSDDumpWriter::writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, uint8_t flags, const void *data)
+    {
+    if (!m_staging)
+        return gsd_write_chunk(&m_handle, name, type, N, M, flags, data);
+
+    StagedChunk& chunk = stageChunk(name, type, N, M, flags);
+    memcpy(chunk.data.data(), data, N*M*gsd_sizeof_type(type));
+    return 0;
+    }
+
+/*! \param name Name of the data chunk
+    \param N Number of rows in the chunk
+    \param M Number of columns in the chunk
+    \param data Data buffer
+
+    Writes a float chunk as is, or quantized to getQuantizeBits() bits per value. Frame 0 is always written as is, so
+    that readers that do not know the encoding find the standard chunks. Quantized chunks are written under the name
+    given by encodedChunkName(). While staging a frame for the writer thread, the data is staged as is and the writer
+    thread quantizes it.
+*/
+int GSDDumpWriter::writeFloatChunk(const char *name, uint64_t N, uint32_t M, const float *data)
+    {
+    if (m_quantize_bits == 0 || m_nframes == 0)
+        return writeChunk(name, GSD_TYPE_FLOAT, N, M, 0, data);
+
+    if (m_staging)
+        {
+        StagedChunk& chunk = stageChunk(name, GSD_TYPE_FLOAT, N, M, 0);
+        memcpy(chunk.data.data(), data, N*M*sizeof(float));
+        chunk.quantize_bits = m_quantize_bits;
+        return 0;
+        }
+
+    return writeQuantizedChunk(m_encode_buf, name, N, M, data, m_quantize_bits);
+    }
+
+/*! \param buf Buffer to encode the chunk in
+    \param name Name of the data chunk
+    \param N Number of rows in the chunk
+    \param M Number of columns in the chunk
+    \param data Data buffer
+    \param bits Number of bits per value
+
+    \returns The return value of gsd_write_chunk()
+*/
+int GSDDumpWriter::writeQuantizedChunk(std::vector<char>& buf,
+                                       const char *name,
+                                       uint64_t N,
+                                       uint32_t M,
+                                       const float *data,
+                                       unsigned int bits)
+    {
+    hoomd::detail::encodeQuantized(buf, data, N, M, bits);
+    return gsd_write_chunk(&m_handle, hoomd::detail::encodedChunkName(name).c_str(), GSD_TYPE_UINT8, buf.size(), 1, 0,
+                           buf.data());
+    }
+
+/*! \param name Name of the data chunk
+    \param type Type of the data in the chunk
+    \param N Number of rows in the chunk
+    \param M Number of columns in the chunk
+
+    Starts a chunk that is filled with writeChunkRows(). While staging a frame for the writer thread, the whole chunk
+    is allocated in the staging buffer.
+
+    \returns The return value of gsd_begin_chunk(), 0 when staging
+*/
+int GSDDumpWriter::beginChunk(const char *name, gsd_type type, uint64_t N, uint32_t M)
+    {
+    if (!m_staging)
+        return gsd_begin_chunk(&m_handle, name, type, N, M);
+
+    stageChunk(name, type, N, M, 0);
+    return 0;
+    }
+
+/*! \param first_row First row to write
+    \param n_rows Number of rows to write
+    \param data Data buffer
+
+    \returns The return value of gsd_write_chunk_rows(), 0 when staging
+*/
+int GSDDumpWriter::writeChunkRows(uint64_t first_row, uint64_t n_rows, const void *data)
+    {
+    if (!m_staging)
+        return gsd_write_chunk_rows(&m_handle, first_row, n_rows, data);
+
+    assert(m_n_staged[m_stage_buf] > 0);
+    StagedChunk& chunk = m_staged[m_stage_buf][m_n_staged[m_stage_buf]-1];
+    size_t row_size = chunk.M * gsd_sizeof_type(chunk.type);
+    assert(first_row + n_rows <= chunk.N);
+    memcpy(chunk.data.data() + first_row*row_size, data, n_rows*row_size);
+    return 0;
+    }
+
+/*! Staged chunks are reused from frame to frame to avoid reallocating their data.
+
+    \returns The next chunk in the staging buffer, with space for the data allocated
+*/
+GSDDumpWriter::StagedChunk& GSDDumpWriter::stageChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, uint8_t flags)
+    {
+    std::vector<StagedChunk>& staged = m_staged[m_stage_buf];
+    unsigned int& n_staged = m_n_staged[m_stage_buf];
+    if (n_staged == staged.size())
+        staged.push_back(StagedChunk());
+
+    StagedChunk& chunk = staged[n_staged++];
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    chunk.flags = flags;
+    chunk.quantize_bits = 0;
+    chunk.data.resize(N*M*gsd_sizeof_type(type));
+    chunk.data.reserve(1);  // data() must not be NULL for empty chunks
+    return chunk;
+    }
+
+/*! \param buf Staging buffer to write
+
+    Runs on the writer thread. Writes all chunks staged in buffer \a buf and ends the frame. Errors are stored in
+    m_async_retval and reported by waitAsync().
+*/
+void GSDDumpWriter::writeStagedFrame(unsigned int buf)
+    {
+    const std::vector<StagedChunk>& staged = m_staged[buf];
+    for (unsigned int i = 0; i < m_n_staged[buf]; i++)
+        {
+        const StagedChunk& chunk = staged[i];
+        int retval;
+        if (chunk.quantize_bits != 0)
+            retval = writeQuantizedChunk(m_async_encode_buf, chunk.name.c_str(), chunk.N, chunk.M,
+                                         (const float *)chunk.data.data(), chunk.quantize_bits);
+        else
+            retval = gsd_write_chunk(&m_handle, chunk.name.c_str(), chunk.type, chunk.N, chunk.M, chunk.flags,
+                                     chunk.data.data());
+        if (retval != 0)
+            {
+            m_async_errno = errno;
+            m_async_retval = retval;
+            return;
+            }
+        }
+
+    int retval = gsd_end_frame(&m_handle);
+    if (retval != 0)
+        {
+        m_async_errno = errno;
+        m_async_retval = retval;
+        }
+    }
+
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
     {
     int max_len = 0;
@@ -300,7 +603,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
+        int retval = writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
         checkError(retval);
         }
 
@@ -319,14 +622,14 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     int retval;
     m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
+    retval = writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
     checkError(retval);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/dimensions" << endl;
         uint8_t dimensions = m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
+        retval = writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
         checkError(retval);
         }
 
@@ -339,12 +642,12 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     box_a[3] = box.getTiltFactorXY();
     box_a[4] = box.getTiltFactorXZ();
     box_a[5] = box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
+    retval = writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
     checkError(retval);
 
     m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+    retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
     checkError(retval);
     }
 
@@ -356,7 +659,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -382,7 +685,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
+            retval = writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
@@ -411,7 +714,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
@@ -435,7 +738,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
@@ -460,7 +763,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
@@ -489,7 +792,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
+            retval = writeChunk("particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
@@ -524,7 +827,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
@@ -540,7 +843,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(N*3);
@@ -560,7 +863,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+        retval = writeFloatChunk("particles/position", N, 3, &data[0]);
         checkError(retval);
         }
 
@@ -594,7 +897,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeFloatChunk("particles/orientation", N, 4, &data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
@@ -610,7 +913,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(N*3);
@@ -640,7 +943,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeFloatChunk("particles/velocity", N, 3, &data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
@@ -677,7 +980,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeFloatChunk("particles/angmom", N, 4, &data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
@@ -712,7 +1015,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
@@ -720,6 +1023,422 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
     }
 
+/*! Sort the local members of the group by their index in the group, which is the row they are written to in the
+    per-particle chunks.
+*/
+void GSDDumpWriter::buildStreamRows()
+    {
+    unsigned int n_local = m_group->getNumMembers();
+    unsigned int N = m_group->getNumMembersGlobal();
+
+    // access the group arrays first, they may access the tag array when rebuilt
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    std::vector< std::pair<unsigned int, unsigned int> > rows(n_local);
+    for (unsigned int group_idx = 0; group_idx < n_local; group_idx++)
+        {
+        unsigned int idx = h_member_idx.data[group_idx];
+        unsigned int tag = h_tag.data[idx];
+
+        // the member tags are sorted, the position of the tag is the row in the file
+        const unsigned int *it = std::lower_bound(h_member_tags.data, h_member_tags.data + N, tag);
+        assert(it != h_member_tags.data + N && *it == tag);
+        rows[group_idx] = std::make_pair((unsigned int)(it - h_member_tags.data), idx);
+        }
+
+    std::sort(rows.begin(), rows.end());
+
+    m_stream_rows.resize(n_local);
+    m_stream_idx.resize(n_local);
+    for (unsigned int i = 0; i < n_local; i++)
+        {
+        m_stream_rows[i] = rows[i].first;
+        m_stream_idx[i] = rows[i].second;
+        }
+    }
+
+/*! \param name Name of the chunk
+    \param type Type of the chunk
+    \param M Number of columns of the chunk
+    \param local_data Values of the local group members (M per member, in the order of m_stream_rows)
+    \param all_default True if all local values are the default value of the chunk
+    \param nframes Number of frames in the file
+    \param root True on the rank that writes the file
+
+    The chunk is written in blocks of m_stream_block_size rows. All ranks send their rows of the current block to the
+    root rank, which assembles the block and writes it directly to its place in the file. The root rank never holds
+    more than one block of the chunk.
+*/
+template<class T>
+void GSDDumpWriter::writeChunkStreamed(const std::string& name,
+                                       gsd_type type,
+                                       unsigned int M,
+                                       const std::vector<T>& local_data,
+                                       bool all_default,
+                                       uint64_t nframes,
+                                       bool root)
+    {
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        int all_default_int = all_default;
+        MPI_Allreduce(MPI_IN_PLACE, &all_default_int, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+        all_default = all_default_int;
+        }
+    #endif
+
+    bool write = false;
+    if (root)
+        write = !all_default || (nframes > 0 && m_nondefault[name]);
+
+    #ifdef ENABLE_MPI
+    bcast(write, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (!write)
+        return;
+
+    uint32_t N = m_group->getNumMembersGlobal();
+    int retval;
+
+    if (root)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << endl;
+        retval = beginChunk(name.c_str(), type, N, M);
+        checkError(retval);
+        if (nframes == 0)
+            m_nondefault[name] = true;
+        }
+
+    std::vector<T> block;
+    if (root)
+        block.resize(size_t(std::min(m_stream_block_size, N)) * M);
+
+    #ifdef ENABLE_MPI
+    std::vector<unsigned int> recv_rows;
+    std::vector<T> recv_data;
+    std::vector<int> counts;
+    std::vector<int> displs;
+    if (root)
+        {
+        counts.resize(m_exec_conf->getNRanks());
+        displs.resize(m_exec_conf->getNRanks());
+        }
+    #endif
+
+    unsigned int n_local = (unsigned int)m_stream_rows.size();
+    unsigned int begin = 0;
+    for (uint64_t first = 0; first < N; first += m_stream_block_size)
+        {
+        uint64_t last = std::min(first + m_stream_block_size, uint64_t(N));
+
+        // local rows in this block
+        unsigned int end = begin;
+        while (end < n_local && m_stream_rows[end] < last)
+            end++;
+
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+            int n_send = end - begin;
+            MPI_Gather(&n_send, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi_comm);
+
+            int n_recv = 0;
+            if (root)
+                {
+                for (unsigned int i = 0; i < counts.size(); i++)
+                    {
+                    displs[i] = n_recv;
+                    n_recv += counts[i];
+                    }
+                recv_rows.resize(n_recv);
+                recv_data.resize(size_t(n_recv) * M);
+                }
+
+            MPI_Gatherv(m_stream_rows.data() + begin, n_send, MPI_UNSIGNED,
+                        recv_rows.data(), counts.data(), displs.data(), MPI_UNSIGNED, 0, mpi_comm);
+
+            // the values are sent as bytes
+            if (root)
+                {
+                for (unsigned int i = 0; i < counts.size(); i++)
+                    {
+                    counts[i] *= M*sizeof(T);
+                    displs[i] *= M*sizeof(T);
+                    }
+                }
+
+            MPI_Gatherv(local_data.data() + size_t(begin) * M, n_send*M*sizeof(T), MPI_BYTE,
+                        recv_data.data(), counts.data(), displs.data(), MPI_BYTE, 0, mpi_comm);
+
+            if (root)
+                {
+                for (int i = 0; i < n_recv; i++)
+                    {
+                    size_t row = recv_rows[i] - first;
+                    for (unsigned int k = 0; k < M; k++)
+                        block[row*M + k] = recv_data[size_t(i)*M + k];
+                    }
+                }
+            }
+        else
+        #endif
+            {
+            for (unsigned int i = begin; i < end; i++)
+                {
+                size_t row = m_stream_rows[i] - first;
+                for (unsigned int k = 0; k < M; k++)
+                    block[row*M + k] = local_data[size_t(i)*M + k];
+                }
+            }
+
+        if (root)
+            {
+            retval = writeChunkRows(first, last - first, block.data());
+            checkError(retval);
+            }
+
+        begin = end;
+        }
+    }
+
+/*! \param nframes Number of frames in the file
+    \param root True on the rank that writes the file
+
+    Writes the same chunks as writeAttributes() from the local particle data.
+*/
+void GSDDumpWriter::writeAttributesStreamed(uint64_t nframes, bool root)
+    {
+    unsigned int n_local = (unsigned int)m_stream_idx.size();
+
+    if (root)
+        {
+        std::vector<std::string> type_mapping;
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+            type_mapping.push_back(m_pdata->getNameByType(i));
+        writeTypeMapping("particles/types", type_mapping);
+        }
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+
+        {
+        std::vector<uint32_t> type(n_local);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            type[i] = uint32_t(__scalar_as_int(h_postype.data[m_stream_idx[i]].w));
+            if (type[i] != 0)
+                all_default = false;
+            }
+        writeChunkStreamed("particles/typeid", GSD_TYPE_UINT32, 1, type, all_default, nframes, root);
+        }
+
+        {
+        std::vector<float> data(n_local);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            data[i] = float(h_vel.data[m_stream_idx[i]].w);
+            if (data[i] != float(1.0))
+                all_default = false;
+            }
+        writeChunkStreamed("particles/mass", GSD_TYPE_FLOAT, 1, data, all_default, nframes, root);
+
+        all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            data[i] = float(h_charge.data[m_stream_idx[i]]);
+            if (data[i] != float(0.0))
+                all_default = false;
+            }
+        writeChunkStreamed("particles/charge", GSD_TYPE_FLOAT, 1, data, all_default, nframes, root);
+
+        all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            data[i] = float(h_diameter.data[m_stream_idx[i]]);
+            if (data[i] != float(1.0))
+                all_default = false;
+            }
+        writeChunkStreamed("particles/diameter", GSD_TYPE_FLOAT, 1, data, all_default, nframes, root);
+        }
+
+        {
+        std::vector<int32_t> body(n_local);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            unsigned int b = h_body.data[m_stream_idx[i]];
+            if (b != NO_BODY)
+                all_default = false;
+            body[i] = int32_t(b);
+            }
+        writeChunkStreamed("particles/body", GSD_TYPE_INT32, 1, body, all_default, nframes, root);
+        }
+
+        {
+        std::vector<float> data(n_local*3);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            Scalar3 inertia = h_inertia.data[m_stream_idx[i]];
+            data[i*3+0] = float(inertia.x);
+            data[i*3+1] = float(inertia.y);
+            data[i*3+2] = float(inertia.z);
+            if (data[i*3+0] != float(0.0) || data[i*3+1] != float(0.0) || data[i*3+2] != float(0.0))
+                all_default = false;
+            }
+        writeChunkStreamed("particles/moment_inertia", GSD_TYPE_FLOAT, 3, data, all_default, nframes, root);
+        }
+    }
+
+/*! \param nframes Number of frames in the file
+    \param root True on the rank that writes the file
+
+    Writes the same chunks as writeProperties() from the local particle data.
+*/
+void GSDDumpWriter::writePropertiesStreamed(uint64_t nframes, bool root)
+    {
+    unsigned int n_local = (unsigned int)m_stream_idx.size();
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 o_image = m_pdata->getOriginImage();
+
+        {
+        std::vector<float> data(n_local*3);
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            unsigned int idx = m_stream_idx[i];
+
+            // make sure the position is within the boundaries, as in ParticleData::takeSnapshot()
+            Scalar4 postype = h_postype.data[idx];
+            vec3<float> pos(make_scalar3(postype.x, postype.y, postype.z) - origin);
+            int3 image = h_image.data[idx];
+            image.x -= o_image.x;
+            image.y -= o_image.y;
+            image.z -= o_image.z;
+            Scalar3 tmp = vec_to_scalar3(pos);
+            global_box.wrap(tmp, image);
+
+            data[i*3+0] = float(tmp.x);
+            data[i*3+1] = float(tmp.y);
+            data[i*3+2] = float(tmp.z);
+            }
+        writeChunkStreamed("particles/position", GSD_TYPE_FLOAT, 3, data, false, nframes, root);
+        }
+
+        {
+        std::vector<float> data(n_local*4);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            Scalar4 orientation = h_orientation.data[m_stream_idx[i]];
+            data[i*4+0] = float(orientation.x);
+            data[i*4+1] = float(orientation.y);
+            data[i*4+2] = float(orientation.z);
+            data[i*4+3] = float(orientation.w);
+            if (data[i*4+0] != float(1.0) || data[i*4+1] != float(0.0) ||
+                data[i*4+2] != float(0.0) || data[i*4+3] != float(0.0))
+                {
+                all_default = false;
+                }
+            }
+        writeChunkStreamed("particles/orientation", GSD_TYPE_FLOAT, 4, data, all_default, nframes, root);
+        }
+    }
+
+/*! \param nframes Number of frames in the file
+    \param root True on the rank that writes the file
+
+    Writes the same chunks as writeMomenta() from the local particle data.
+*/
+void GSDDumpWriter::writeMomentaStreamed(uint64_t nframes, bool root)
+    {
+    unsigned int n_local = (unsigned int)m_stream_idx.size();
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+
+        {
+        std::vector<float> data(n_local*3);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            Scalar4 vel = h_vel.data[m_stream_idx[i]];
+            data[i*3+0] = float(vel.x);
+            data[i*3+1] = float(vel.y);
+            data[i*3+2] = float(vel.z);
+            if (data[i*3+0] != float(0.0) || data[i*3+1] != float(0.0) || data[i*3+2] != float(0.0))
+                all_default = false;
+            }
+        writeChunkStreamed("particles/velocity", GSD_TYPE_FLOAT, 3, data, all_default, nframes, root);
+        }
+
+        {
+        std::vector<float> data(n_local*4);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            Scalar4 angmom = h_angmom.data[m_stream_idx[i]];
+            data[i*4+0] = float(angmom.x);
+            data[i*4+1] = float(angmom.y);
+            data[i*4+2] = float(angmom.z);
+            data[i*4+3] = float(angmom.w);
+            if (data[i*4+0] != float(0.0) || data[i*4+1] != float(0.0) ||
+                data[i*4+2] != float(0.0) || data[i*4+3] != float(0.0))
+                {
+                all_default = false;
+                }
+            }
+        writeChunkStreamed("particles/angmom", GSD_TYPE_FLOAT, 4, data, all_default, nframes, root);
+        }
+
+        {
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        Scalar3 origin = m_pdata->getOrigin();
+        int3 o_image = m_pdata->getOriginImage();
+
+        std::vector<int32_t> data(n_local*3);
+        bool all_default = true;
+        for (unsigned int i = 0; i < n_local; i++)
+            {
+            unsigned int idx = m_stream_idx[i];
+
+            // the image changes when the position is wrapped, as in ParticleData::takeSnapshot()
+            Scalar4 postype = h_postype.data[idx];
+            vec3<float> pos(make_scalar3(postype.x, postype.y, postype.z) - origin);
+            int3 image = h_image.data[idx];
+            image.x -= o_image.x;
+            image.y -= o_image.y;
+            image.z -= o_image.z;
+            Scalar3 tmp = vec_to_scalar3(pos);
+            global_box.wrap(tmp, image);
+
+            data[i*3+0] = image.x;
+            data[i*3+1] = image.y;
+            data[i*3+2] = image.z;
+            if (image.x != 0 || image.y != 0 || image.z != 0)
+                all_default = false;
+            }
+        writeChunkStreamed("particles/image", GSD_TYPE_INT32, 3, data, all_default, nframes, root);
+        }
+    }
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -740,68 +1459,68 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
+        retval = writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
         checkError(retval);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
+        retval = writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
         checkError(retval);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
         checkError(retval);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
+        retval = writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
         checkError(retval);
         }
 
@@ -809,7 +1528,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
@@ -819,12 +1538,12 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
+        retval = writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
         checkError(retval);
         }
 
@@ -832,17 +1551,17 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
+        retval = writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
         checkError(retval);
         }
     }
@@ -920,7 +1639,7 @@ void GSDDumpWriter::writeUser(unsigned int timestep, bool root)
                 throw runtime_error("Invalid numpy dimension in gsd user-defined log data [" + item.first + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle, name.c_str(), type, arr.shape(0), M, 0, (void *)arr.data());
+            int retval = writeChunk(name.c_str(), type, arr.shape(0), M, 0, (void *)arr.data());
             checkError(retval);
             }
         }
@@ -968,7 +1687,8 @@ void GSDDumpWriter::populateNonDefault()
         }
 
     // validate schema
-    if (string(m_handle.header.schema) != string("hoomd"))
+    if (string(m_handle.header.schema) != string("hoomd")
+        && string(m_handle.header.schema) != string(hoomd::detail::GSD_ENCODED_SCHEMA))
         {
         m_exec_conf->msg->error() << "dump.gsd: " << "Invalid schema in " << m_fname << endl;
         throw runtime_error("Error opening GSD file");
@@ -1010,6 +1730,13 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setStreaming", &GSDDumpWriter::setStreaming)
+        .def("setStreamBlockSize", &GSDDumpWriter::setStreamBlockSize)
+        .def("getStreamBlockSize", &GSDDumpWriter::getStreamBlockSize)
+        .def("setAsynchronous", &GSDDumpWriter::setAsynchronous)
+        .def("setQuantizeBits", &GSDDumpWriter::setQuantizeBits)
+        .def("getQuantizeBits", &GSDDumpWriter::getQuantizeBits)
+        .def("flush", &GSDDumpWriter::flush)
         .def_readwrite("user_log", &GSDDumpWriter::m_user_log)
     ;
     }
@@ -6,11 +6,14 @@
 #define __GSDDUMPWRITER_H__
 
 #include "Analyzer.h"
+#include "AsyncWriter.h"
 #include "ParticleGroup.h"
 #include "SharedSignal.h"
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <stdexcept>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -67,12 +70,59 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control streaming writes of the particle data
+        /*! When streaming, the per-particle chunks are written from the local particle data in blocks of
+            getStreamBlockSize() rows, without taking a full particle data snapshot.
+        */
+        void setStreaming(bool b)
+            {
+            if (b && m_async)
+                {
+                m_exec_conf->msg->error() << "dump.gsd: streaming is not supported with asynchronous writes"
+                                          << std::endl;
+                throw std::runtime_error("Error setting streaming");
+                }
+            m_streaming = b;
+            }
+
+        //! Set the number of rows written per block when streaming
+        void setStreamBlockSize(unsigned int block_size)
+            {
+            if (block_size == 0)
+                {
+                m_exec_conf->msg->error() << "dump.gsd: stream block size must be positive" << std::endl;
+                throw std::runtime_error("Error setting stream block size");
+                }
+            m_stream_block_size = block_size;
+            }
+
+        //! Get the number of rows written per block when streaming
+        unsigned int getStreamBlockSize() const
+            {
+            return m_stream_block_size;
+            }
+
+        //! Control asynchronous writes
+        void setAsynchronous(bool b);
+
+        //! Set the number of bits per value used to store quantized float particle data (0 stores the data as is)
+        void setQuantizeBits(unsigned int bits);
+
+        //! Get the number of bits per value used to store quantized float particle data
+        unsigned int getQuantizeBits() const
+            {
+            return m_quantize_bits;
+            }
+
         //! Destructor
         ~GSDDumpWriter();
 
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
+        //! Wait until the frame being written in the background is in the file
+        virtual void flush();
+
         hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
 
     private:
@@ -84,6 +134,11 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         bool m_write_property;              //!< True if properties should be written
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
+        bool m_streaming;                   //!< True if particle data is written in blocks from the local data
+        unsigned int m_stream_block_size;   //!< Number of rows per block when streaming
+        bool m_async;                       //!< True if frames are written by the writer thread
+        unsigned int m_quantize_bits;       //!< Bits per value of quantized float particle data (0 if not quantized)
+        uint64_t m_nframes;                 //!< Number of frames in the file, including those not yet written
         gsd_handle m_handle;                //!< Handle to the file
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
@@ -92,6 +147,66 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        std::vector<unsigned int> m_stream_rows;    //!< Group index of every local group member, in ascending order
+        std::vector<unsigned int> m_stream_idx;     //!< Local particle index of every entry in m_stream_rows
+
+        //! A chunk staged for the writer thread
+        struct StagedChunk
+            {
+            std::string name;       //!< Name of the chunk
+            gsd_type type;          //!< Type of the data
+            uint64_t N;             //!< Number of rows
+            uint32_t M;             //!< Number of columns
+            uint8_t flags;          //!< Chunk flags
+            unsigned int quantize_bits; //!< Bits per value to quantize the data to on the writer thread (0 if not)
+            std::vector<char> data; //!< Chunk data
+            };
+
+        AsyncWriter m_async_writer;                 //!< Writes staged frames in the background
+        std::vector<StagedChunk> m_staged[2];       //!< Double buffered staged chunks
+        unsigned int m_n_staged[2];                 //!< Number of chunks staged in each buffer
+        unsigned int m_stage_buf;                   //!< Buffer the current frame is staged in
+        bool m_staging;                             //!< True if chunks are currently staged instead of written
+        int m_async_retval;                         //!< Error returned to the writer thread
+        int m_async_errno;                          //!< errno at the time of the writer thread error
+        std::vector<char> m_encode_buf;             //!< Buffer for encoded chunks written by the calling thread
+        std::vector<char> m_async_encode_buf;       //!< Buffer for encoded chunks written by the writer thread
+
+        //! Write a chunk to the file, or stage it for the writer thread
+        int writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, uint8_t flags, const void *data);
+
+        //! True if frames after the first store quantized data in encoded chunks
+        bool writesEncodedChunks() const
+            {
+            return m_quantize_bits > 0 && !m_truncate;
+            }
+
+        //! Write a float per-particle chunk, quantized if requested
+        int writeFloatChunk(const char *name, uint64_t N, uint32_t M, const float *data);
+
+        //! Quantize and write a float chunk
+        int writeQuantizedChunk(std::vector<char>& buf,
+                                const char *name,
+                                uint64_t N,
+                                uint32_t M,
+                                const float *data,
+                                unsigned int bits);
+
+        //! Begin a chunk that is written in blocks of rows
+        int beginChunk(const char *name, gsd_type type, uint64_t N, uint32_t M);
+
+        //! Write rows of the chunk started by beginChunk()
+        int writeChunkRows(uint64_t first_row, uint64_t n_rows, const void *data);
+
+        //! Allocate the next chunk in the current staging buffer
+        StagedChunk& stageChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, uint8_t flags);
+
+        //! Write a staged frame to the file (called on the writer thread)
+        void writeStagedFrame(unsigned int buf);
+
+        //! Wait for the writer thread and raise an exception if it failed
+        void waitAsync();
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -110,6 +225,28 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write particle momenta
         void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
 
+        //! Find the group index of every local group member
+        void buildStreamRows();
+
+        //! Write particle attributes from the local particle data
+        void writeAttributesStreamed(uint64_t nframes, bool root);
+
+        //! Write particle properties from the local particle data
+        void writePropertiesStreamed(uint64_t nframes, bool root);
+
+        //! Write particle momenta from the local particle data
+        void writeMomentaStreamed(uint64_t nframes, bool root);
+
+        //! Write one per-particle chunk from the local particle data in blocks
+        template<class T>
+        void writeChunkStreamed(const std::string& name,
+                                gsd_type type,
+                                unsigned int M,
+                                const std::vector<T>& local_data,
+                                bool all_default,
+                                uint64_t nframes,
+                                bool root);
+
         //! Write bond topology
         void writeTopology(BondData::Snapshot& bond,
                            AngleData::Snapshot& angle,
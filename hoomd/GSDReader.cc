@@ -11,33 +11,123 @@
 #include "GSDReader.h"
 #include "SnapshotSystemData.h"
 #include "ExecutionConfiguration.h"
+#include "GSDChunkEncoding.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
 
+#include <algorithm>
 #include <stdexcept>
 using namespace std;
 
 namespace py = pybind11;
 
+#ifdef ENABLE_MPI
+//! Get the first of the rows of a chunk that are read by one rank
+/*! \param N Number of rows in the chunk
+    \param rank Rank that reads the rows
+    \param n_ranks Number of ranks
+
+    Each rank reads about N / n_ranks consecutive rows, the rows of rank r end at the first row of rank r+1.
+*/
+static uint64_t getFirstRow(uint64_t N, unsigned int rank, unsigned int n_ranks)
+    {
+    return N * rank / n_ranks;
+    }
+
+//! Get the rank that reads a row (the inverse of getFirstRow())
+static unsigned int getRowRank(uint64_t row, uint64_t N, unsigned int n_ranks)
+    {
+    return ((row + 1) * n_ranks - 1) / N;
+    }
+
+//! Send rows to other ranks with a single all-to-all exchange
+/*! \param send Rows to send to each rank
+    \param recv Output: received rows, ordered by the rank they came from
+    \param mpi_comm MPI communicator
+
+    \tparam T Trivially copyable row type
+*/
+template<class T>
+static void exchangeRows(const std::vector< std::vector<T> >& send, std::vector<T>& recv, const MPI_Comm mpi_comm)
+    {
+    unsigned int n_ranks = send.size();
+    std::vector<int> send_counts(n_ranks), send_displs(n_ranks);
+    std::vector<int> recv_counts(n_ranks), recv_displs(n_ranks);
+
+    std::vector<T> send_buf;
+    for (unsigned int r = 0; r < n_ranks; r++)
+        {
+        send_displs[r] = send_buf.size() * sizeof(T);
+        send_counts[r] = send[r].size() * sizeof(T);
+        send_buf.insert(send_buf.end(), send[r].begin(), send[r].end());
+        }
+
+    MPI_Alltoall(&send_counts[0], 1, MPI_INT, &recv_counts[0], 1, MPI_INT, mpi_comm);
+
+    size_t n_recv = 0;
+    for (unsigned int r = 0; r < n_ranks; r++)
+        {
+        recv_displs[r] = n_recv;
+        n_recv += recv_counts[r];
+        }
+    recv.resize(n_recv / sizeof(T));
+
+    MPI_Alltoallv(send_buf.data(), &send_counts[0], &send_displs[0], MPI_BYTE,
+                  recv.data(), &recv_counts[0], &recv_displs[0], MPI_BYTE, mpi_comm);
+    }
+
+//! A particle sent to its owner by GSDReader::readLocalParticles()
+struct GSDParticleRow
+    {
+    unsigned int tag;               //!< Particle tag
+    unsigned int type;              //!< Type id
+    float mass;                     //!< Mass
+    float charge;                   //!< Charge
+    float diameter;                 //!< Diameter
+    unsigned int body;              //!< Body id
+    vec3<float> inertia;            //!< Moment of inertia
+    vec3<float> pos;                //!< Position, wrapped into the box
+    quat<float> orientation;        //!< Orientation
+    vec3<float> vel;                //!< Velocity
+    quat<float> angmom;             //!< Angular momentum
+    int3 image;                     //!< Image
+    };
+
+//! A bonded group sent to the ranks that own its members by GSDReader::readLocalGroups()
+template<class members_t>
+struct GSDGroupRow
+    {
+    unsigned int tag;               //!< Group tag
+    members_t members;              //!< Member tags
+    unsigned int type;              //!< Type id of groups with a type mapping
+    float value;                    //!< Value of groups without a type mapping (constraints)
+    };
+#endif
+
 /*! \param exec_conf The execution configuration
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Open the file on all ranks and defer reading the particles to readLocalParticles()
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
     memory (on the root rank).
+
+    When \a distributed is true, every rank opens the file and reads the frame header. No particles or topology
+    are read until readLocalParticles() is called with the domain decomposition.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(distributed), m_nglobal(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -78,7 +168,8 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     // validate schema
-    if (string(m_handle.header.schema) != string("hoomd"))
+    if (string(m_handle.header.schema) != string("hoomd")
+        && string(m_handle.header.schema) != string(hoomd::detail::GSD_ENCODED_SCHEMA))
         {
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid schema in " << name << endl;
         throw runtime_error("Error opening GSD file");
@@ -102,6 +193,9 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
+    if (m_distributed)
+        return;
+
     readParticles();
     readTopology();
     }
@@ -110,7 +204,7 @@ GSDReader::~GSDReader()
     {
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -135,9 +229,11 @@ GSDReader::~GSDReader()
 */
 bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n)
     {
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
-    if (entry == NULL && frame != 0)
-        entry = gsd_find_chunk(&m_handle, 0, name);
+    bool encoded = false;
+    const struct gsd_index_entry* entry = findChunk(frame, name, encoded);
+
+    if (encoded)
+        return readEncodedChunk(data, entry, name, expected_size, cur_n);
 
     if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
         {
@@ -154,32 +250,120 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
             throw runtime_error("Error reading GSD file");
             }
         int retval = gsd_read_chunk(&m_handle, data, entry);
+        checkReadError(retval);
 
-        if (retval == -1)
-            {
-            m_exec_conf->msg->error() << "data.gsd_snapshot: " << strerror(errno) << " - " << m_name << endl;
-            throw runtime_error("Error reading GSD file");
-            }
-        else if (retval == -2)
-            {
-            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unknown error reading: " << m_name << endl;
-            throw runtime_error("Error reading GSD file");
-            }
-        else if (retval == -3)
-            {
-            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid GSD file " << m_name << endl;
-            throw runtime_error("Error reading GSD file");
-            }
-        else if (retval != 0)
+        return true;
+        }
+    }
+
+/*! \param frame Frame index to look in
+    \param name Name of the data chunk
+    \param encoded Set to true if the returned chunk is the encoded form of \a name
+
+    Looks for the encoded chunk (see GSDChunkEncoding.h) and then the plain chunk at the given frame, and then for
+    both at frame 0.
+
+    \returns The index entry of the chunk, or NULL if it is not found
+*/
+const struct gsd_index_entry* GSDReader::findChunk(uint64_t frame, const char *name, bool& encoded)
+    {
+    const std::string encoded_name = hoomd::detail::encodedChunkName(name);
+
+    const struct gsd_index_entry* entry = NULL;
+    for (uint64_t f : {frame, uint64_t(0)})
+        {
+        entry = gsd_find_chunk(&m_handle, f, encoded_name.c_str());
+        if (entry != NULL)
             {
-            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unknown error reading: " << m_name << endl;
-            throw runtime_error("Error reading GSD file");
+            encoded = true;
+            return entry;
             }
 
-        return true;
+        entry = gsd_find_chunk(&m_handle, f, name);
+        if (entry != NULL || f == 0)
+            break;
+        }
+
+    encoded = false;
+    return entry;
+    }
+
+/*! \param retval Return value of gsd_read_chunk()
+
+    Raises an exception when \a retval indicates an error.
+*/
+void GSDReader::checkReadError(int retval)
+    {
+    if (retval == -1)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << strerror(errno) << " - " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    else if (retval == -2)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unknown error reading: " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    else if (retval == -3)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid GSD file " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    else if (retval != 0)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unknown error reading: " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
         }
     }
 
+/*! \param data Pointer to write data to
+    \param entry Index entry of the encoded chunk
+    \param name Name of the chunk
+    \param expected_size Expected size of the decoded data in bytes
+    \param cur_n N in the current frame, or 0 to skip the check
+
+    Reads a chunk stored with one of the encodings in GSDChunkEncoding.h and decodes it to \a data. Decoded
+    orientations are normalized.
+
+    \returns true if the chunk was read, false if its size does not match \a cur_n
+*/
+bool GSDReader::readEncodedChunk(void *data,
+                                 const struct gsd_index_entry* entry,
+                                 const char *name,
+                                 size_t expected_size,
+                                 unsigned int cur_n)
+    {
+    std::vector<char> encoded(entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type));
+    int retval = gsd_read_chunk(&m_handle, encoded.data(), entry);
+    checkReadError(retval);
+
+    hoomd::detail::EncodedChunkHeader header;
+    if (!hoomd::detail::readEncodedChunkHeader(header, encoded))
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unsupported encoding of " << name << " in " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    if (cur_n != 0 && header.N != cur_n)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading encoded chunk " << name << endl;
+    size_t actual_size = header.N * header.M * gsd_sizeof_type((enum gsd_type)header.type);
+    if (actual_size != expected_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    hoomd::detail::decodeChunk(data, encoded);
+    if (std::string(name) == "particles/orientation")
+        hoomd::detail::normalizeQuaternions((float *)data, header.N);
+    return true;
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -264,7 +448,11 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_nglobal = N;
+
+    // in distributed mode, the snapshot holds only the local particles
+    if (!m_distributed)
+        m_snapshot->particle_data.resize(N);
     }
 
 /*! Read the same data chunks for particles
@@ -289,6 +477,433 @@ void GSDReader::readParticles()
     readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
     }
 
+/*! \param decomposition The domain decomposition of the simulation
+
+    With a domain decomposition, each rank reads about N / n_ranks consecutive rows of every per-particle chunk
+    (see getFirstRow()), wraps the positions into the box and finds the ranks that own its particles. A single
+    all-to-all exchange then sends every particle to its owner. Without a domain decomposition, the rank reads all
+    particles. The bonded groups are read and distributed the same way by readLocalGroups().
+
+    After this call, the snapshot is a local snapshot and getLocalTags() returns the tags of its particles and
+    bonded groups.
+*/
+void GSDReader::readLocalParticles(std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    if (!m_distributed)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "GSDReader was not opened in distributed mode" << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    SnapshotParticleData<float>& pdata = m_snapshot->particle_data;
+    pdata.type_mapping = readTypes(m_frame, "particles/types");
+
+    std::vector<unsigned int>& local_tags = m_local_tags.particles.tags;
+    m_local_tags.particles.nglobal = m_nglobal;
+
+    // rows read by this rank
+    uint64_t first = 0;
+    uint64_t n = m_nglobal;
+    #ifdef ENABLE_MPI
+    unsigned int my_rank = m_exec_conf->getRank();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    if (decomposition)
+        {
+        first = getFirstRow(m_nglobal, my_rank, n_ranks);
+        n = getFirstRow(m_nglobal, my_rank + 1, n_ranks) - first;
+        }
+    #endif
+
+    // the snapshot already has default values, if a chunk is not found, the value
+    // is already at the default, and the failed read is not a problem
+    pdata.resize(n);
+    readChunkRows(pdata.type.data(), "particles/typeid", m_nglobal, 4, first, n);
+    readChunkRows(pdata.mass.data(), "particles/mass", m_nglobal, 4, first, n);
+    readChunkRows(pdata.charge.data(), "particles/charge", m_nglobal, 4, first, n);
+    readChunkRows(pdata.diameter.data(), "particles/diameter", m_nglobal, 4, first, n);
+    readChunkRows(pdata.body.data(), "particles/body", m_nglobal, 4, first, n);
+    readChunkRows(pdata.inertia.data(), "particles/moment_inertia", m_nglobal, 12, first, n);
+    readChunkRows(pdata.pos.data(), "particles/position", m_nglobal, 12, first, n);
+    readChunkRows(pdata.orientation.data(), "particles/orientation", m_nglobal, 16, first, n);
+    readChunkRows(pdata.vel.data(), "particles/velocity", m_nglobal, 12, first, n);
+    readChunkRows(pdata.angmom.data(), "particles/angmom", m_nglobal, 16, first, n);
+    readChunkRows(pdata.image.data(), "particles/image", m_nglobal, 12, first, n);
+
+    local_tags.resize(n);
+    for (unsigned int i = 0; i < n; i++)
+        local_tags[i] = first + i;
+
+    // owner of every row read by this rank
+    std::vector<unsigned int> row_owner;
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        const BoxDim& global_box = m_snapshot->global_box;
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        row_owner.resize(n);
+        unsigned int n_out_of_bounds = 0;
+        std::vector< std::vector<GSDParticleRow> > send(n_ranks);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Scalar3 pos = vec_to_scalar3(pdata.pos[i]);
+            int3 img = pdata.image[i];
+            unsigned int rank = decomposition->wrapAndPlaceParticle(global_box, pos, img, h_cart_ranks.data);
+
+            if (rank >= n_ranks)
+                {
+                Scalar3 f = global_box.makeFraction(pos);
+                m_exec_conf->msg->error() << "init.*: Particle " << first + i << " out of bounds." << std::endl;
+                m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+                m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+                m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+                m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+                n_out_of_bounds++;
+                continue;
+                }
+
+            row_owner[i] = rank;
+
+            GSDParticleRow row;
+            row.tag = first + i;
+            row.type = pdata.type[i];
+            row.mass = pdata.mass[i];
+            row.charge = pdata.charge[i];
+            row.diameter = pdata.diameter[i];
+            row.body = pdata.body[i];
+            row.inertia = pdata.inertia[i];
+            row.pos = vec3<float>(pos);
+            row.orientation = pdata.orientation[i];
+            row.vel = pdata.vel[i];
+            row.angmom = pdata.angmom[i];
+            row.image = img;
+            send[rank].push_back(row);
+            }
+
+        // only the ranks that read the offending rows know about them, raise the error on all ranks together
+        MPI_Allreduce(MPI_IN_PLACE, &n_out_of_bounds, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        if (n_out_of_bounds > 0)
+            throw std::runtime_error("Error initializing from snapshot.");
+
+        std::vector<GSDParticleRow> recv;
+        exchangeRows(send, recv, m_exec_conf->getMPICommunicator());
+
+        // the ranks read consecutive rows in rank order, so the received tags are in ascending order
+        pdata.resize(recv.size());
+        local_tags.resize(recv.size());
+        for (unsigned int i = 0; i < recv.size(); i++)
+            {
+            const GSDParticleRow& row = recv[i];
+            local_tags[i] = row.tag;
+            pdata.type[i] = row.type;
+            pdata.mass[i] = row.mass;
+            pdata.charge[i] = row.charge;
+            pdata.diameter[i] = row.diameter;
+            pdata.body[i] = row.body;
+            pdata.inertia[i] = row.inertia;
+            pdata.pos[i] = row.pos;
+            pdata.orientation[i] = row.orientation;
+            pdata.vel[i] = row.vel;
+            pdata.angmom[i] = row.angmom;
+            pdata.image[i] = row.image;
+            }
+        }
+    #endif
+
+    m_exec_conf->msg->notice(5) << "data.gsd_snapshot: reading " << local_tags.size() << " of " << m_nglobal
+                                << " particles on rank " << m_exec_conf->getRank() << endl;
+
+    readLocalGroups(m_snapshot->bond_data, m_local_tags.bonds, "bonds", true, decomposition, row_owner);
+    readLocalGroups(m_snapshot->angle_data, m_local_tags.angles, "angles", true, decomposition, row_owner);
+    readLocalGroups(m_snapshot->dihedral_data, m_local_tags.dihedrals, "dihedrals", true, decomposition, row_owner);
+    readLocalGroups(m_snapshot->improper_data, m_local_tags.impropers, "impropers", true, decomposition, row_owner);
+    readLocalGroups(m_snapshot->constraint_data,
+                    m_local_tags.constraints,
+                    "constraints",
+                    false,
+                    decomposition,
+                    row_owner);
+    if (m_handle.header.schema_version >= gsd_make_version(1,1))
+        readLocalGroups(m_snapshot->pair_data, m_local_tags.pairs, "pairs", true, decomposition, row_owner);
+    }
+
+/*! \param snapshot Snapshot of the bonded groups to fill out
+    \param tags Output: tags of the groups in \a snapshot
+    \param name Name of the group data in the file (e.g. "bonds")
+    \param has_type_mapping True if the groups have types, false if they have values (constraints)
+    \param decomposition The domain decomposition of the simulation
+    \param row_owner Owner of each particle row read by this rank in readLocalParticles()
+
+    With a domain decomposition, each rank reads about N / n_ranks consecutive group rows. Only the rank that read
+    the row of a particle knows its owner, so every group is first sent to the ranks that read the rows of its
+    members, which forward it to the owners of those members. Each exchange is a single all-to-all. Without a domain
+    decomposition, the rank has all particles and reads all groups.
+*/
+template <class Snapshot>
+void GSDReader::readLocalGroups(Snapshot& snapshot,
+                                LocalTags& tags,
+                                const std::string& name,
+                                bool has_type_mapping,
+                                std::shared_ptr<DomainDecomposition> decomposition,
+                                const std::vector<unsigned int>& row_owner)
+    {
+    typedef typename decltype(Snapshot::groups)::value_type members_t;
+    const unsigned int group_size = sizeof(members_t) / sizeof(unsigned int);
+
+    unsigned int N = 0;
+    readChunk(&N, m_frame, (name + "/N").c_str(), 4);
+    tags.nglobal = N;
+    tags.tags.clear();
+    snapshot.resize(0);
+    if (N == 0)
+        return;
+
+    if (has_type_mapping)
+        snapshot.type_mapping = readTypes(m_frame, (name + "/types").c_str());
+
+    // rows read by this rank
+    uint64_t first = 0;
+    uint64_t n = N;
+    #ifdef ENABLE_MPI
+    unsigned int my_rank = m_exec_conf->getRank();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    if (decomposition)
+        {
+        first = getFirstRow(N, my_rank, n_ranks);
+        n = getFirstRow(N, my_rank + 1, n_ranks) - first;
+        }
+    #endif
+
+    std::string value_name = name + (has_type_mapping ? "/typeid" : "/value");
+    members_t zero;
+    memset(&zero, 0, sizeof(zero));
+    std::vector<members_t> groups(n, zero);
+    std::vector<unsigned int> type_ids(n, 0);
+    std::vector<float> values(n, 0.0f);
+    readChunkRows(groups.data(), (name + "/group").c_str(), N, sizeof(members_t), first, n);
+    readChunkRows(has_type_mapping ? (void *)type_ids.data() : (void *)values.data(),
+                  value_name.c_str(), N, 4, first, n);
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        typedef GSDGroupRow<members_t> row_t;
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+        // send every group once to each rank that read the row of one of its members
+        std::vector< std::vector<row_t> > send(n_ranks);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            row_t row;
+            row.tag = first + i;
+            row.members = groups[i];
+            row.type = type_ids[i];
+            row.value = values[i];
+
+            std::vector<unsigned int> dest;
+            for (unsigned int k = 0; k < group_size; k++)
+                {
+                // groups with invalid members are reported by BondedGroupData::initializeFromLocalSnapshot()
+                if (groups[i].tag[k] >= m_nglobal)
+                    continue;
+                unsigned int rank = getRowRank(groups[i].tag[k], m_nglobal, n_ranks);
+                if (std::find(dest.begin(), dest.end(), rank) == dest.end())
+                    dest.push_back(rank);
+                }
+            for (unsigned int rank : dest)
+                send[rank].push_back(row);
+            }
+
+        std::vector<row_t> recv;
+        exchangeRows(send, recv, mpi_comm);
+
+        // forward the groups to the owners of the members whose rows this rank read
+        const uint64_t first_particle = getFirstRow(m_nglobal, my_rank, n_ranks);
+        for (unsigned int r = 0; r < n_ranks; r++)
+            send[r].clear();
+        for (const row_t& row : recv)
+            {
+            std::vector<unsigned int> dest;
+            for (unsigned int k = 0; k < group_size; k++)
+                {
+                unsigned int tag = row.members.tag[k];
+                if (tag >= m_nglobal || getRowRank(tag, m_nglobal, n_ranks) != my_rank)
+                    continue;
+                unsigned int owner = row_owner[tag - first_particle];
+                if (std::find(dest.begin(), dest.end(), owner) == dest.end())
+                    dest.push_back(owner);
+                }
+            for (unsigned int owner : dest)
+                send[owner].push_back(row);
+            }
+
+        exchangeRows(send, recv, mpi_comm);
+
+        // a group with members read by different ranks may arrive more than once
+        std::sort(recv.begin(), recv.end(), [](const row_t& a, const row_t& b) { return a.tag < b.tag; });
+        recv.erase(std::unique(recv.begin(), recv.end(), [](const row_t& a, const row_t& b) { return a.tag == b.tag; }),
+                   recv.end());
+
+        n = recv.size();
+        groups.resize(n);
+        type_ids.resize(n);
+        values.resize(n);
+        tags.tags.resize(n);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            tags.tags[i] = recv[i].tag;
+            groups[i] = recv[i].members;
+            type_ids[i] = recv[i].type;
+            values[i] = recv[i].value;
+            }
+        }
+    else
+    #endif
+        {
+        tags.tags.resize(n);
+        for (unsigned int i = 0; i < n; i++)
+            tags.tags[i] = first + i;
+        }
+
+    snapshot.groups = groups;
+    if (has_type_mapping)
+        snapshot.type_id = type_ids;
+    else
+        snapshot.val.assign(values.begin(), values.end());
+    snapshot.size = n;
+    }
+
+/*! \param data Pointer to write \a n_rows rows to
+    \param name Name of the data chunk
+    \param N Expected number of rows
+    \param row_size Size of one row in bytes
+    \param first_row First row to read
+    \param n_rows Number of rows to read
+
+    Finds the chunk with the same fallback to frame 0 as readChunk() and reads only the requested rows. Encoded
+    chunks are decoded with readEncodedRows().
+
+    \returns true if data is actually read from the file, false if the chunk does not exist or does not have \a N
+             rows
+*/
+bool GSDReader::readChunkRows(void *data,
+                              const char *name,
+                              uint64_t N,
+                              size_t row_size,
+                              uint64_t first_row,
+                              uint64_t n_rows)
+    {
+    bool encoded = false;
+    const struct gsd_index_entry* entry = findChunk(m_frame, name, encoded);
+
+    if (encoded)
+        return readEncodedRows(data, entry, name, N, row_size, first_row, n_rows);
+
+    if (entry == NULL || entry->N != N)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk " << name << endl;
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != N * row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << N * row_size << " bytes in " << name << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    if (n_rows == 0)
+        return true;
+
+    int retval = gsd_read_chunk_rows(&m_handle, data, entry, first_row, n_rows);
+    checkReadError(retval);
+    return true;
+    }
+
+/*! \param data Pointer to write \a n_rows decoded rows to
+    \param entry Index entry of the encoded chunk
+    \param name Name of the chunk
+    \param N Expected number of rows
+    \param row_size Size of one decoded row in bytes
+    \param first_row First row to read
+    \param n_rows Number of rows to read
+
+    Reads the header and column ranges at the start of the encoded chunk and then only the bytes that hold the
+    requested rows (see hoomd::detail::quantizedRowBytes()). Decoded orientations are normalized.
+
+    \returns true if the rows were read, false if the chunk does not have \a N rows
+*/
+bool GSDReader::readEncodedRows(void *data,
+                                const struct gsd_index_entry* entry,
+                                const char *name,
+                                uint64_t N,
+                                size_t row_size,
+                                uint64_t first_row,
+                                uint64_t n_rows)
+    {
+    // encoded chunks are byte arrays, so rows of the chunk are bytes
+    hoomd::detail::EncodedChunkHeader header;
+    bool valid = entry->type == GSD_TYPE_UINT8 && entry->M == 1 && entry->N >= sizeof(header);
+    if (valid)
+        {
+        int retval = gsd_read_chunk_rows(&m_handle, &header, entry, 0, sizeof(header));
+        checkReadError(retval);
+        valid = hoomd::detail::checkEncodedChunkHeader(header, entry->N);
+        }
+
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unsupported encoding of " << name << " in " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    if (header.N != N)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading encoded chunk " << name << endl;
+    size_t actual_size = header.N * header.M * gsd_sizeof_type((enum gsd_type)header.type);
+    if (actual_size != N * row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << N * row_size << " bytes in " << name << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    if (n_rows == 0)
+        return true;
+
+    // lowest values and range widths of the columns
+    std::vector<float> ranges(2 * header.M);
+    int retval = gsd_read_chunk_rows(&m_handle, ranges.data(), entry, sizeof(header), ranges.size() * sizeof(float));
+    checkReadError(retval);
+
+    uint64_t first_byte = 0;
+    uint64_t n_bytes = 0;
+    hoomd::detail::quantizedRowBytes(header, first_row, n_rows, first_byte, n_bytes);
+    std::vector<char> packed(n_bytes);
+    retval = gsd_read_chunk_rows(&m_handle,
+                                 packed.data(),
+                                 entry,
+                                 hoomd::detail::quantizedDataOffset(header.M) + first_byte,
+                                 n_bytes);
+    checkReadError(retval);
+
+    hoomd::detail::decodeQuantizedRows((float *)data,
+                                       header,
+                                       &ranges[0],
+                                       &ranges[header.M],
+                                       packed.data(),
+                                       first_row,
+                                       n_rows);
+    if (std::string(name) == "particles/orientation")
+        hoomd::detail::normalizeQuaternions((float *)data, n_rows);
+    return true;
+    }
+
 /*! Read the same data chunks for topology
 */
 void GSDReader::readTopology()
@@ -364,8 +979,11 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
+    .def("readLocalParticles", &GSDReader::readLocalParticles)
+    .def("getLocalTags", &GSDReader::getLocalTags, py::return_value_policy::reference_internal)
     ;
     }
@@ -13,6 +13,7 @@
 #endif
 
 #include "ParticleData.h"
+#include "SnapshotSystemData.h"
 #include <string>
 #include "hoomd/extern/gsd.h"
 
@@ -23,9 +24,6 @@
 #ifndef __GSD_INITIALIZER_H__
 #define __GSD_INITIALIZER_H__
 
-//! Forward declarations
-template <class Real> struct SnapshotSystemData;
-
 //! Reads a GSD input file
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
@@ -39,7 +37,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -73,6 +72,15 @@ class PYBIND11_EXPORT GSDReader
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
 
+        //! Read the particles in the local domain on every rank
+        void readLocalParticles(std::shared_ptr<DomainDecomposition> decomposition);
+
+        //! Get the global tags of the particles and bonded groups in the local snapshot
+        const LocalSnapshotTags& getLocalTags() const
+            {
+            return m_local_tags;
+            }
+
         //! clears the snapshot object
         void clearSnapshot()
             {
@@ -92,6 +100,48 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_distributed;                                          //!< True if all ranks read the file
+        unsigned int m_nglobal;                                      //!< Number of particles in the frame
+        LocalSnapshotTags m_local_tags;                              //!< Tags of the data read by this rank
+
+        //! Raise an exception if gsd_read_chunk() failed
+        void checkReadError(int retval);
+
+        //! Find a chunk at the given frame or frame 0, preferring its encoded form
+        const struct gsd_index_entry* findChunk(uint64_t frame, const char *name, bool& encoded);
+
+        //! Read and decode an encoded chunk
+        bool readEncodedChunk(void *data,
+                              const struct gsd_index_entry* entry,
+                              const char *name,
+                              size_t expected_size,
+                              unsigned int cur_n);
+
+        //! Read a range of rows of a chunk with N rows
+        bool readChunkRows(void *data,
+                           const char *name,
+                           uint64_t N,
+                           size_t row_size,
+                           uint64_t first_row,
+                           uint64_t n_rows);
+
+        //! Read and decode a range of rows of an encoded chunk
+        bool readEncodedRows(void *data,
+                             const struct gsd_index_entry* entry,
+                             const char *name,
+                             uint64_t N,
+                             size_t row_size,
+                             uint64_t first_row,
+                             uint64_t n_rows);
+
+        //! Read the bonded groups with members among the local particles
+        template <class Snapshot>
+        void readLocalGroups(Snapshot& snapshot,
+                             LocalTags& tags,
+                             const std::string& name,
+                             bool has_type_mapping,
+                             std::shared_ptr<DomainDecomposition> decomposition,
+                             const std::vector<unsigned int>& row_owner);
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
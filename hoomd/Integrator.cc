@@ -25,7 +25,8 @@ using namespace std;
 /*! \param sysdef System to update
     \param deltaT Time step to use
 */
-Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
+Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
+    : Updater(sysdef), m_deltaT(deltaT), m_compute_time(0.0)
     {
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
@@ -310,8 +311,29 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
 void Integrator::computeNetForce(unsigned int timestep)
     {
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    #ifdef ENABLE_MPI
+    if (m_comm && m_comm->isGhostUpdatePending())
+        {
+        // compute the forces that can overlap with the pending ghost update first
+        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+            if ((*force_compute)->canOverlapGhostUpdate())
+                (*force_compute)->compute(timestep);
+
+        // waiting for the ghost update is communication, exclude it from the measured compute time
+        int64_t wait_start = m_compute_clock.getTime();
+        m_comm->finishUpdateGhosts(timestep);
+        m_compute_time -= double(m_compute_clock.getTime() - wait_start) * 1e-9;
+
+        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+            if (! (*force_compute)->canOverlapGhostUpdate())
+                (*force_compute)->compute(timestep);
+        }
+    else
+    #endif
+        {
+        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+            (*force_compute)->compute(timestep);
+        }
 
     if (m_prof)
         {
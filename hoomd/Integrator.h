@@ -20,6 +20,7 @@
 #include "ForceConstraint.h"
 #include "HalfStepHook.h"
 #include "ParticleGroup.h"
+#include "ClockSource.h"
 #include <string>
 #include <vector>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -129,6 +130,22 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Get the wall clock time spent integrating and computing forces since the last reset (in seconds)
+        /*! Time spent in communication is not included, so that the value measures the work done on this rank.
+            Derived classes are responsible for accumulating the time. computeNetForce() subtracts the time it spends
+            waiting for a pending ghost update, so it must be called inside the measured interval.
+        */
+        double getComputeTime() const
+            {
+            return m_compute_time;
+            }
+
+        //! Reset the accumulated compute time
+        void resetComputeTime()
+            {
+            m_compute_time = 0.0;
+            }
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -147,6 +164,9 @@ class PYBIND11_EXPORT Integrator : public Updater
 
         std::shared_ptr<HalfStepHook> m_half_step_hook;    //!< The HalfStepHook, if active
 
+        ClockSource m_compute_clock;                                //!< Clock to measure the compute time
+        double m_compute_time;                                      //!< Accumulated compute time (in seconds)
+
 
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
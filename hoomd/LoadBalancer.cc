@@ -32,8 +32,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<DomainDecomposition> decomposition)
         : Updater(sysdef), m_decomposition(decomposition), m_mpi_comm(m_exec_conf->getMPICommunicator()),
           m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
-          m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-          m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
+          m_needs_recount(false), m_local_load(m_pdata->getN()), m_total_load(m_pdata->getNGlobal()),
+          m_rank_scale(Scalar(1.0)), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
+          m_load_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
           m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
@@ -63,8 +64,28 @@ void LoadBalancer::update(unsigned int timestep)
 
     if (m_prof) m_prof->push(m_exec_conf, "balance");
 
-    // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
-    resetNOwn(m_pdata->getN());
+    // scale the particle weights by the compute time measured since the last call
+    m_rank_scale = Scalar(1.0);
+    if (m_integrator)
+        {
+        computeLocalLoad();
+        Scalar time = m_integrator->getComputeTime();
+        m_integrator->resetComputeTime();
+
+        Scalar total_time(0.0);
+        MPI_Allreduce(&time, &total_time, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+
+        // if nothing has been measured yet, fall back to the particle weights
+        if (total_time > Scalar(0.0) && m_total_load > Scalar(0.0))
+            {
+            // a rank without particles gets the average scale, for the particles it might receive
+            m_rank_scale = (m_local_load > Scalar(0.0)) ? time / m_local_load : total_time / m_total_load;
+            }
+        }
+
+    // no adjustment has been made yet, so set the owned load to the load of the particles on the rank
+    computeLocalLoad();
+    resetLoadOwn(m_local_load);
 
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
@@ -112,10 +133,10 @@ void LoadBalancer::update(unsigned int timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> N_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
+            // reduce the load in the slice along dim
             bool active = reduce(N_i, dim, reduce_root);
 
             // attempt an adjustment
@@ -142,7 +163,10 @@ void LoadBalancer::update(unsigned int timestep)
             {
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
-            resetNOwn(m_pdata->getN());
+
+            // the particles received from other ranks now carry the weights of this rank
+            computeLocalLoad();
+            resetLoadOwn(m_local_load);
             m_needs_migrate = false;
 
             // increment the number of rebalances actually performed
@@ -154,13 +178,15 @@ void LoadBalancer::update(unsigned int timestep)
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * Computes the imbalance factor I = W / <W> of the load W for each rank, and computes the maximum among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar load_own = getLoadOwn();
+        Scalar cur_imb = (m_total_load > Scalar(0.0)) ?
+                         load_own / (m_total_load / Scalar(m_exec_conf->getNRanks())) : Scalar(1.0);
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -175,12 +201,12 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param N_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
  * \returns true if the current rank holds the active \a N_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a N_i holds the load in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for efficiency the data will
  *       be active only on Cartesian rank \a reduce_root, as indicated by the return value. As a result, only \a reduce_root
@@ -191,18 +217,18 @@ Scalar LoadBalancer::getMaxImbalance()
  * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
  * optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
     if (N_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> N_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load the current rank owns (the quantity to be reduced)
+    Scalar load_own = getLoadOwn();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&load_own, 1, MPI_HOOMD_SCALAR, &N_per_rank[0], 1, MPI_HOOMD_SCALAR, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -210,7 +236,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
     // rearrange the data from ranks to cartesian order in case it is jumbled around
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> N_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
         {
         N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
@@ -222,7 +248,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getW());
         for (unsigned int i=0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            N_i[i] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int j=0; j < di.getH(); ++j)
@@ -237,7 +263,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getH());
         for (unsigned int j=0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            N_i[j] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
@@ -252,7 +278,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getD());
         for (unsigned int k=0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            N_i[k] = Scalar(0.0);
             for (unsigned int j=0; j < di.getH(); ++j)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
@@ -273,7 +299,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param N_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -291,15 +317,17 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& N_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const Scalar target = m_total_load / Scalar(N_i.size());
+    if (target <= Scalar(0.0))
+        return false;
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -313,8 +341,8 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     vector<Scalar> new_widths(N_i.size());
     for (unsigned int i=0; i < N_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
-        Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
+        const Scalar imb_factor = N_i[i] / target;
+        Scalar scale_factor = (N_i[i] > Scalar(0.0)) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated systems
@@ -416,6 +444,75 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     return false;
     }
 
+/*!
+ * \param f Fractional coordinate of the particle in the local box
+ * \param cart_ranks Map from Cartesian index to rank
+ * \param rank Rank the particle has moved to (output)
+ * \returns true if the particle has left the local box
+ */
+bool LoadBalancer::getOffRank(const Scalar3& f, const unsigned int *cart_ranks, unsigned int& rank) const
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    const uint3 rank_pos = m_decomposition->getGridPos();
+
+    int3 grid_pos = make_int3(rank_pos.x, rank_pos.y, rank_pos.z);
+
+    bool moved(false);
+    if (f.x >= Scalar(1.0))
+        {
+        ++grid_pos.x;
+        moved = true;
+        }
+    if (f.x < Scalar(0.0))
+        {
+        --grid_pos.x;
+        moved = true;
+        }
+
+    if (f.y >= Scalar(1.0))
+        {
+        ++grid_pos.y;
+        moved = true;
+        }
+    if (f.y < Scalar(0.0))
+        {
+        --grid_pos.y;
+        moved = true;
+        }
+
+    if (f.z >= Scalar(1.0))
+        {
+        ++grid_pos.z;
+        moved = true;
+        }
+    if (f.z < Scalar(0.0))
+        {
+        --grid_pos.z;
+        moved = true;
+        }
+
+    if (moved)
+        {
+        if (grid_pos.x == (int)di.getW())
+            grid_pos.x = 0;
+        else if (grid_pos.x < 0)
+            grid_pos.x += di.getW();
+
+        if (grid_pos.y == (int)di.getH())
+            grid_pos.y = 0;
+        else if (grid_pos.y < 0)
+            grid_pos.y += di.getH();
+
+        if (grid_pos.z == (int)di.getD())
+            grid_pos.z = 0;
+        else if (grid_pos.z < 0)
+            grid_pos.z += di.getD();
+
+        rank = cart_ranks[di(grid_pos.x,grid_pos.y,grid_pos.z)];
+        }
+    return moved;
+    }
+
 /*!
  * \param cnts Map holding result of number of particles on each rank that neighbors the local rank
  */
@@ -425,8 +522,6 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
     ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
-    const Index3D& di = m_decomposition->getDomainIndexer();
-    const uint3 rank_pos = m_decomposition->getGridPos();
 
     for (unsigned int cur_p=0; cur_p < m_pdata->getN(); ++cur_p)
         {
@@ -434,69 +529,70 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
         const Scalar3 cur_pos = make_scalar3(cur_postype.x, cur_postype.y, cur_postype.z);
         const Scalar3 f = box.makeFraction(cur_pos);
 
-        int3 grid_pos = make_int3(rank_pos.x, rank_pos.y, rank_pos.z);
-
-        bool moved(false);
-        if (f.x >= Scalar(1.0))
+        unsigned int cur_rank;
+        if (getOffRank(f, h_cart_ranks.data, cur_rank))
             {
-            ++grid_pos.x;
-            moved = true;
-            }
-        if (f.x < Scalar(0.0))
-            {
-            --grid_pos.x;
-            moved = true;
+            cnts[cur_rank]++;
             }
+        }
+    }
 
-        if (f.y >= Scalar(1.0))
-            {
-            ++grid_pos.y;
-            moved = true;
-            }
-        if (f.y < Scalar(0.0))
-            {
-            --grid_pos.y;
-            moved = true;
-            }
+/*!
+ * \param weights Map holding result of the summed weight of the particles on each rank that neighbors the local rank
+ *
+ * The weights include the rank scale, so they are directly comparable to the local load.
+ */
+void LoadBalancer::sumWeightsOffRank(std::map<unsigned int, Scalar>& weights)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
-        if (f.z >= Scalar(1.0))
-            {
-            ++grid_pos.z;
-            moved = true;
-            }
-        if (f.z < Scalar(0.0))
+    const BoxDim& box = m_pdata->getBox();
+
+    for (unsigned int cur_p=0; cur_p < m_pdata->getN(); ++cur_p)
+        {
+        const Scalar4 cur_postype = h_pos.data[cur_p];
+        const Scalar3 cur_pos = make_scalar3(cur_postype.x, cur_postype.y, cur_postype.z);
+        const Scalar3 f = box.makeFraction(cur_pos);
+
+        unsigned int cur_rank;
+        if (getOffRank(f, h_cart_ranks.data, cur_rank))
             {
-            --grid_pos.z;
-            moved = true;
+            weights[cur_rank] += m_rank_scale * getTypeWeight(__scalar_as_int(cur_postype.w));
             }
+        }
+    }
 
-        if (moved)
+/*!
+ * Sums the weights of the particles owned by the rank into m_local_load, and the load of all ranks into m_total_load.
+ *
+ * \note All ranks must participate in this call since it involves a collective reduction.
+ */
+void LoadBalancer::computeLocalLoad()
+    {
+    if (m_type_weights.empty())
+        {
+        m_local_load = m_rank_scale * Scalar(m_pdata->getN());
+        }
+    else
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+        Scalar load(0.0);
+        for (unsigned int cur_p=0; cur_p < m_pdata->getN(); ++cur_p)
             {
-            if (grid_pos.x == (int)di.getW())
-                grid_pos.x = 0;
-            else if (grid_pos.x < 0)
-                grid_pos.x += di.getW();
-
-            if (grid_pos.y == (int)di.getH())
-                grid_pos.y = 0;
-            else if (grid_pos.y < 0)
-                grid_pos.y += di.getH();
-
-            if (grid_pos.z == (int)di.getD())
-                grid_pos.z = 0;
-            else if (grid_pos.z < 0)
-                grid_pos.z += di.getD();
-
-            unsigned int cur_rank = h_cart_ranks.data[di(grid_pos.x,grid_pos.y,grid_pos.z)];
-            cnts[cur_rank]++;
+            load += getTypeWeight(__scalar_as_int(h_pos.data[cur_p].w));
             }
+        m_local_load = m_rank_scale * load;
         }
+
+    MPI_Allreduce(&m_local_load, &m_total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
     }
 
 /*!
- * Each rank calls countParticlesOffRank() to count the number of particles to send to other ranks. Neighboring ranks
- * then perform send/receive calls, and count the new number of particles they own as the number they owned locally
- * plus the number received minus the number sent.
+ * Each rank calls countParticlesOffRank() (or sumWeightsOffRank() if the particle types have different weights) to
+ * determine the load to send to other ranks. Neighboring ranks then perform send/receive calls, and compute the new load
+ * they own as the load they owned locally plus the load received minus the load sent.
  *
  * \note All ranks must participate in this call since it involves send/receive operations between neighboring domains.
  */
@@ -509,39 +605,58 @@ void LoadBalancer::computeOwnedParticles()
     ArrayHandle<unsigned int> h_unique_neigh(m_comm->getUniqueNeighbors(), access_location::host, access_mode::read);
 
     // fill the map initially to zeros (not necessary since should be auto-initialized to zero, but just playing it safe)
-    std::map<unsigned int, unsigned int> cnts;
+    std::map<unsigned int, Scalar> weights;
     for (unsigned int i=0; i < m_comm->getNUniqueNeighbors(); ++i)
         {
-        cnts[h_unique_neigh.data[i]] = 0;
+        weights[h_unique_neigh.data[i]] = Scalar(0.0);
+        }
+
+    if (m_type_weights.empty())
+        {
+        // all particles on this rank weigh the same, so counting is enough
+        std::map<unsigned int, unsigned int> cnts;
+        for (unsigned int i=0; i < m_comm->getNUniqueNeighbors(); ++i)
+            {
+            cnts[h_unique_neigh.data[i]] = 0;
+            }
+        countParticlesOffRank(cnts);
+
+        for (auto it = cnts.begin(); it != cnts.end(); ++it)
+            {
+            weights[it->first] = m_rank_scale * Scalar(it->second);
+            }
+        }
+    else
+        {
+        sumWeightsOffRank(weights);
         }
-    countParticlesOffRank(cnts);
 
     MPI_Request req[2*m_comm->getNUniqueNeighbors()];
     MPI_Status stat[2*m_comm->getNUniqueNeighbors()];
     unsigned int nreq = 0;
 
-    unsigned int n_send_ptls[m_comm->getNUniqueNeighbors()];
-    unsigned int n_recv_ptls[m_comm->getNUniqueNeighbors()];
+    Scalar send_load[m_comm->getNUniqueNeighbors()];
+    Scalar recv_load[m_comm->getNUniqueNeighbors()];
     for (unsigned int cur_neigh=0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
-        n_send_ptls[cur_neigh] = cnts[neigh_rank];
+        send_load[cur_neigh] = weights[neigh_rank];
 
-        MPI_Isend(&n_send_ptls[cur_neigh], 1, MPI_UNSIGNED, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
-        MPI_Irecv(&n_recv_ptls[cur_neigh], 1, MPI_UNSIGNED, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
+        MPI_Isend(&send_load[cur_neigh], 1, MPI_HOOMD_SCALAR, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
+        MPI_Irecv(&recv_load[cur_neigh], 1, MPI_HOOMD_SCALAR, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
         }
     MPI_Waitall(nreq, req, stat);
 
-    // reduce the particles sent to me
-    int N_own = m_pdata->getN();
+    // reduce the load sent to me
+    Scalar load_own = m_local_load;
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
-        N_own += n_recv_ptls[cur_neigh];
-        N_own -= n_send_ptls[cur_neigh];
+        load_own += recv_load[cur_neigh];
+        load_own -= send_load[cur_neigh];
         }
 
-    // set the count
-    resetNOwn(N_own);
+    // set the load
+    resetLoadOwn(load_own);
     }
 
 /*!
@@ -578,6 +693,9 @@ void export_LoadBalancer(py::module& m)
     .def("setTolerance", &LoadBalancer::setTolerance)
     .def("getMaxIterations", &LoadBalancer::getMaxIterations)
     .def("setMaxIterations", &LoadBalancer::setMaxIterations)
+    .def("setTypeWeight", &LoadBalancer::setTypeWeight)
+    .def("getTypeWeight", &LoadBalancer::getTypeWeight)
+    .def("setIntegrator", &LoadBalancer::setIntegrator)
     ;
     }
 #endif // ENABLE_MPI
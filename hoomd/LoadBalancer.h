@@ -18,6 +18,7 @@
 #define __LOADBALANCER_H__
 
 #include "Updater.h"
+#include "Integrator.h"
 
 #include <memory>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -41,6 +42,13 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * When particles do not all cost the same, the number of particles is replaced by a load, which is the sum of the
+ * weights of the particles owned by a rank. A particle's weight is the product of a per-type weight (setTypeWeight())
+ * and, optionally, a per-rank scale set from the measured compute time of an Integrator (setIntegrator()). With timing
+ * enabled, the rank's accumulated compute time is distributed over its particles, so the load of a rank is its measured
+ * time and moving particles carry the cost they had on their old rank. All weights default to 1, in which case the
+ * load is the number of particles.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Updater
@@ -100,6 +108,43 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
                 }
             }
 
+        //! Set the weight of a particle type
+        /*!
+         * \param type Particle type
+         * \param weight Relative cost of a particle of type \a type
+         */
+        void setTypeWeight(unsigned int type, Scalar weight)
+            {
+            if (type >= m_pdata->getNTypes())
+                {
+                m_exec_conf->msg->error() << "comm.balance: invalid particle type specified" << std::endl;
+                throw std::runtime_error("Error setting type weight");
+                }
+            if (weight < Scalar(0.0))
+                {
+                m_exec_conf->msg->error() << "comm.balance: type weights must be non-negative" << std::endl;
+                throw std::runtime_error("Error setting type weight");
+                }
+            if (m_type_weights.size() < m_pdata->getNTypes())
+                m_type_weights.resize(m_pdata->getNTypes(), Scalar(1.0));
+            m_type_weights[type] = weight;
+            }
+
+        //! Get the weight of a particle type
+        Scalar getTypeWeight(unsigned int type) const
+            {
+            return (type < m_type_weights.size()) ? m_type_weights[type] : Scalar(1.0);
+            }
+
+        //! Set the integrator whose measured compute time is used as the load of each rank
+        /*!
+         * \param integrator Integrator to measure (nullptr to balance on the particle weights only)
+         */
+        void setIntegrator(std::shared_ptr<Integrator> integrator)
+            {
+            m_integrator = integrator;
+            }
+
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
@@ -119,8 +164,8 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+        //! Reduce the loads per rank down to one dimension
+        bool reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root);
 
         //! Set flags within the class that a resize has been performed
         void signalResize()
@@ -132,36 +177,51 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& N_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
 
-        //! Compute the number of particles on each rank after an adjustment
+        //! Compute the load on each rank after an adjustment
         void computeOwnedParticles();
 
         //! Count the number of particles that have gone off the rank
         virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts);
 
-        //! Gets the number of owned particles, updating if necessary
-        unsigned int getNOwn()
+        //! Sum the weights of the particles that have gone off the rank
+        void sumWeightsOffRank(std::map<unsigned int, Scalar>& weights);
+
+        //! Find the rank a particle has moved to
+        bool getOffRank(const Scalar3& f, const unsigned int *cart_ranks, unsigned int& rank) const;
+
+        //! Gets the load owned by this rank, updating if necessary
+        Scalar getLoadOwn()
             {
             computeOwnedParticles();
-            return m_N_own;
+            return m_load_own;
             }
 
-        //! Force a reset of the number of owned particles without counting
+        //! Force a reset of the owned load without counting
         /*!
-         * \param N number of particles owned by the rank
+         * \param load load owned by the rank
          */
-        void resetNOwn(unsigned int N)
+        void resetLoadOwn(Scalar load)
             {
-            m_N_own = N;
+            m_load_own = load;
             m_recompute_max_imbalance = true;
             m_needs_recount = false;
             }
         bool m_needs_recount;   //!< Flag if a particle change needs to be computed
 
+        //! Compute the load of the particles currently on the rank, and the total load
+        void computeLocalLoad();
+        Scalar m_local_load;    //!< Load of the particles currently owned by the rank
+        Scalar m_total_load;    //!< Load summed over all ranks
+
+        std::vector<Scalar> m_type_weights;         //!< Weight per particle type (empty if all weights are 1)
+        std::shared_ptr<Integrator> m_integrator;   //!< Integrator to measure the compute time of (may be null)
+        Scalar m_rank_scale;                        //!< Weight of a particle on this rank relative to its type weight
+
         Scalar m_tolerance;     //!< Load imbalance to tolerate
         unsigned int m_maxiter; //!< Maximum number of iterations to attempt
         bool m_enable_x;        //!< Flag to enable balancing in x
@@ -171,7 +231,7 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         const Scalar m_max_scale;   //!< Maximum fraction to rescale either direction (5%)
 
     private:
-        unsigned int m_N_own;               //!< Number of particles owned by this rank
+        Scalar m_load_own;                  //!< Load owned by this rank
 
         Scalar m_max_max_imbalance;     //!< The maximum imbalance of any check
         double m_total_max_imbalance;   //!< The average imbalance over checks
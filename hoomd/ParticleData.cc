@@ -27,6 +27,7 @@
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <cfloat>
 
 using namespace std;
 
@@ -905,11 +906,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
             unsigned int n_ranks = m_exec_conf->getNRanks();
 
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
                 {
@@ -923,45 +921,12 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
+                unsigned int rank = m_decomposition->wrapAndPlaceParticle(m_global_box, pos, img, h_cart_ranks.data);
 
                 if (rank >= n_ranks)
                     {
+                    Scalar3 f = m_global_box.makeFraction(pos);
                     m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
                     m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
                     m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
@@ -1193,6 +1158,169 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+/*! \param snapshot Snapshot of the particles in the local domain, on every rank
+    \param tags Global tag of every particle in \a snapshot
+    \param nglobal Global number of particles
+
+    Every rank passes the particles it owns, so no particle data is sent between ranks. The tags of all ranks
+    together must be 0 to nglobal-1, and each particle must be inside the domain of the rank that passes it (as
+    determined by DomainDecomposition::wrapAndPlaceParticle()). The type mapping must be the same on all ranks.
+    Tags out of range, tags repeated on a rank, and a total number of particles on all ranks other than nglobal are
+    errors on all ranks.
+
+    Without a domain decomposition, \a snapshot must hold all particles in tag order and this is equivalent to
+    initializeFromSnapshot().
+*/
+template <class Real>
+void ParticleData::initializeFromLocalSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                               const std::vector<unsigned int>& tags,
+                                               unsigned int nglobal)
+    {
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        m_exec_conf->msg->notice(4) << "ParticleData: initializing from local snapshots" << std::endl;
+
+        // remove all ghost particles
+        removeAllGhostParticles();
+
+        if (! snapshot.validate() || tags.size() != snapshot.size)
+            {
+            m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                    << std::endl << std::endl;
+            throw std::runtime_error("Error initializing particle data.");
+            }
+
+        if (snapshot.type_mapping.size() == 0)
+            {
+            m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+            throw std::runtime_error("Error initializing ParticleData");
+            }
+
+        // check that the local tags are valid, and that the ranks together hold every particle once
+        unsigned int n_invalid = 0;
+            {
+            std::vector<bool> seen(nglobal, false);
+            for (unsigned int idx = 0; idx < tags.size(); idx++)
+                {
+                if (tags[idx] >= nglobal || seen[tags[idx]])
+                    n_invalid++;
+                else
+                    seen[tags[idx]] = true;
+                }
+            }
+
+        unsigned int counts[2] = {(unsigned int)tags.size(), n_invalid};
+        MPI_Allreduce(MPI_IN_PLACE, counts, 2, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+
+        if (counts[1] != 0)
+            {
+            m_exec_conf->msg->error() << "init.*: " << counts[1] << " particle tags are out of range or duplicated."
+                                      << std::endl;
+            throw std::runtime_error("Error initializing ParticleData");
+            }
+
+        if (counts[0] != nglobal)
+            {
+            m_exec_conf->msg->error() << "init.*: The ranks hold " << counts[0] << " particles, expected "
+                                      << nglobal << "." << std::endl;
+            throw std::runtime_error("Error initializing ParticleData");
+            }
+
+        // clear set of active tags
+        m_tag_set.clear();
+
+        // clear reservoir of recycled tags
+        while (! m_recycled_tags.empty())
+            m_recycled_tags.pop();
+
+        m_type_mapping = snapshot.type_mapping;
+
+        // resize array for reverse-lookup tags
+        m_rtag.resize(nglobal);
+
+            {
+            // reset all reverse lookup tags to NOT_LOCAL flag
+            ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+            for (unsigned int tag = 0; tag < nglobal; tag++)
+                h_rtag.data[tag] = NOT_LOCAL;
+            }
+
+        // update list of active tags
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            {
+            m_tag_set.insert(tag);
+            }
+
+        // Now that active tag list has changed, invalidate the cache
+        m_invalid_cached_tags = true;
+
+        // resize particle data
+        m_nparticles = snapshot.size;
+        resize(m_nparticles);
+
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            h_pos.data[idx] = make_scalar4(snapshot.pos[idx].x,
+                                           snapshot.pos[idx].y,
+                                           snapshot.pos[idx].z,
+                                           __int_as_scalar(snapshot.type[idx]));
+            h_vel.data[idx] = make_scalar4(snapshot.vel[idx].x,
+                                           snapshot.vel[idx].y,
+                                           snapshot.vel[idx].z,
+                                           snapshot.mass[idx]);
+            h_accel.data[idx] = vec_to_scalar3(snapshot.accel[idx]);
+            h_charge.data[idx] = snapshot.charge[idx];
+            h_diameter.data[idx] = snapshot.diameter[idx];
+            h_image.data[idx] = snapshot.image[idx];
+            h_tag.data[idx] = tags[idx];
+            h_rtag.data[tags[idx]] = idx;
+            h_body.data[idx] = snapshot.body[idx];
+            h_orientation.data[idx] = quat_to_scalar4(snapshot.orientation[idx]);
+            h_angmom.data[idx] = quat_to_scalar4(snapshot.angmom[idx]);
+            h_inertia.data[idx] = vec_to_scalar3(snapshot.inertia[idx]);
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+    else
+#endif
+        {
+        initializeFromSnapshot(snapshot);
+        return;
+        }
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -2477,6 +2605,9 @@ template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
+template void ParticleData::initializeFromLocalSnapshot<double>(const SnapshotParticleData<double> & snapshot,
+                                                                const std::vector<unsigned int>& tags,
+                                                                unsigned int nglobal);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
 
 
@@ -2486,6 +2617,9 @@ template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+template void ParticleData::initializeFromLocalSnapshot<float>(const SnapshotParticleData<float> & snapshot,
+                                                               const std::vector<unsigned int>& tags,
+                                                               unsigned int nglobal);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
 
@@ -3212,6 +3346,45 @@ unsigned int ParticleData::addType(const std::string& type_name)
     return m_type_mapping.size() - 1;
     }
 
+/*! \param f Fractional coordinates of the particle in the old box (unwrapped)
+    \param l Index of the replica along x
+    \param m Index of the replica along y
+    \param n Index of the replica along z
+    \param nx Number of replicas along x
+    \param ny Number of replicas along y
+    \param nz Number of replicas along z
+    \param new_box Dimensions of replicated box
+    \param pos Output: position of the replica in the new box
+    \param img Output: image of the replica in the new box
+*/
+template <class Real>
+static void replicaPosition(const vec3<Real>& f,
+                            unsigned int l, unsigned int m, unsigned int n,
+                            unsigned int nx, unsigned int ny, unsigned int nz,
+                            const BoxDim& new_box,
+                            vec3<Real>& pos,
+                            int3& img)
+    {
+    Scalar3 f_new;
+    // replicate particle
+    f_new.x = f.x/(Real)nx + (Real)l/(Real)nx;
+    f_new.y = f.y/(Real)ny + (Real)m/(Real)ny;
+    f_new.z = f.z/(Real)nz + (Real)n/(Real)nz;
+
+    // coordinates in new box
+    Scalar3 q = new_box.makeCoordinates(f_new);
+
+    // wrap by multiple box vectors if necessary
+    img = new_box.getImage(q);
+    int3 negimg = make_int3(-img.x, -img.y, -img.z);
+    q = new_box.shift(q, negimg);
+
+    // rewrap using wrap so that rounding is consistent
+    new_box.wrap(q,img);
+
+    pos = vec3<Real>(q);
+    }
+
 template <class Real>
 void SnapshotParticleData<Real>::replicate(unsigned int nx, unsigned int ny, unsigned int nz,
         const BoxDim& old_box, const BoxDim& new_box)
@@ -3236,26 +3409,9 @@ void SnapshotParticleData<Real>::replicate(unsigned int nx, unsigned int ny, uns
             for (unsigned int m = 0; m < ny; m++)
                 for (unsigned int n = 0; n < nz; n++)
                     {
-                    Scalar3 f_new;
-                    // replicate particle
-                    f_new.x = f.x/(Real)nx + (Real)l/(Real)nx;
-                    f_new.y = f.y/(Real)ny + (Real)m/(Real)ny;
-                    f_new.z = f.z/(Real)nz + (Real)n/(Real)nz;
-
                     unsigned int k = j*old_size + i;
 
-                    // coordinates in new box
-                    Scalar3 q = new_box.makeCoordinates(f_new);
-
-                    // wrap by multiple box vectors if necessary
-                    image[k] = new_box.getImage(q);
-                    int3 negimg = make_int3(-image[k].x, -image[k].y, -image[k].z);
-                    q = new_box.shift(q, negimg);
-
-                    // rewrap using wrap so that rounding is consistent
-                    new_box.wrap(q,image[k]);
-
-                    pos[k] = vec3<Real>(q);
+                    replicaPosition(f, l, m, n, nx, ny, nz, new_box, pos[k], image[k]);
                     vel[k] = vel[i];
                     accel[k] = accel[i];
                     type[k] = type[i];
@@ -3278,6 +3434,125 @@ void SnapshotParticleData<Real>::replicate(unsigned int nx, unsigned int ny, uns
         }
     }
 
+#ifdef ENABLE_MPI
+/*! The snapshot must be the same on all ranks. Only the replicas that overlap the local domain are generated, and
+    each replicated particle is kept when DomainDecomposition::wrapAndPlaceParticle() places it on this rank.
+    Particle k of replica j has the tag j*old_size + k, as in replicate().
+*/
+template <class Real>
+void SnapshotParticleData<Real>::replicate_local(unsigned int nx, unsigned int ny, unsigned int nz,
+        const BoxDim& old_box, const BoxDim& new_box,
+        std::shared_ptr<DomainDecomposition> decomposition,
+        std::vector<unsigned int>& tags,
+        std::vector<unsigned int>& replicas)
+    {
+    unsigned int old_size = size;
+
+    // unwrapped fractional coordinates of the particles in the old box, and their range
+    std::vector< vec3<Real> > f(old_size);
+    Scalar3 f_lo = make_scalar3(FLT_MAX, FLT_MAX, FLT_MAX);
+    Scalar3 f_hi = make_scalar3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (unsigned int i = 0; i < old_size; ++i)
+        {
+        vec3<Real> p = vec3<Real>(old_box.shift(vec3<Scalar>(pos[i]), image[i]));
+        f[i] = old_box.makeFraction(p);
+        f_lo = make_scalar3(std::min(f_lo.x, Scalar(f[i].x)), std::min(f_lo.y, Scalar(f[i].y)), std::min(f_lo.z, Scalar(f[i].z)));
+        f_hi = make_scalar3(std::max(f_hi.x, Scalar(f[i].x)), std::max(f_hi.y, Scalar(f[i].y)), std::max(f_hi.z, Scalar(f[i].z)));
+        }
+
+    // find the replicas along each direction that may overlap the local domain, also across the periodic boundary
+    const unsigned int n_rep[3] = {nx, ny, nz};
+    const Scalar rep_lo[3] = {f_lo.x, f_lo.y, f_lo.z};
+    const Scalar rep_hi[3] = {f_hi.x, f_hi.y, f_hi.z};
+    const unsigned int grid_pos[3] = {decomposition->getGridPos().x,
+                                      decomposition->getGridPos().y,
+                                      decomposition->getGridPos().z};
+    const Scalar tol(1e-4);
+    std::vector<unsigned int> candidates[3];
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        {
+        Scalar dom_lo = decomposition->getCumulativeFraction(dir, grid_pos[dir]) - tol;
+        Scalar dom_hi = decomposition->getCumulativeFraction(dir, grid_pos[dir]+1) + tol;
+        for (unsigned int l = 0; l < n_rep[dir]; ++l)
+            {
+            Scalar lo = (rep_lo[dir] + Scalar(l)) / Scalar(n_rep[dir]);
+            Scalar hi = (rep_hi[dir] + Scalar(l)) / Scalar(n_rep[dir]);
+            for (int shift = -1; shift <= 1; ++shift)
+                if (lo + shift <= dom_hi && hi + shift >= dom_lo)
+                    {
+                    candidates[dir].push_back(l);
+                    break;
+                    }
+            }
+        }
+
+    std::vector<unsigned int> cart_ranks;
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+        cart_ranks.assign(h_cart_ranks.data, h_cart_ranks.data + decomposition->getCartRanks().getNumElements());
+        }
+    const Index3D& di = decomposition->getDomainIndexer();
+    unsigned int my_rank = cart_ranks[di(grid_pos[0], grid_pos[1], grid_pos[2])];
+
+    // keep the original particles to copy from
+    SnapshotParticleData<Real> cell(*this);
+
+    // place the replicated particles, in ascending tag order
+    std::vector< vec3<Real> > local_pos;
+    std::vector< int3 > local_image;
+    std::vector< unsigned int > local_src;
+    tags.clear();
+    replicas.clear();
+    for (unsigned int l : candidates[0])
+        for (unsigned int m : candidates[1])
+            for (unsigned int n : candidates[2])
+                {
+                unsigned int j = (l*ny + m)*nz + n;
+                bool has_local = false;
+                for (unsigned int i = 0; i < old_size; ++i)
+                    {
+                    vec3<Real> p;
+                    int3 img;
+                    replicaPosition(f[i], l, m, n, nx, ny, nz, new_box, p, img);
+
+                    // place the particle as ParticleData::initializeFromSnapshot() does
+                    Scalar3 q = vec_to_scalar3(p);
+                    if (decomposition->wrapAndPlaceParticle(new_box, q, img, &cart_ranks[0]) != my_rank)
+                        continue;
+
+                    tags.push_back(j*old_size + i);
+                    local_pos.push_back(vec3<Real>(q));
+                    local_image.push_back(img);
+                    local_src.push_back(i);
+                    has_local = true;
+                    }
+                if (has_local)
+                    replicas.push_back(j);
+                }
+
+    resize(tags.size());
+    for (unsigned int k = 0; k < size; ++k)
+        {
+        unsigned int i = local_src[k];
+        unsigned int j = tags[k] / old_size;
+        pos[k] = local_pos[k];
+        image[k] = local_image[k];
+        vel[k] = cell.vel[i];
+        accel[k] = cell.accel[i];
+        type[k] = cell.type[i];
+        mass[k] = cell.mass[i];
+        charge[k] = cell.charge[i];
+        diameter[k] = cell.diameter[i];
+        body[k] = (cell.body[i] != NO_BODY ? j*old_size + cell.body[i] : NO_BODY);
+        if (cell.body[i] < MIN_FLOPPY && body[k] >= MIN_FLOPPY)
+            throw std::runtime_error("Replication would create more distinct rigid bodies than HOOMD supports!");
+        orientation[k] = cell.orientation[i];
+        angmom[k] = cell.angmom[i];
+        inertia[k] = cell.inertia[i];
+        }
+    }
+#endif
+
 /*! \returns a numpy array that wraps the pos data element.
     The raw data is referenced by the numpy array, modifications to the numpy array will modify the snapshot
 */
@@ -191,6 +191,24 @@ struct PYBIND11_EXPORT SnapshotParticleData {
     void replicate(unsigned int nx, unsigned int ny, unsigned int nz,
         const BoxDim& old_box, const BoxDim& new_box);
 
+    #ifdef ENABLE_MPI
+    //! Replicate this snapshot and keep only the particles in the local domain
+    /*! \param nx Number of times to replicate the system along the x direction
+     *  \param ny Number of times to replicate the system along the y direction
+     *  \param nz Number of times to replicate the system along the z direction
+     *  \param old_box Old box dimensions
+     *  \param new_box Dimensions of replicated box
+     *  \param decomposition Domain decomposition of the replicated box
+     *  \param tags Output: global tags of the local particles, in ascending order
+     *  \param replicas Output: indices of the replicas that have local particles, in ascending order
+     */
+    void replicate_local(unsigned int nx, unsigned int ny, unsigned int nz,
+        const BoxDim& old_box, const BoxDim& new_box,
+        std::shared_ptr<DomainDecomposition> decomposition,
+        std::vector<unsigned int>& tags,
+        std::vector<unsigned int>& replicas);
+    #endif
+
     //! Get pos as a Python object
     static pybind11::object getPosNP(pybind11::object self);
     //! Get vel as a Python object
@@ -977,6 +995,12 @@ class PYBIND11_EXPORT ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        //! Initialize from a snapshot that holds only the particles of the local domain
+        template <class Real>
+        void initializeFromLocalSnapshot(const SnapshotParticleData<Real> & snapshot,
+                                         const std::vector<unsigned int>& tags,
+                                         unsigned int nglobal);
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
@@ -320,6 +320,17 @@ class PYBIND11_EXPORT ParticleGroup
             return m_member_idx;
             }
 
+        //! Direct access to the member tag list
+        /*! \returns A GlobalArray with the tags of all members of the group (on all ranks) in ascending order
+            \note The caller \b must \b not write to or change the array.
+        */
+        const GlobalArray<unsigned int>& getMemberTagArray() const
+            {
+            checkRebuild();
+
+            return m_member_tags;
+            }
+
         #ifdef ENABLE_CUDA
         //! Return the load balancing GPU partition
         const GPUPartition& getGPUPartition() const
@@ -18,13 +18,67 @@
 #include <fstream>
 #include <iostream>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
+//! First index of block \a b when \a n items are split into \a num_blocks contiguous blocks
+static inline unsigned int blockBegin(unsigned int b, unsigned int n, unsigned int num_blocks)
+    {
+    return (unsigned int)(((unsigned long long)n * b) / num_blocks);
+    }
+
+//! Call \a body(b) for each block index b < \a num_blocks, on multiple threads if available
+template<class Func>
+static void parallelForBlocks(unsigned int num_blocks, const Func& body)
+    {
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, num_blocks, body);
+    #else
+    for (unsigned int b = 0; b < num_blocks; b++)
+        body(b);
+    #endif
+    }
+
+//! Call \a body(begin, end) for each of \a num_blocks contiguous blocks of \a n items
+template<class Func>
+static void forEachBlock(unsigned int n, unsigned int num_blocks, const Func& body)
+    {
+    parallelForBlocks(num_blocks, [&](unsigned int b)
+        {
+        body(blockBegin(b, n, num_blocks), blockBegin(b+1, n, num_blocks));
+        });
+    }
+
+//! Reorder an array so that element i becomes the element at \a order[i]
+/*! \param data Array to reorder
+    \param tmp Scratch space of at least \a n elements
+    \param order Sort order
+    \param n Number of elements
+    \param num_blocks Number of blocks to split the work into
+*/
+template<class T>
+static void applyPermutation(T *data, T *tmp, const unsigned int *order, unsigned int n, unsigned int num_blocks)
+    {
+    forEachBlock(n, num_blocks, [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int i = begin; i < end; i++)
+            tmp[i] = data[order[i]];
+        });
+    forEachBlock(n, num_blocks, [&](unsigned int begin, unsigned int end)
+        {
+        std::copy(tmp + begin, tmp + end, data + begin);
+        });
+    }
+
 /*! \param sysdef System to perform sorts on
  */
 SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
-        : Updater(sysdef), m_last_grid(0), m_last_dim(0)
+        : Updater(sysdef), m_last_grid(0), m_last_dim(0), m_adaptive(false), m_adaptive_tolerance(Scalar(1.5)),
+          m_sorted_locality(Scalar(0.0))
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackUpdater" << endl;
 
@@ -33,6 +87,7 @@ SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
 
     m_sort_order.resize(m_pdata->getMaxN());
     m_particle_bins.resize(m_pdata->getMaxN());
+    m_particle_bins_alt.resize(m_pdata->getMaxN());
 
     // set the default grid
     // Grid dimension must always be a power of 2 and determines the memory usage for m_traversal_order
@@ -44,6 +99,9 @@ SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
 
     // register reallocate method with particle data maximum particle number change signal
     m_pdata->getMaxParticleNumberChangeSignal().connect<SFCPackUpdater, &SFCPackUpdater::reallocate>(this);
+
+    // the locality is measured relative to the last sort, which a box change invalidates
+    m_pdata->getBoxChangeSignal().connect<SFCPackUpdater, &SFCPackUpdater::slotBoxChanged>(this);
     }
 
 /*! reallocate the internal arrays
@@ -52,6 +110,7 @@ void SFCPackUpdater::reallocate()
     {
     m_sort_order.resize(m_pdata->getMaxN());
     m_particle_bins.resize(m_pdata->getMaxN());
+    m_particle_bins_alt.resize(m_pdata->getMaxN());
     }
 
 /*! Destructor
@@ -60,6 +119,7 @@ SFCPackUpdater::~SFCPackUpdater()
     {
     m_exec_conf->msg->notice(5) << "Destroying SFCPackUpdater" << endl;
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<SFCPackUpdater, &SFCPackUpdater::reallocate>(this);
+    m_pdata->getBoxChangeSignal().disconnect<SFCPackUpdater, &SFCPackUpdater::slotBoxChanged>(this);
     }
 
 /*! Performs the sort.
@@ -72,6 +132,17 @@ void SFCPackUpdater::update(unsigned int timestep)
     {
     m_exec_conf->msg->notice(6) << "SFCPackUpdater: particle sort" << std::endl;
 
+    // skip the sort while the particle order is still local enough
+    if (m_adaptive && m_sorted_locality > Scalar(0.0))
+        {
+        Scalar locality = computeLocality();
+        if (locality <= m_adaptive_tolerance*m_sorted_locality)
+            {
+            m_exec_conf->msg->notice(6) << "SFCPackUpdater: skipping sort, locality " << locality << std::endl;
+            return;
+            }
+        }
+
     #ifdef ENABLE_MPI
     if (m_comm)
         {
@@ -95,6 +166,10 @@ void SFCPackUpdater::update(unsigned int timestep)
     // apply that sort order to the particles
     applySortOrder();
 
+    // remember the locality of the sorted order
+    if (m_adaptive)
+        m_sorted_locality = computeLocality();
+
     // trigger sort signal (this also forces particle migration)
     m_pdata->notifyParticleSort();
 
@@ -125,52 +200,35 @@ void SFCPackUpdater::applySortOrder()
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
 
+    const unsigned int N = m_pdata->getN();
+    const unsigned int num_blocks = getNumBlocks();
+    const unsigned int *order = &m_sort_order[0];
+
     // construct a temporary holding array for the sorted data
-    Scalar4 *scal4_tmp = new Scalar4[m_pdata->getN()];
+    Scalar4 *scal4_tmp = new Scalar4[N];
 
     // sort positions and types
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_pos.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_pos.data[i] = scal4_tmp[i];
+    applyPermutation(h_pos.data, scal4_tmp, order, N, num_blocks);
 
     // sort velocities and mass
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_vel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_vel.data[i] = scal4_tmp[i];
+    applyPermutation(h_vel.data, scal4_tmp, order, N, num_blocks);
 
-    Scalar3 *scal3_tmp = new Scalar3[m_pdata->getN()];
+    Scalar3 *scal3_tmp = new Scalar3[N];
     // sort accelerations
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_accel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_accel.data[i] = scal3_tmp[i];
+    applyPermutation(h_accel.data, scal3_tmp, order, N, num_blocks);
 
-    Scalar *scal_tmp  = new Scalar[m_pdata->getN()];
+    Scalar *scal_tmp  = new Scalar[N];
     // sort charge
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_charge.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_charge.data[i] = scal_tmp[i];
+    applyPermutation(h_charge.data, scal_tmp, order, N, num_blocks);
 
     // sort diameter
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_diameter.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_diameter.data[i] = scal_tmp[i];
+    applyPermutation(h_diameter.data, scal_tmp, order, N, num_blocks);
 
     // sort angular momentum
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_angmom.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_angmom.data[i] = scal4_tmp[i];
+    applyPermutation(h_angmom.data, scal4_tmp, order, N, num_blocks);
 
     // sort moment of inertia
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_inertia.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_inertia.data[i] = scal3_tmp[i];
+    applyPermutation(h_inertia.data, scal3_tmp, order, N, num_blocks);
 
     // in case anyone access it from frame to frame, sort the net virial
         {
@@ -178,67 +236,42 @@ void SFCPackUpdater::applySortOrder()
         unsigned int virial_pitch = m_pdata->getNetVirial().getPitch();
 
         for (unsigned int j = 0; j < 6; j++)
-            {
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                scal_tmp[i] = h_net_virial.data[j*virial_pitch+m_sort_order[i]];
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                h_net_virial.data[j*virial_pitch+i] = scal_tmp[i];
-            }
+            applyPermutation(h_net_virial.data + j*virial_pitch, scal_tmp, order, N, num_blocks);
         }
 
     // sort net force, net torque, and orientation
         {
         ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_force.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_force.data[i] = scal4_tmp[i];
+        applyPermutation(h_net_force.data, scal4_tmp, order, N, num_blocks);
         }
 
         {
         ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_torque.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_torque.data[i] = scal4_tmp[i];
+        applyPermutation(h_net_torque.data, scal4_tmp, order, N, num_blocks);
         }
 
         {
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_orientation.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_orientation.data[i] = scal4_tmp[i];
+        applyPermutation(h_orientation.data, scal4_tmp, order, N, num_blocks);
         }
 
     // sort image
-    int3 *int3_tmp = new int3[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        int3_tmp[i] = h_image.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_image.data[i] = int3_tmp[i];
+    int3 *int3_tmp = new int3[N];
+    applyPermutation(h_image.data, int3_tmp, order, N, num_blocks);
 
     // sort body
-    unsigned int *uint_tmp = new unsigned int[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_body.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_body.data[i] = uint_tmp[i];
+    unsigned int *uint_tmp = new unsigned int[N];
+    applyPermutation(h_body.data, uint_tmp, order, N, num_blocks);
 
     // sort global tag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_tag.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_tag.data[i] = uint_tmp[i];
+    applyPermutation(h_tag.data, uint_tmp, order, N, num_blocks);
 
     // rebuild global rtag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    forEachBlock(N, num_blocks, [&](unsigned int begin, unsigned int end)
         {
-        h_rtag.data[h_tag.data[i]] = i;
-        }
+        for (unsigned int i = begin; i < end; i++)
+            h_rtag.data[h_tag.data[i]] = i;
+        });
 
     delete[] scal_tmp;
     delete[] scal4_tmp;
@@ -455,36 +488,36 @@ void SFCPackUpdater::getSortedOrder2D()
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
     // for each particle
-    for (unsigned int n = 0; n < m_pdata->getN(); n++)
+    forEachBlock(m_pdata->getN(), getNumBlocks(), [&](unsigned int begin, unsigned int end)
         {
-        // find the bin each particle belongs in
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        Scalar3 f = box.makeFraction(p,make_scalar3(0.0,0.0,0.0));
-        int ib = (unsigned int)(f.x * m_grid) % m_grid;
-        int jb = (unsigned int)(f.y * m_grid) % m_grid;
+        for (unsigned int n = begin; n < end; n++)
+            {
+            // find the bin each particle belongs in
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            Scalar3 f = box.makeFraction(p,make_scalar3(0.0,0.0,0.0));
+            int ib = (unsigned int)(f.x * m_grid) % m_grid;
+            int jb = (unsigned int)(f.y * m_grid) % m_grid;
 
-        // if the particle is slightly outside, move back into grid
-        if (ib < 0) ib = 0;
-        if (ib >= (int)m_grid) ib = m_grid - 1;
+            // if the particle is slightly outside, move back into grid
+            if (ib < 0) ib = 0;
+            if (ib >= (int)m_grid) ib = m_grid - 1;
 
-        if (jb < 0) jb = 0;
-        if (jb >= (int)m_grid) jb = m_grid - 1;
+            if (jb < 0) jb = 0;
+            if (jb >= (int)m_grid) jb = m_grid - 1;
 
-        // record its bin
-        unsigned int bin = ib*m_grid + jb;
+            // record its bin
+            unsigned int bin = ib*m_grid + jb;
 
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
-        }
+            m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
+            }
+        });
     }
 
     // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
-
-    // translate the sorted order
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
-        {
-        m_sort_order[j] = m_particle_bins[j].second;
-        }
+    unsigned int grid_bits = 0;
+    while ((1u << grid_bits) < m_grid)
+        grid_bits++;
+    sortParticleBins(2*grid_bits);
     }
 
 void SFCPackUpdater::getSortedOrder3D()
@@ -548,37 +581,165 @@ void SFCPackUpdater::getSortedOrder3D()
     ArrayHandle<unsigned int> h_traversal_order(m_traversal_order, access_location::host, access_mode::read);
 
     // for each particle
-    for (unsigned int n = 0; n < m_pdata->getN(); n++)
+    forEachBlock(m_pdata->getN(), getNumBlocks(), [&](unsigned int begin, unsigned int end)
         {
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        Scalar3 f = box.makeFraction(p,make_scalar3(0.0,0.0,0.0));
-        int ib = (unsigned int)(f.x * m_grid) % m_grid;
-        int jb = (unsigned int)(f.y * m_grid) % m_grid;
-        int kb = (unsigned int)(f.z * m_grid) % m_grid;
+        for (unsigned int n = begin; n < end; n++)
+            {
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            Scalar3 f = box.makeFraction(p,make_scalar3(0.0,0.0,0.0));
+            int ib = (unsigned int)(f.x * m_grid) % m_grid;
+            int jb = (unsigned int)(f.y * m_grid) % m_grid;
+            int kb = (unsigned int)(f.z * m_grid) % m_grid;
 
-        // if the particle is slightly outside, move back into grid
-        if (ib < 0) ib = 0;
-        if (ib >= (int)m_grid) ib = m_grid - 1;
+            // if the particle is slightly outside, move back into grid
+            if (ib < 0) ib = 0;
+            if (ib >= (int)m_grid) ib = m_grid - 1;
 
-        if (jb < 0) jb = 0;
-        if (jb >= (int)m_grid) jb = m_grid - 1;
+            if (jb < 0) jb = 0;
+            if (jb >= (int)m_grid) jb = m_grid - 1;
 
-        if (kb < 0) kb = 0;
-        if (kb >= (int)m_grid) kb = m_grid - 1;
+            if (kb < 0) kb = 0;
+            if (kb >= (int)m_grid) kb = m_grid - 1;
 
-        // record its bin
-        unsigned int bin = ib*(m_grid*m_grid) + jb * m_grid + kb;
+            // record its bin
+            unsigned int bin = ib*(m_grid*m_grid) + jb * m_grid + kb;
 
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
-        }
+            m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
+            }
+        });
 
     // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+    unsigned int grid_bits = 0;
+    while ((1u << grid_bits) < m_grid)
+        grid_bits++;
+    sortParticleBins(3*grid_bits);
+    }
+
+/*! \param key_bits Number of significant bits of the curve index
+
+    The binned particles are sorted with a least significant digit radix sort on 8 bit digits. Each pass counts the
+    digits in contiguous blocks of particles (one block per thread), computes the output offset of every digit in every
+    block, and scatters the blocks independently. The sort is stable, so particles in the same bin keep their order,
+    and the result is independent of the number of threads.
+
+    \post m_sort_order holds the sorted order of the particles
+*/
+void SFCPackUpdater::sortParticleBins(unsigned int key_bits)
+    {
+    const unsigned int radix_bits = 8;
+    const unsigned int radix = 1 << radix_bits;
+    const unsigned int N = m_pdata->getN();
+    const unsigned int num_blocks = getNumBlocks();
+
+    assert(m_particle_bins_alt.size() >= N);
+
+    std::pair<unsigned int, unsigned int> *src = &m_particle_bins[0];
+    std::pair<unsigned int, unsigned int> *dst = &m_particle_bins_alt[0];
+    std::vector<unsigned int> offset(num_blocks*radix);
+
+    for (unsigned int shift = 0; shift < key_bits; shift += radix_bits)
+        {
+        // count the digits in every block
+        parallelForBlocks(num_blocks, [&](unsigned int b)
+            {
+            unsigned int *count = &offset[b*radix];
+            std::fill(count, count + radix, 0);
+            for (unsigned int i = blockBegin(b, N, num_blocks); i < blockBegin(b+1, N, num_blocks); i++)
+                count[(src[i].first >> shift) & (radix-1)]++;
+            });
+
+        // exclusive scan over the digits, and over the blocks within a digit to keep the sort stable
+        unsigned int sum = 0;
+        for (unsigned int d = 0; d < radix; d++)
+            {
+            for (unsigned int b = 0; b < num_blocks; b++)
+                {
+                unsigned int count = offset[b*radix + d];
+                offset[b*radix + d] = sum;
+                sum += count;
+                }
+            }
+
+        // scatter every block to its output positions
+        parallelForBlocks(num_blocks, [&](unsigned int b)
+            {
+            unsigned int *pos = &offset[b*radix];
+            for (unsigned int i = blockBegin(b, N, num_blocks); i < blockBegin(b+1, N, num_blocks); i++)
+                dst[pos[(src[i].first >> shift) & (radix-1)]++] = src[i];
+            });
+
+        std::swap(src, dst);
+        }
 
     // translate the sorted order
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+    forEachBlock(N, num_blocks, [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int j = begin; j < end; j++)
+            m_sort_order[j] = src[j].second;
+        });
+    }
+
+/*! \returns The mean distance between particles adjacent in memory, divided by the mean interparticle spacing
+
+    The value is about one for a well sorted system, and grows as the particles diffuse away from their sorted
+    order. In MPI simulations, the mean is taken over all ranks.
+*/
+Scalar SFCPackUpdater::computeLocality()
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const unsigned int N = m_pdata->getN();
+    const bool twod = m_sysdef->getNDimensions() == 2;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    Scalar sum_dist(0.0);
+    for (unsigned int i = 1; i < N; i++)
+        {
+        Scalar3 dr = make_scalar3(h_pos.data[i].x - h_pos.data[i-1].x,
+                                  h_pos.data[i].y - h_pos.data[i-1].y,
+                                  h_pos.data[i].z - h_pos.data[i-1].z);
+        dr = global_box.minImage(dr);
+        sum_dist += sqrt(dot(dr, dr));
+        }
+    Scalar n_pairs = (N > 1) ? Scalar(N-1) : Scalar(0.0);
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &sum_dist, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &n_pairs, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (n_pairs == Scalar(0.0))
+        return Scalar(0.0);
+
+    Scalar spacing = pow(global_box.getVolume(twod) / Scalar(m_pdata->getNGlobal()), Scalar(1.0)/Scalar(twod ? 2 : 3));
+    return sum_dist / n_pairs / spacing;
+    }
+
+/*! \returns the list of provided log quantities
+*/
+std::vector< std::string > SFCPackUpdater::getProvidedLogQuantities()
+    {
+    std::vector< std::string > result;
+    result.push_back("sort_locality");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar SFCPackUpdater::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "sort_locality")
+        {
+        return computeLocality();
+        }
+    else
         {
-        m_sort_order[j] = m_particle_bins[j].second;
+        m_exec_conf->msg->error() << "sorter: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
         }
     }
 
@@ -617,5 +778,7 @@ void export_SFCPackUpdater(py::module& m)
     py::class_<SFCPackUpdater, std::shared_ptr<SFCPackUpdater> >(m,"SFCPackUpdater",py::base<Updater>())
     .def(py::init< std::shared_ptr<SystemDefinition> >())
     .def("setGrid", &SFCPackUpdater::setGrid)
+    .def("setAdaptive", &SFCPackUpdater::setAdaptive)
+    .def("computeLocality", &SFCPackUpdater::computeLocality)
     ;
     }
@@ -15,6 +15,7 @@
 #include "Updater.h"
 #include "GPUVector.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -42,7 +43,14 @@
     Implementation details:<br>
     The rearranging is done by computing bins for the particles, and then ordering the particles based on the order in
     which those bins appear along a hilbert curve. It is very efficient, even when the box size changes often as the
-    grid dimension is kept constant.
+    grid dimension is kept constant. The particles are ordered by a stable radix sort on the curve index, and the
+    permutation is applied to the particle data arrays, both split over the available threads in ENABLE_TBB builds.
+
+    The locality of the particle order is measured as the mean distance between particles that are adjacent in memory,
+    in units of the mean interparticle spacing (log quantity sort_locality). In adaptive mode, the sort is skipped while
+    the locality has not degraded by more than a tolerance factor from its value right after the last sort, so that
+    the period only sets how often the locality is checked. Changing the adaptive parameters, the grid or the box
+    forces a sort at the next check.
 
     \ingroup updaters
 */
@@ -65,12 +73,45 @@ class PYBIND11_EXPORT SFCPackUpdater : public Updater
         void setGrid(unsigned int grid)
             {
             m_grid = (unsigned int)pow(2.0, ceil(log(double(grid)) / log(2.0)));;
+
+            // the locality of the last sort no longer applies
+            m_sorted_locality = Scalar(0.0);
+            }
+
+        //! Set adaptive sorting
+        /*! \param enable If true, only sort when the locality has degraded
+            \param tolerance Sort when the locality exceeds \a tolerance times its value after the last sort
+        */
+        void setAdaptive(bool enable, Scalar tolerance)
+            {
+            if (tolerance < Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "sorter: tolerance must be at least 1.0" << std::endl;
+                throw std::runtime_error("Error setting sorter parameters");
+                }
+            m_adaptive = enable;
+            m_adaptive_tolerance = tolerance;
+
+            // sort on the next update to measure the locality of a sorted order
+            m_sorted_locality = Scalar(0.0);
             }
 
+        //! Compute the locality of the current particle order
+        Scalar computeLocality();
+
+        //! Returns a list of log quantities this updater calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
     protected:
         unsigned int m_grid;        //!< Grid dimension to use
         unsigned int m_last_grid;   //!< The last value of MMax
         unsigned int m_last_dim;    //!< Check the last dimension we ran at
+        bool m_adaptive;            //!< True if the sort is skipped while the locality is good
+        Scalar m_adaptive_tolerance;    //!< Factor by which the locality may degrade before sorting
+        Scalar m_sorted_locality;   //!< Locality right after the last sort
         GPUArray< unsigned int > m_traversal_order;      //!< Generated traversal order of bins
 
         //! Helper function that actually performs the sort
@@ -90,9 +131,25 @@ class PYBIND11_EXPORT SFCPackUpdater : public Updater
         //! Reallocate internal arrays
         virtual void reallocate();
 
+        //! Forget the locality of the last sort when the box changes
+        void slotBoxChanged()
+            {
+            m_sorted_locality = Scalar(0.0);
+            }
+
+        //! Get the number of blocks to split the work into
+        unsigned int getNumBlocks() const
+            {
+            return std::max(m_exec_conf->getNumThreads(), 1u);
+            }
+
     private:
         std::vector<unsigned int> m_sort_order;             //!< Generated sort order of the particles
         std::vector< std::pair<unsigned int, unsigned int> > m_particle_bins;    //!< Binned particles
+        std::vector< std::pair<unsigned int, unsigned int> > m_particle_bins_alt;    //!< Scratch space for the sort
+
+        //! Sort the binned particles by their curve index
+        void sortParticleBins(unsigned int key_bits);
 
    };
 
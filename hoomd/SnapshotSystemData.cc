@@ -21,11 +21,7 @@ void SnapshotSystemData<Real>::replicate(unsigned int nx, unsigned int ny, unsig
 
     // Update global box
     BoxDim old_box = global_box;
-    Scalar3 L = global_box.getL();
-    L.x *= (Scalar) nx;
-    L.y *= (Scalar) ny;
-    L.z *= (Scalar) nz;
-    global_box.setL(L);
+    global_box = replicated_box(nx, ny, nz);
 
     unsigned int old_n = particle_data.size;
     unsigned int n = nx * ny *nz;
@@ -47,6 +43,77 @@ void SnapshotSystemData<Real>::replicate(unsigned int nx, unsigned int ny, unsig
         pair_data.replicate(n,old_n);
     }
 
+template <class Real>
+BoxDim SnapshotSystemData<Real>::replicated_box(unsigned int nx, unsigned int ny, unsigned int nz) const
+    {
+    BoxDim new_box = global_box;
+    Scalar3 L = global_box.getL();
+    L.x *= (Scalar) nx;
+    L.y *= (Scalar) ny;
+    L.z *= (Scalar) nz;
+    new_box.setL(L);
+    return new_box;
+    }
+
+/*! Each rank generates only the replicas of the particles that fall into its own domain, and the replicas of the
+    bonded groups with at least one of these particles as a member. The particles are placed exactly as by
+    replicate() followed by ParticleData::initializeFromSnapshot().
+
+    Without a domain decomposition, this is equivalent to replicate() and all tags are local.
+*/
+template <class Real>
+LocalSnapshotTags SnapshotSystemData<Real>::replicate_local(unsigned int nx, unsigned int ny, unsigned int nz,
+                                                            std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    assert(nx > 0);
+    assert(ny > 0);
+    assert(nz > 0);
+
+    LocalSnapshotTags tags;
+    unsigned int old_n = particle_data.size;
+    unsigned int n = nx * ny * nz;
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        BoxDim old_box = global_box;
+        global_box = replicated_box(nx, ny, nz);
+
+        std::vector<unsigned int> replicas;
+        particle_data.replicate_local(nx, ny, nz, old_box, global_box, decomposition, tags.particles.tags, replicas);
+        tags.particles.nglobal = old_n * n;
+
+        // replicate the groups of the replicas that hold local particles
+        const std::vector<unsigned int>& ptags = tags.particles.tags;
+        tags.bonds.nglobal = bond_data.size * n;
+        bond_data.replicate_local(replicas, old_n, ptags, tags.bonds.tags);
+        tags.angles.nglobal = angle_data.size * n;
+        angle_data.replicate_local(replicas, old_n, ptags, tags.angles.tags);
+        tags.dihedrals.nglobal = dihedral_data.size * n;
+        dihedral_data.replicate_local(replicas, old_n, ptags, tags.dihedrals.tags);
+        tags.impropers.nglobal = improper_data.size * n;
+        improper_data.replicate_local(replicas, old_n, ptags, tags.impropers.tags);
+        tags.constraints.nglobal = constraint_data.size * n;
+        constraint_data.replicate_local(replicas, old_n, ptags, tags.constraints.tags);
+        tags.pairs.nglobal = pair_data.size * n;
+        pair_data.replicate_local(replicas, old_n, ptags, tags.pairs.tags);
+
+        return tags;
+        }
+    #endif
+
+    replicate(nx, ny, nz);
+
+    tags.particles.nglobal = particle_data.size;
+    tags.bonds.nglobal = bond_data.size;
+    tags.angles.nglobal = angle_data.size;
+    tags.dihedrals.nglobal = dihedral_data.size;
+    tags.impropers.nglobal = improper_data.size;
+    tags.constraints.nglobal = constraint_data.size;
+    tags.pairs.nglobal = pair_data.size;
+    return tags;
+    }
+
 template <class Real>
 void SnapshotSystemData<Real>::broadcast_box(std::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -133,6 +200,10 @@ template struct PYBIND11_EXPORT SnapshotSystemData<double>;
 
 void export_SnapshotSystemData(py::module& m)
     {
+    py::class_<LocalSnapshotTags, std::shared_ptr<LocalSnapshotTags> >(m,"LocalSnapshotTags")
+    .def(py::init<>())
+    ;
+
     py::class_<SnapshotSystemData<float>, std::shared_ptr< SnapshotSystemData<float> > >(m,"SnapshotSystemData_float")
     .def(py::init<>())
     .def_readwrite("_dimensions", &SnapshotSystemData<float>::dimensions)
@@ -155,6 +226,8 @@ void export_SnapshotSystemData(py::module& m)
     .def("_broadcast_box", &SnapshotSystemData<float>::broadcast_box)
     .def("_broadcast", &SnapshotSystemData<float>::broadcast)
     .def("_broadcast_all", &SnapshotSystemData<float>::broadcast_all)
+    .def("_replicated_box", &SnapshotSystemData<float>::replicated_box)
+    .def("_replicate_local", &SnapshotSystemData<float>::replicate_local)
     ;
 
     py::class_<SnapshotSystemData<double>, std::shared_ptr< SnapshotSystemData<double> > >(m,"SnapshotSystemData_double")
@@ -179,5 +252,7 @@ void export_SnapshotSystemData(py::module& m)
     .def("_broadcast_box", &SnapshotSystemData<double>::broadcast_box)
     .def("_broadcast", &SnapshotSystemData<double>::broadcast)
     .def("_broadcast_all", &SnapshotSystemData<double>::broadcast_all)
+    .def("_replicated_box", &SnapshotSystemData<double>::replicated_box)
+    .def("_replicate_local", &SnapshotSystemData<double>::replicate_local)
     ;
     }
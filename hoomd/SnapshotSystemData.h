@@ -27,6 +27,38 @@
 /*! \ingroup data_structs
 */
 
+//! Global tags of the particles or bonded groups of one kind in a local snapshot
+struct LocalTags
+    {
+    //! Constructor
+    LocalTags()
+        : nglobal(0)
+        {
+        }
+
+    std::vector<unsigned int> tags;        //!< Global tag of each element of the snapshot, in ascending order
+    unsigned int nglobal;                  //!< Global number of elements
+    };
+
+//! Global tags of the data in a local snapshot
+/*! A local snapshot holds only the particles in the domain of one rank, and the bonded groups with at least one
+ * member among them. Local snapshots are built on every rank (e.g. by GSDReader::readLocalParticles() or
+ * SnapshotSystemData::replicate_local()) and passed to SystemDefinition together with these tags, so that the
+ * system is initialized without gathering or scattering the full snapshot on the root rank.
+ *
+ * \ingroup data_structs
+ */
+struct LocalSnapshotTags
+    {
+    LocalTags particles;                   //!< Particle tags
+    LocalTags bonds;                       //!< Bond tags
+    LocalTags angles;                      //!< Angle tags
+    LocalTags dihedrals;                   //!< Dihedral tags
+    LocalTags impropers;                   //!< Improper tags
+    LocalTags constraints;                 //!< Constraint tags
+    LocalTags pairs;                       //!< Pair tags
+    };
+
 //! Structure for initializing system data
 /*! A snapshot is used for multiple purposes:
  * 1. for initializing the system
@@ -87,6 +119,25 @@ struct SnapshotSystemData {
      */
     void replicate(unsigned int nx, unsigned int ny, unsigned int nz);
 
+    // Get the box of the replicated system
+    /*! \param nx Number of times to replicate the system along the x direction
+     *  \param ny Number of times to replicate the system along the y direction
+     *  \param nz Number of times to replicate the system along the z direction
+     */
+    BoxDim replicated_box(unsigned int nx, unsigned int ny, unsigned int nz) const;
+
+    // Replicate the system and keep only the local domain
+    /*! \param nx Number of times to replicate the system along the x direction
+     *  \param ny Number of times to replicate the system along the y direction
+     *  \param nz Number of times to replicate the system along the z direction
+     *  \param decomposition Domain decomposition of the replicated box
+     *
+     *  The snapshot must be the same on all ranks. It is replaced by the local snapshot of the replicated system.
+     *  \returns The tags of the local particles and bonded groups
+     */
+    LocalSnapshotTags replicate_local(unsigned int nx, unsigned int ny, unsigned int nz,
+                                      std::shared_ptr<DomainDecomposition> decomposition);
+
     // Broadcast information from rank 0 to all ranks
     /*! \param exec_conf The execution configuration
         Broadcasts the box and other metadata. Large particle data arrays are left on rank 0.
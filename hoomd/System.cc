@@ -400,6 +400,16 @@ void System::setCommunicator(std::shared_ptr<Communicator> comm)
 
 // -------------- Methods for running the simulation
 
+/*! Called at the end of every run(), so that files written in the background are complete when control returns to
+    python.
+*/
+void System::flushAnalyzers()
+    {
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        analyzer->m_analyzer->flush();
+    }
+
 /*! \param nsteps Number of simulation steps to run
     \param limit_hours Number of hours to run for (0.0 => infinity)
     \param cb_frequency Modulus of timestep number when to call the callback (0 = at end)
@@ -483,7 +493,27 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         m_integrator->prepRun(m_cur_tstep);
         }
 
+    // background output is also completed when an exception ends the run, without masking that exception
+    struct FlushGuard
+        {
+        System& system;
+        bool active;
+        ~FlushGuard()
+            {
+            if (!active)
+                return;
+            try
+                {
+                system.flushAnalyzers();
+                }
+            catch (...)
+                {
+                }
+            }
+        } flush_guard = {*this, true};
+
     // handle time steps
+    bool interrupted = false;
     for ( ; m_cur_tstep < m_end_tstep; m_cur_tstep++)
         {
         // check the clock and output a status line if needed
@@ -609,10 +639,18 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         if (g_sigint_recvd)
             {
             g_sigint_recvd = 0;
-            return;
+            interrupted = true;
+            break;
             }
         }
 
+    // complete any output that is still being written in the background
+    flush_guard.active = false;
+    flushAnalyzers();
+
+    if (interrupted)
+        return;
+
     // generate a final status line
     generateStatusLine();
     m_last_status_tstep = m_cur_tstep;
@@ -439,6 +439,9 @@ class PYBIND11_EXPORT System
         //! Get the flags needed for a particular step
         PDataFlags determineFlags(unsigned int tstep);
 
+        //! Complete any output that analyzers are still writing in the background
+        void flushAnalyzers();
+
         // --------- Helper function for handling lists
         //! Search for an Analyzer by name
         std::vector<analyzer_item>::iterator findAnalyzerItem(const std::string &name);
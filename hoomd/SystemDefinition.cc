@@ -98,6 +98,53 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
     m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(snapshot->integrator_data));
     }
 
+/*! \param snapshot Local snapshot on every rank
+    \param tags Global tags of the particles and bonded groups in the snapshot
+    \param exec_conf Execution configuration to run on
+    \param decomposition The domain decomposition layout
+
+    Every rank must have the dimensions, box and type mappings in \a snapshot, along with its local particles
+    and the bonded groups that have local members (see LocalSnapshotTags). The data is initialized on each rank
+    without communicating the particles or groups.
+*/
+template <class Real>
+SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > snapshot,
+                                   const LocalSnapshotTags& tags,
+                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(0,
+                 snapshot->global_box,
+                 snapshot->particle_data.type_mapping.size(),
+                 exec_conf,
+                 decomposition));
+    m_particle_data->initializeFromLocalSnapshot(snapshot->particle_data, tags.particles.tags, tags.particles.nglobal);
+
+    setNDimensions(snapshot->dimensions);
+
+    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, 0));
+    m_bond_data->initializeFromLocalSnapshot(snapshot->bond_data, tags.bonds.tags, tags.bonds.nglobal);
+
+    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, 0));
+    m_angle_data->initializeFromLocalSnapshot(snapshot->angle_data, tags.angles.tags, tags.angles.nglobal);
+
+    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, 0));
+    m_dihedral_data->initializeFromLocalSnapshot(snapshot->dihedral_data, tags.dihedrals.tags, tags.dihedrals.nglobal);
+
+    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, 0));
+    m_improper_data->initializeFromLocalSnapshot(snapshot->improper_data, tags.impropers.tags, tags.impropers.nglobal);
+
+    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, 0));
+    m_constraint_data->initializeFromLocalSnapshot(snapshot->constraint_data,
+                                                   tags.constraints.tags,
+                                                   tags.constraints.nglobal);
+
+    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, 0));
+    m_pair_data->initializeFromLocalSnapshot(snapshot->pair_data, tags.pairs.tags, tags.pairs.nglobal);
+
+    m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(snapshot->integrator_data));
+    }
+
 /*! Sets the dimensionality of the system.  When quantities involving the dof of
     the system are computed, such as T, P, etc., the dimensionality is needed.
     Therefore, the dimensionality must be set before any temperature/pressure
@@ -276,6 +323,10 @@ template std::shared_ptr< SnapshotSystemData<float> > SystemDefinition::takeSnap
                                                                                               bool integrators,
                                                                                               bool pairs);
 template void SystemDefinition::initializeFromSnapshot<float>(std::shared_ptr< SnapshotSystemData<float> > snapshot);
+template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<float> > snapshot,
+                                            const LocalSnapshotTags& tags,
+                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                            std::shared_ptr<DomainDecomposition> decomposition);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<double> > snapshot,
                                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -289,6 +340,10 @@ template std::shared_ptr< SnapshotSystemData<double> > SystemDefinition::takeSna
                                                                                               bool integrators,
                                                                                               bool pairs);
 template void SystemDefinition::initializeFromSnapshot<double>(std::shared_ptr< SnapshotSystemData<double> > snapshot);
+template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<double> > snapshot,
+                                            const LocalSnapshotTags& tags,
+                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                            std::shared_ptr<DomainDecomposition> decomposition);
 
 void export_SystemDefinition(py::module& m)
     {
@@ -300,6 +355,8 @@ void export_SystemDefinition(py::module& m)
     .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, const LocalSnapshotTags&, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, const LocalSnapshotTags&, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def("setNDimensions", &SystemDefinition::setNDimensions)
     .def("getNDimensions", &SystemDefinition::getNDimensions)
     .def("getParticleData", &SystemDefinition::getParticleData)
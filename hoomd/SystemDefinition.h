@@ -32,6 +32,9 @@ class Communicator;
 //! Forward declaration of SnapshotSystemData
 template <class Real> struct SnapshotSystemData;
 
+//! Forward declaration of LocalSnapshotTags
+struct LocalSnapshotTags;
+
 //! Container class for all data needed to define the MD system
 /*! SystemDefinition is a big bucket where all of the data defining the MD system goes.
     Everything is stored as a shared pointer for quick and easy access from within C++
@@ -91,6 +94,13 @@ class PYBIND11_EXPORT SystemDefinition
                          std::shared_ptr<ExecutionConfiguration> exec_conf=std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration()),
                          std::shared_ptr<DomainDecomposition> decomposition=std::shared_ptr<DomainDecomposition>());
 
+        //! Construct from a snapshot that holds only the particles of the local domain
+        template <class Real>
+        SystemDefinition(std::shared_ptr<SnapshotSystemData<Real> > snapshot,
+                         const LocalSnapshotTags& tags,
+                         std::shared_ptr<ExecutionConfiguration> exec_conf,
+                         std::shared_ptr<DomainDecomposition> decomposition);
+
         //! Set the dimensionality of the system
         void setNDimensions(unsigned int);
 
@@ -82,6 +82,74 @@ def barrier():
     if _hoomd.is_MPI_available():
         hoomd.context.mpi_conf.barrier()
 
+def set_ghost_update_overlap(enable=True):
+    """ Overlap the ghost particle update with the pair force computation.
+
+    Args:
+        enable (bool): Set to True to enable the overlap, False to disable it
+
+    When enabled, the ghost positions that do not have to be forwarded between ranks are sent in all
+    directions at once, and pair potentials compute the forces on particles without ghost neighbors while
+    the messages are in flight. The forces on the remaining particles are computed after the update
+    has been completed. This hides part of the communication latency in strong scaling runs with few
+    particles per rank.
+
+    Note:
+        The overlap only applies to CPU simulations on steps without a neighbor list rebuild. Forces are
+        summed in a different order than without the overlap.
+
+    Note:
+        Does nothing in non-MPI builds or with a single rank.
+
+    Example::
+
+        comm.set_ghost_update_overlap(True)
+    """
+    hoomd.util.print_status_line()
+
+    # check that the system has been initialized
+    if hoomd.context.current.system is None:
+        hoomd.context.msg.error("comm.set_ghost_update_overlap: cannot set the overlap before the system is initialized\n")
+        raise RuntimeError("Error setting the ghost update overlap")
+
+    if _hoomd.is_MPI_available():
+        cpp_communicator = hoomd.context.current.system.getCommunicator()
+        if cpp_communicator is not None:
+            cpp_communicator.setGhostUpdateOverlap(enable)
+
+def set_persistent_ghost_update(enable=True):
+    """ Use persistent MPI requests for the ghost particle update.
+
+    Args:
+        enable (bool): Set to True to enable persistent requests, False to disable them
+
+    Between particle migrations, the ghost particles sent to each neighbor do not change. With persistent requests,
+    the messages of the ghost update are set up once and restarted on every time step, which reduces the per message
+    overhead in the MPI library. The requests are recreated automatically when the ghost lists change.
+
+    Note:
+        Only applies to CPU simulations. Persistent requests are ignored while the split ghost update is
+        enabled with :py:func:`set_ghost_update_overlap`.
+
+    Note:
+        Does nothing in non-MPI builds or with a single rank.
+
+    Example::
+
+        comm.set_persistent_ghost_update(True)
+    """
+    hoomd.util.print_status_line()
+
+    # check that the system has been initialized
+    if hoomd.context.current.system is None:
+        hoomd.context.msg.error("comm.set_persistent_ghost_update: cannot enable persistent requests before the system is initialized\n")
+        raise RuntimeError("Error setting persistent ghost update requests")
+
+    if _hoomd.is_MPI_available():
+        cpp_communicator = hoomd.context.current.system.getCommunicator()
+        if cpp_communicator is not None:
+            cpp_communicator.setPersistentGhostUpdate(enable)
+
 class decomposition(object):
     """ Set the domain decomposition.
 
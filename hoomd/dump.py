@@ -33,6 +33,7 @@ class dcd(hoomd.analyze._analyzer):
                some particles may be written just outside it. *unwrap_rigid* is ignored when *unwrap_full* is True.
         angle_z (bool): When True, the particle orientation angle is written to the z component (only useful for 2D simulations)
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        asynchronous (bool): When True, write frames to the file on a background thread. (added in version 2.7)
 
     Every *period* time steps a new simulation snapshot is written to the
     specified file in the DCD file format. DCD only stores particle positions, in distance
@@ -43,6 +44,10 @@ class dcd(hoomd.analyze._analyzer):
     nor can you change the period of the dump at any time. Either of these tasks
     can be performed by creating a new dump file with the needed settings.
 
+    With ``asynchronous=True``, each frame is copied to a staging buffer and written to the file on a background
+    thread while the simulation continues. The simulation only waits when the previous frame is still being
+    written. All frames are in the file when :py:func:`hoomd.run()` returns.
+
     Examples::
 
         dump.dcd(filename="trajectory.dcd", period=1000)
@@ -55,7 +60,7 @@ class dcd(hoomd.analyze._analyzer):
         * dump.dcd will not write out data at time steps that already are present in the dcd file to maintain a
           consistent timeline
     """
-    def __init__(self, filename, period, group=None, overwrite=False, unwrap_full=False, unwrap_rigid=False, angle_z=False, phase=0):
+    def __init__(self, filename, period, group=None, overwrite=False, unwrap_full=False, unwrap_rigid=False, angle_z=False, phase=0, asynchronous=False):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -77,6 +82,7 @@ class dcd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setUnwrapFull(unwrap_full);
         self.cpp_analyzer.setUnwrapRigid(unwrap_rigid);
         self.cpp_analyzer.setAngleZ(angle_z);
+        self.cpp_analyzer.setAsynchronous(asynchronous);
         self.setupAnalyzer(period, phase);
 
         # store metadata
@@ -504,6 +510,13 @@ class gsd(hoomd.analyze._analyzer):
         time_step (int): Time step to write to the file (only used when period is None)
         dynamic (list): A list of quantity categories to save every frame. (added in version 2.2)
         static (list): A list of quantity categories save only in frame 0 (may not be set in conjunction with *dynamic*, deprecated in version 2.2).
+        stream (bool): When True, write the per-particle data in blocks of rows directly from the local particle data
+                       instead of gathering a full snapshot on the root rank. (added in version 2.7)
+        asynchronous (bool): When True, write frames to the file on a background thread. (added in version 2.7)
+        quantize (int): When set, store positions, orientations, velocities, and angular momenta with this many bits
+                        per value (1 to 24) instead of as 32-bit floats. Requires *hoomd_only*. (added in version 2.7)
+        hoomd_only (bool): Set to True to confirm that a file written with *quantize* can only be read by HOOMD.
+                           (added in version 2.7)
 
     Write a simulation snapshot to the specified GSD file at regular intervals. GSD is capable of storing all particle
     and bond data fields in hoomd, in every frame of the trajectory. This allows GSD to store simulations where the
@@ -560,6 +573,37 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    Writing a frame normally gathers a snapshot of all particles on the root rank. With ``stream=True``, the
+    per-particle chunks are written one block of rows at a time: each rank sends its particles in the block to the
+    root rank, which writes the block to its place in the file. Memory use on the root rank then no longer grows
+    with the number of particles. The file contents are the same in both modes. Topology is always gathered.
+
+    With ``asynchronous=True``, the root rank copies each frame to a staging buffer and a background thread writes
+    it to the file while the simulation continues. The simulation only waits when the previous frame is still being
+    written. Objects passed to :py:meth:`dump_state` write to the file directly, so each frame then waits for the
+    previous one. All frames are in the file when :py:func:`hoomd.run()` returns. Staging holds the full frame on
+    the root rank, so ``asynchronous=True`` cannot be combined with ``stream=True``. A single frame written with
+    ``period=None`` is always written immediately.
+
+    .. rubric:: Quantization
+
+    Set *quantize* to reduce the size of long trajectories. Every column of ``particles/position``,
+    ``particles/orientation``, ``particles/velocity``, and ``particles/angmom`` is then stored as integers with
+    *quantize* bits that count fixed size steps from the lowest value of the column in that frame. The largest error
+    is half of one step: :math:`(x_{max} - x_{min}) / (2 (2^{quantize} - 1))`. With 16 bits in a box of length 100,
+    positions are stored to within 0.0008 distance units in half the space. All other quantities are stored exactly.
+    With ``asynchronous=True``, the quantization runs on the background thread.
+
+    The first frame of the file is always stored at full precision. In later frames, the quantized values are stored
+    in separate chunks named ``encoded/particles/position`` and so on, and the standard chunks are not written.
+    :py:func:`hoomd.data.gsd_snapshot()` and :py:func:`hoomd.init.read_gsd()` read the quantized chunks transparently
+    and normalize the decoded orientations. Other readers of the ``hoomd`` schema, such as ``gsd.hoomd``, would
+    return the values of the first frame instead. A quantized file therefore uses the ``hoomd_encoded`` schema, which
+    those readers refuse to open. Set ``hoomd_only=True`` to confirm that this is intended; *quantize* raises an
+    error without it. Quantized frames cannot be appended to an existing ``hoomd`` schema file.
+    With ``truncate=True``, every frame is the first and nothing is quantized, so the file keeps the ``hoomd``
+    schema. Quantization is not supported with ``stream=True``.
+
     .. rubric:: State data
 
     :py:class:`gsd` can save internal state data for the following hoomd objects:
@@ -584,6 +628,9 @@ class gsd(hoomd.analyze._analyzer):
         dump.gsd(filename="configuration.gsd", overwrite=True, period=None, group=group.all(), time_step=0)
         dump.gsd(filename="momentum_too.gsd", period=1000, group=group.all(), phase=0, dynamic=['momentum'])
         dump.gsd(filename="saveall.gsd", overwrite=True, period=1000, group=group.all(), dynamic=['attribute', 'momentum', 'topology'])
+        dump.gsd(filename="large.gsd", period=1000, group=group.all(), stream=True)
+        dump.gsd(filename="trajectory.gsd", period=100, group=group.all(), asynchronous=True)
+        dump.gsd(filename="long.gsd", period=100, group=group.all(), quantize=16, hoomd_only=True, asynchronous=True)
 
     """
     def __init__(self,
@@ -595,12 +642,25 @@ class gsd(hoomd.analyze._analyzer):
                  phase=0,
                  time_step=None,
                  static=None,
-                 dynamic=None):
+                 dynamic=None,
+                 stream=False,
+                 asynchronous=False,
+                 quantize=None,
+                 hoomd_only=False):
         hoomd.util.print_status_line();
 
         if static is not None and dynamic is not None:
             raise ValueError("Cannot specify both static and dynamic arguments");
 
+        if quantize is not None and stream:
+            raise ValueError("Cannot specify both quantize and stream arguments");
+
+        if quantize is not None and not hoomd_only:
+            raise ValueError("quantize writes a file that only HOOMD can read, set hoomd_only=True to confirm");
+
+        if asynchronous and stream:
+            raise ValueError("Cannot specify both asynchronous and stream arguments");
+
         categories = ['attribute', 'property', 'momentum', 'topology'];
         dynamic_quantities = ['property']
 
@@ -635,8 +695,12 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' in dynamic_quantities);
         self.cpp_analyzer.setWriteMomentum('momentum' in dynamic_quantities);
         self.cpp_analyzer.setWriteTopology('topology' in dynamic_quantities);
+        self.cpp_analyzer.setStreaming(stream);
+        if quantize is not None:
+            self.cpp_analyzer.setQuantizeBits(int(quantize));
 
         if period is not None:
+            self.cpp_analyzer.setAsynchronous(asynchronous);
             self.setupAnalyzer(period, phase);
         else:
             if time_step is None:
@@ -952,6 +952,203 @@ size_t gsd_sizeof_type(enum gsd_type type)
         return 0;
     }
 
+/*
+    HOOMD-blue extensions to GSD, not part of the upstream library. They write and read a chunk in pieces of rows, so
+    that per particle data can be streamed to and from the file through bounded buffers. Keep this section at the end
+    of the file when updating the vendored GSD sources.
+*/
+
+/*! \param handle Handle to an open GSD file
+    \param data Data buffer to read into
+    \param chunk Chunk to read
+    \param first_row First row of the chunk to read
+    \param n_rows Number of rows to read
+
+    \pre \a handle was opened by gsd_open() in read or readwrite mode.
+    \pre \a chunk was found by gsd_find_chunk().
+    \pre \a data points to an allocated buffer with at least `n_rows * M * gsd_sizeof_type(type)` bytes.
+
+    Reads rows \a first_row to \a first_row + \a n_rows - 1 of the chunk. When the file is memory mapped
+    (read only mode), the rows are copied out of the mapping and only the pages that hold them are loaded from disk.
+
+    \return 0 on success, -1 on a file IO failure - see errno for details, and -2 on invalid input
+*/
+int gsd_read_chunk_rows(struct gsd_handle* handle,
+                        void* data,
+                        const struct gsd_index_entry* chunk,
+                        uint64_t first_row,
+                        uint64_t n_rows)
+    {
+    if (handle == NULL)
+        return -2;
+    if (data == NULL)
+        return -2;
+    if (chunk == NULL)
+        return -2;
+    if (handle->open_flags == GSD_OPEN_APPEND)
+        return -2;
+    if (first_row + n_rows > chunk->N)
+        return -2;
+
+    size_t row_size = chunk->M * gsd_sizeof_type(chunk->type);
+    size_t size = n_rows * row_size;
+    if (row_size == 0)
+        return -3;
+    if (chunk->location == 0)
+        return -3;
+    if (size == 0)
+        return 0;
+
+    // validate that we don't read past the end of the file
+    int64_t location = chunk->location + first_row * row_size;
+    if ((chunk->location + chunk->N * row_size) > handle->file_size)
+        {
+        return -3;
+        }
+
+    if (handle->open_flags == GSD_OPEN_READONLY && handle->mapped_data != NULL)
+        {
+        memcpy(data, ((char *)handle->mapped_data) + location, size);
+        return 0;
+        }
+
+    size_t bytes_read = pread(handle->fd, data, size, location);
+    if (bytes_read != size)
+        {
+        return -1;
+        }
+
+    return 0;
+    }
+
+/*! \param handle Handle to an open GSD file
+    \param name Name of the data chunk (truncated to 63 chars)
+    \param type type ID that identifies the type of data in the chunk
+    \param N Number of rows in the chunk
+    \param M Number of columns in the chunk
+
+    \pre \a handle was opened by gsd_open().
+    \pre \a name is a unique name for data chunks in the given frame.
+
+    \post Space for `N * M * gsd_sizeof_type(type)` bytes is reserved at the end of the file and the chunk is added to
+    the in-memory index. The caller fills the chunk with gsd_write_chunk_rows() before starting the next chunk.
+
+    \return 0 on success, -1 on a file IO failure - see errno for details, and -2 on invalid input
+*/
+int gsd_begin_chunk(struct gsd_handle* handle,
+                    const char *name,
+                    enum gsd_type type,
+                    uint64_t N,
+                    uint32_t M)
+    {
+    // validate input
+    if (M == 0)
+        return -2;
+    if (handle->open_flags == GSD_OPEN_READONLY)
+        return -2;
+
+    // populate fields in the index_entry data
+    struct gsd_index_entry index_entry;
+    memset(&index_entry, 0, sizeof(index_entry));
+    index_entry.frame = handle->cur_frame;
+    index_entry.id = __gsd_get_id(handle, name, 1);
+    index_entry.type = (uint8_t)type;
+    index_entry.N = N;
+    index_entry.M = M;
+    size_t size = N * M * gsd_sizeof_type(type);
+
+    // need to expand the index if it is already full, this moves the index to the end of the file
+    if (handle->index_num_entries >= handle->header.index_allocated_entries)
+        {
+        int retval = __gsd_expand_index(handle);
+        if (retval != 0)
+            return -1;
+        }
+
+    // find the location at the end of the file for the chunk
+    index_entry.location = handle->file_size;
+
+    // reserve the space for the data so that later index expansions are placed after it
+    if (size > 0)
+        {
+        int retval = ftruncate(handle->fd, index_entry.location + size);
+        if (retval != 0)
+            return -1;
+        }
+    handle->file_size += size;
+
+    // once we get here, there is a free slot to add this entry to the index
+    size_t slot = handle->index_num_entries;
+
+    // in append mode, only unwritten entries are stored in memory
+    if (handle->open_flags == GSD_OPEN_APPEND)
+        {
+        slot -= handle->index_written_entries;
+        if (slot >= handle->append_index_size)
+            {
+            handle->append_index_size *= 2;
+            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
+            if (handle->index == NULL)
+                return -1;
+            }
+        }
+    handle->index[slot] = index_entry;
+    handle->index_num_entries++;
+
+    return 0;
+    }
+
+/*! \param handle Handle to an open GSD file
+    \param first_row First row of the chunk to write
+    \param n_rows Number of rows to write
+    \param data Data buffer
+
+    \pre gsd_begin_chunk() has been called since the last call to gsd_end_frame().
+    \pre data is allocated and contains at least `n_rows * M * gsd_sizeof_type(type)` bytes, where M and type are the
+    values passed to gsd_begin_chunk().
+
+    \post Rows \a first_row to `first_row + n_rows - 1` of the chunk most recently started by gsd_begin_chunk() are
+    written to the file.
+
+    Rows may be written in any order, but every row of the chunk must be written before gsd_end_frame() is called.
+
+    \return 0 on success, -1 on a file IO failure - see errno for details, and -2 on invalid input
+*/
+int gsd_write_chunk_rows(struct gsd_handle* handle,
+                         uint64_t first_row,
+                         uint64_t n_rows,
+                         const void *data)
+    {
+    // validate input
+    if (data == NULL)
+        return -2;
+    if (handle->open_flags == GSD_OPEN_READONLY)
+        return -2;
+    if (handle->index_num_entries <= handle->index_written_entries)
+        return -2;
+
+    // the chunk being written is the last entry in the in-memory index
+    size_t slot = handle->index_num_entries - 1;
+    if (handle->open_flags == GSD_OPEN_APPEND)
+        slot -= handle->index_written_entries;
+    const struct gsd_index_entry* index_entry = &handle->index[slot];
+
+    if (first_row + n_rows > index_entry->N)
+        return -2;
+
+    size_t row_size = index_entry->M * gsd_sizeof_type((enum gsd_type)index_entry->type);
+    size_t size = n_rows * row_size;
+    if (size == 0)
+        return 0;
+
+    // write the data
+    size_t bytes_written = pwrite(handle->fd, data, size, index_entry->location + first_row * row_size);
+    if (bytes_written != size)
+        return -1;
+
+    return 0;
+    }
+
 // undefine windows wrapper macros
 #ifdef _WIN32
 #undef lseek
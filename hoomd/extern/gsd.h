@@ -145,6 +145,28 @@ uint64_t gsd_get_nframes(struct gsd_handle* handle);
 //! Query size of a GSD type ID
 size_t gsd_sizeof_type(enum gsd_type type);
 
+// HOOMD-blue extensions, not part of the upstream library (see the end of gsd.c)
+
+//! Read rows of a chunk from the GSD file
+int gsd_read_chunk_rows(struct gsd_handle* handle,
+                        void* data,
+                        const struct gsd_index_entry* chunk,
+                        uint64_t first_row,
+                        uint64_t n_rows);
+
+//! Start a data chunk in the current frame that is written in pieces
+int gsd_begin_chunk(struct gsd_handle* handle,
+                    const char *name,
+                    enum gsd_type type,
+                    uint64_t N,
+                    uint32_t M);
+
+//! Write rows of the most recently started data chunk
+int gsd_write_chunk_rows(struct gsd_handle* handle,
+                         uint64_t first_row,
+                         uint64_t n_rows,
+                         const void *data);
+
 #ifdef __cplusplus
 }
 #endif
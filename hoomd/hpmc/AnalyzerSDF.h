@@ -22,6 +22,10 @@
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace hpmc
 {
 
@@ -78,6 +82,7 @@ bool test_scaled_overlap(const vec3<Scalar>& r_ij,
       - Suitably chosen navg results in the average being written out just before a restart - enabling full restart
         capabilities.
       - Fully uses the MPI domain decomposition to compute the SDF fast in large jobs.
+      - Processes the particles on multiple CPU threads in TBB builds.
 
     \b Storage <br>
 
@@ -95,6 +100,10 @@ bool test_scaled_overlap(const vec3<Scalar>& r_ij,
     the code is tested completely, final use cases may dictate a different format. For now, we need the full information
     for testing.
 
+    With the binary option, every frame is instead written as a sequence of doubles in native byte order: the
+    timestep followed by the normalized bin counts. The file can then be read with
+    `numpy.fromfile(filename).reshape(-1, nbins+1)` and has the same layout as the text file.
+
     \b Connection to an integrator <br>
 
     In MPI, the ghost layer width needs to be increased slightly. This is done by passing the MC integrator into the
@@ -117,7 +126,8 @@ class AnalyzerSDF : public Analyzer
                     double dl,
                     unsigned int navg,
                     const std::string& fname,
-                    bool overwrite);
+                    bool overwrite,
+                    bool binary);
 
         //! Destructor
         virtual ~AnalyzerSDF()
@@ -139,6 +149,7 @@ class AnalyzerSDF : public Analyzer
         std::ofstream m_file;                   //!< Output file
         bool m_is_initialized;                  //!< Bool indicating if we have initialized the file yet
         bool m_appending;                       //!< Flag indicating this file is being appended to
+        bool m_binary;                          //!< Flag indicating the file is written in binary format
         std::vector<unsigned int> m_hist;       //!< Raw histogram data
 
         unsigned int m_iavg;                    //!< Current count of the number of steps averaged
@@ -161,7 +172,7 @@ class AnalyzerSDF : public Analyzer
                        const quat<Scalar>& orientation_i,
                        const quat<Scalar>& orientation_j,
                        const typename Shape::param_type& params_i,
-                       const typename Shape::param_type& params_j);
+                       const typename Shape::param_type& params_j) const;
     };
 
 
@@ -172,6 +183,7 @@ class AnalyzerSDF : public Analyzer
     \param navg Number of samples to average before writing to the file
     \param fname File name to write to
     \param overwrite Set to true to overwrite instead of append to the file
+    \param binary Set to true to write the histograms in binary format
 
     Construct the SDF analyzer and initialize histogram memory to 0
 */
@@ -182,9 +194,10 @@ AnalyzerSDF<Shape>::AnalyzerSDF(std::shared_ptr<SystemDefinition> sysdef,
                                 double dl,
                                 unsigned int navg,
                                 const std::string& fname,
-                                bool overwrite)
+                                bool overwrite,
+                                bool binary)
     : Analyzer(sysdef), m_mc(mc), m_lmax(lmax), m_dl(dl), m_navg(navg), m_filename(fname), m_is_initialized(false),
-      m_appending(!overwrite), m_iavg(0)
+      m_appending(!overwrite), m_binary(binary), m_iavg(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing AnalyzerSDF: " << fname << " " << lmax << " " << dl << " " << navg << std::endl;
 
@@ -251,16 +264,18 @@ void AnalyzerSDF<Shape>::openOutputFile()
         if (! m_exec_conf->isRoot())
             return;
 #endif
+    std::ios_base::openmode mode = m_binary ? std::ios_base::binary : std::ios_base::openmode();
+
     // open the file
     if (filesystem::exists(m_filename) && m_appending)
         {
         m_exec_conf->msg->notice(3) << "analyze.sdf: Appending to existing data file \"" << m_filename << "\"" << std::endl;
-        m_file.open(m_filename.c_str(), std::ios_base::in | std::ios_base::out | std::ios_base::ate);
+        m_file.open(m_filename.c_str(), mode | std::ios_base::in | std::ios_base::out | std::ios_base::ate);
         }
     else
         {
         m_exec_conf->msg->notice(3) << "analyze.sdf: Creating new data file \"" << m_filename << "\"" << std::endl;
-        m_file.open(m_filename.c_str(), std::ios_base::out);
+        m_file.open(m_filename.c_str(), mode | std::ios_base::out);
         m_appending = false;
         }
 
@@ -292,14 +307,30 @@ void AnalyzerSDF<Shape>::writeOutput(unsigned int timestep)
         }
 #endif
 
-    // write out the normalized histogram bin values on one line
-    m_file << std::setprecision(16) << timestep << " ";
-    for (unsigned int i = 0; i < m_hist.size(); i++)
+    if (m_binary)
         {
-        m_file << double(hist_total[i]) / double(m_navg*m_pdata->getNGlobal()*m_dl) << " ";
+        // write out the timestep and the normalized histogram bin values as one record of doubles
+        std::vector<double> record(m_hist.size()+1);
+        record[0] = double(timestep);
+        for (unsigned int i = 0; i < m_hist.size(); i++)
+            {
+            record[i+1] = double(hist_total[i]) / double(m_navg*m_pdata->getNGlobal()*m_dl);
+            }
+
+        m_file.write((const char *)&record[0], record.size()*sizeof(double));
+        m_file.flush();
         }
+    else
+        {
+        // write out the normalized histogram bin values on one line
+        m_file << std::setprecision(16) << timestep << " ";
+        for (unsigned int i = 0; i < m_hist.size(); i++)
+            {
+            m_file << double(hist_total[i]) / double(m_navg*m_pdata->getNGlobal()*m_dl) << " ";
+            }
 
-    m_file << std::endl;
+        m_file << std::endl;
+        }
 
     // check that the file handle is still OK
     if (!m_file.good())
@@ -326,12 +357,15 @@ void AnalyzerSDF<Shape>::zeroHistogram()
     for averaging, and it operates without any communication
       - The integrator performs the ghost exchange (with the ghost width extra that we add)
       - Only on writeOutput() do we need to sum the per-rank histograms into a global histogram
+
+    In TBB builds, the particles are distributed over the threads. Every thread counts into its own histogram, and the
+    thread histograms are added to the total at the end, so the counts do not depend on the number of threads.
 */
 template < class Shape >
 void AnalyzerSDF<Shape>::countHistogram(unsigned int timestep)
     {
     // update the aabb tree
-    const detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
+    const detail::AABBTreeWide& aabb_tree = m_mc->buildAABBTree();
     // update the image list
     const std::vector<vec3<Scalar> >&image_list = m_mc->updateImageList();
 
@@ -343,8 +377,28 @@ void AnalyzerSDF<Shape>::countHistogram(unsigned int timestep)
 
     const std::vector<param_type, managed_allocator<param_type> > & params = m_mc->getParams();
 
+    #ifdef ENABLE_TBB
+    // per-thread histograms and leaf nodes of the AABB tree found by a query
+    tbb::enumerable_thread_specific< std::vector<unsigned int> > hist_tls(std::vector<unsigned int>(m_hist.size(), 0));
+    tbb::enumerable_thread_specific< std::vector<unsigned int> > hits_tls;
+
+    // loop through N particles
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        std::vector<unsigned int>& hist = hist_tls.local();
+        std::vector<unsigned int>& hits = hits_tls.local();
+
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
+    std::vector<unsigned int>& hist = m_hist;
+
+    // leaf nodes of the AABB tree found by a query
+    std::vector<unsigned int> hits;
+
     // loop through N particles
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #endif
         {
         int min_bin = m_hist.size();
 
@@ -365,53 +419,53 @@ void AnalyzerSDF<Shape>::countHistogram(unsigned int timestep)
             detail::AABB aabb = aabb_i_local;
             aabb.translate(pos_i_image);
 
-            // stackless search
-            for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes(); cur_node_idx++)
+            // find the leaf nodes of the tree that overlap
+            hits.clear();
+            aabb_tree.queryNodes(hits, aabb);
+            for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                 {
-                if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
-                    {
-                    if (aabb_tree.isNodeLeaf(cur_node_idx))
-                        {
-                        for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                            {
-                            // read in its position and orientation
-                            unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                            // skip i==j in the 0 image
-                            if (cur_image == 0 && i == j)
-                                continue;
-
-                            Scalar4 postype_j = h_postype.data[j];
-                            Scalar4 orientation_j = h_orientation.data[j];
-
-                            // put particles in coordinate system of particle i
-                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-
-
-                            int bin = computeBin(r_ij,
-                                                 quat<Scalar>(orientation_i),
-                                                 quat<Scalar>(orientation_j),
-                                                 params[__scalar_as_int(postype_i.w)],
-                                                 params[__scalar_as_int(postype_j.w)]);
-
-                            if (bin >= 0)
-                                min_bin = std::min(min_bin, bin);
-                            }
-                        }
-                    }
-                else
+                unsigned int cur_node_idx = hits[cur_hit];
+                for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                     {
-                    // skip ahead
-                    cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
+                    // read in its position and orientation
+                    unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                    // skip i==j in the 0 image
+                    if (cur_image == 0 && i == j)
+                        continue;
+
+                    Scalar4 postype_j = h_postype.data[j];
+                    Scalar4 orientation_j = h_orientation.data[j];
+
+                    // put particles in coordinate system of particle i
+                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+
+                    int bin = computeBin(r_ij,
+                                         quat<Scalar>(orientation_i),
+                                         quat<Scalar>(orientation_j),
+                                         params[__scalar_as_int(postype_i.w)],
+                                         params[__scalar_as_int(postype_j.w)]);
+
+                    if (bin >= 0)
+                        min_bin = std::min(min_bin, bin);
                     }
                 } // end loop over AABB nodes
             } // end loop over images
 
         // record the minimum bin
-        if ((unsigned int)min_bin < m_hist.size())
-            m_hist[min_bin]++;
+        if ((unsigned int)min_bin < hist.size())
+            hist[min_bin]++;
 
         } // end loop over all particles
+    #ifdef ENABLE_TBB
+        });
+
+    // add up the thread histograms
+    for (auto it = hist_tls.begin(); it != hist_tls.end(); ++it)
+        for (unsigned int bin = 0; bin < m_hist.size(); bin++)
+            m_hist[bin] += (*it)[bin];
+    #endif
     }
 
 /*! \param r_ij Vector pointing from particle i to j (already wrapped into the box)
@@ -434,7 +488,7 @@ int AnalyzerSDF<Shape>:: computeBin(const vec3<Scalar>& r_ij,
                              const quat<Scalar>& orientation_i,
                              const quat<Scalar>& orientation_j,
                              const typename Shape::param_type& params_i,
-                             const typename Shape::param_type& params_j)
+                             const typename Shape::param_type& params_j) const
     {
     unsigned int L=0;
     unsigned int R=m_hist.size();
@@ -468,7 +522,7 @@ int AnalyzerSDF<Shape>:: computeBin(const vec3<Scalar>& r_ij,
 template < class Shape > void export_AnalyzerSDF(pybind11::module& m, const std::string& name)
     {
     pybind11::class_< AnalyzerSDF<Shape>, std::shared_ptr< AnalyzerSDF<Shape> > >(m, name.c_str(), pybind11::base<Analyzer>())
-          .def(pybind11::init< std::shared_ptr<SystemDefinition>, std::shared_ptr< IntegratorHPMCMono<Shape> >, double, double, unsigned int, const std::string&, bool>())
+          .def(pybind11::init< std::shared_ptr<SystemDefinition>, std::shared_ptr< IntegratorHPMCMono<Shape> >, double, double, unsigned int, const std::string&, bool, bool>())
           ;
     }
 
@@ -25,6 +25,9 @@
 
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 namespace hpmc
 {
@@ -135,12 +138,11 @@ template<class Shape>
 void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
     {
     unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
 
     this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
 
     // update AABB tree
-    const detail::AABBTree& aabb_tree = this->m_mc->buildAABBTree();
+    const detail::AABBTreeWide& aabb_tree = this->m_mc->buildAABBTree();
 
     // update the image list
     std::vector<vec3<Scalar> > image_list = this->m_mc->updateImageList();
@@ -168,7 +170,25 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
         n_sample /= this->m_exec_conf->getNRanks();
         #endif
 
+        // every sample draws from its own random number stream, so the count does not depend on the number of threads
+        #ifdef ENABLE_TBB
+        overlap_count = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_sample),
+            0u,
+            [&](const tbb::blocked_range<unsigned int>& r, unsigned int overlap_count)->unsigned int {
+            unsigned int err_count = 0;
+
+            // leaf nodes of the AABB tree found by a query
+            std::vector<unsigned int> hits;
+
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+        #else
+        unsigned int err_count = 0;
+
+        // leaf nodes of the AABB tree found by a query
+        std::vector<unsigned int> hits;
+
         for (unsigned int i = 0; i < n_sample; i++)
+        #endif
             {
             // select a random particle coordinate in the box
             hoomd::RandomGenerator rng_i(hoomd::RNGIdentifier::ComputeFreeVolume, m_seed, m_exec_conf->getRank(), i, timestep);
@@ -198,46 +218,38 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
                 detail::AABB aabb = aabb_i_local;
                 aabb.translate(pos_i_image);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes(); cur_node_idx++)
+                // find the leaf nodes of the tree that overlap
+                hits.clear();
+                aabb_tree.queryNodes(hits, aabb);
+                for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                     {
-                    if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    unsigned int cur_node_idx = hits[cur_hit];
+                    for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (aabb_tree.isNodeLeaf(cur_node_idx))
+                        // read in its position and orientation
+                        unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        Scalar4 orientation_j;
+
+                        // load the position and orientation of the j particle
+                        postype_j = h_postype.data[j];
+                        orientation_j = h_orientation.data[j];
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
+
+                        if (h_overlaps.data[overlap_idx(m_type, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, err_count))
                             {
-                            for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
-
-                                // load the position and orientation of the j particle
-                                postype_j = h_postype.data[j];
-                                orientation_j = h_orientation.data[j];
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
-
-                                if (h_overlaps.data[overlap_idx(m_type, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, err_count))
-                                    {
-                                    overlap = true;
-                                    break;
-                                    }
-                                }
+                            overlap = true;
+                            break;
                             }
                         }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                        }
 
                     if (overlap)
                         break;
@@ -252,6 +264,10 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
                 overlap_count++;
                 }
             } // end loop through all particles
+        #ifdef ENABLE_TBB
+        return overlap_count;
+        }, [](unsigned int x, unsigned int y)->unsigned int { return x+y; } );
+        #endif
 
         } // end lexical scope
 
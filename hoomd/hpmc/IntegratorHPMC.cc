@@ -21,7 +21,7 @@ IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int seed)
     : Integrator(sysdef, 0.005), m_seed(seed),  m_move_ratio(32768), m_nselect(4),
       m_nominal_width(1.0), m_extra_ghost_width(0), m_external_base(NULL), m_patch_log(false),
-      m_past_first_run(false)
+      m_past_first_run(false), m_checkerboard(false)
       #ifdef ENABLE_MPI
       ,m_communicator_ghost_width_connected(false),
       m_communicator_flags_connected(false)
@@ -330,6 +330,8 @@ void export_IntegratorHPMC(py::module& m)
     .def("communicate", &IntegratorHPMC::communicate)
     .def("slotNumTypesChange", &IntegratorHPMC::slotNumTypesChange)
     .def("setDeterministic", &IntegratorHPMC::setDeterministic)
+    .def("setCheckerboard", &IntegratorHPMC::setCheckerboard)
+    .def("getCheckerboard", &IntegratorHPMC::getCheckerboard)
     .def("disablePatchEnergyLogOnly", &IntegratorHPMC::disablePatchEnergyLogOnly)
     ;
 
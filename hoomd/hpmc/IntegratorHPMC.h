@@ -77,6 +77,84 @@ class PatchEnergy
         return 0;
         }
 
+    //! evaluate the total energy of the patch interactions of particle i with a batch of neighbors
+    /*! \param n Number of neighbors in the batch
+        \param r_ij Vectors pointing from particle i to each neighbor j
+        \param type_i Integer type index of particle i
+        \param q_i Orientation quaternion of particle i
+        \param d_i Diameter of particle i
+        \param charge_i Charge of particle i
+        \param type_j Integer type indices of the neighbors
+        \param q_j Orientation quaternions of the neighbors
+        \param d_j Diameters of the neighbors
+        \param charge_j Charges of the neighbors
+        \returns Sum of the energies of the n patch interactions.
+
+        The default implementation calls energy() for every neighbor. Evaluators that can process many pairs in one
+        call (e.g. with vectorized code) override this method.
+    */
+    virtual float energyBatch(unsigned int n,
+        const vec3<float> *r_ij,
+        unsigned int type_i,
+        const quat<float>& q_i,
+        float d_i,
+        float charge_i,
+        const unsigned int *type_j,
+        const quat<float> *q_j,
+        const float *d_j,
+        const float *charge_j)
+        {
+        float energy_sum = 0;
+        for (unsigned int k = 0; k < n; ++k)
+            energy_sum += energy(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+        return energy_sum;
+        }
+
+    };
+
+//! Neighbors of a particle i, gathered for one call to PatchEnergy::energyBatch()
+struct PatchEnergyBatch
+    {
+    std::vector< vec3<float> > r_ij;   //!< Vectors pointing from particle i to the neighbors
+    std::vector<unsigned int> type_j;  //!< Types of the neighbors
+    std::vector< quat<float> > q_j;    //!< Orientations of the neighbors
+    std::vector<float> d_j;            //!< Diameters of the neighbors
+    std::vector<float> charge_j;       //!< Charges of the neighbors
+
+    //! Remove all neighbors, keeping the allocated memory
+    void clear()
+        {
+        r_ij.clear();
+        type_j.clear();
+        q_j.clear();
+        d_j.clear();
+        charge_j.clear();
+        }
+
+    //! Add a neighbor to the batch
+    void push_back(const vec3<float>& r, unsigned int type, const quat<float>& q, float d, float charge)
+        {
+        r_ij.push_back(r);
+        type_j.push_back(type);
+        q_j.push_back(q);
+        d_j.push_back(d);
+        charge_j.push_back(charge);
+        }
+
+    //! Get the number of neighbors in the batch
+    unsigned int size() const
+        {
+        return r_ij.size();
+        }
+
+    //! Evaluate the total energy of particle i with all neighbors in the batch
+    float energy(PatchEnergy& patch, unsigned int type_i, const quat<float>& q_i, float d_i, float charge_i) const
+        {
+        if (r_ij.size() == 0)
+            return 0;
+        return patch.energyBatch(r_ij.size(), r_ij.data(), type_i, q_i, d_i, charge_i,
+            type_j.data(), q_j.data(), d_j.data(), charge_j.data());
+        }
     };
 
 class PYBIND11_EXPORT IntegratorHPMC : public Integrator
@@ -322,6 +400,20 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         //! Enable deterministic simulations
         virtual void setDeterministic(bool deterministic) {};
 
+        //! Enable the checkerboard decomposition of trial moves on multiple CPU threads
+        /*! \param checkerboard True to distribute the trial moves over threads
+        */
+        void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            }
+
+        //! \returns true if the checkerboard decomposition is enabled
+        bool getCheckerboard()
+            {
+            return m_checkerboard;
+            }
+
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep)
             {
@@ -362,6 +454,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         bool m_patch_log;                           //!< If true, only use patch energy for logging
 
         bool m_past_first_run;                      //!< Flag to test if the first run() has started
+        bool m_checkerboard;                        //!< True if trial moves may run on threads in a checkerboard
         //! Update the nominal width of the cells
         /*! This method is virtual so that derived classes can set appropriate widths
             (for example, some may want max diameter while others may want a buffer distance).
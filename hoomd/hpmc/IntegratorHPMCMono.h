@@ -12,6 +12,7 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 #include "hoomd/Integrator.h"
 #include "HPMCPrecisionSetup.h"
@@ -297,7 +298,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
         virtual float computePatchEnergy(unsigned int timestep);
 
         //! Build the AABB tree (if needed)
-        const detail::AABBTree& buildAABBTree();
+        const detail::AABBTreeWide& buildAABBTree();
 
         //! Make list of image indices for boxes to check in small-box mode
         const std::vector<vec3<Scalar> >& updateImageList();
@@ -312,6 +313,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange();
 
+        //! Rebuild the AABB tree from scratch on the next call to buildAABBTree()
         void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
@@ -337,10 +339,16 @@ class IntegratorHPMCMono : public IntegratorHPMC
         bool m_hasOrientation;                               //!< true if there are any orientable particles in the system
 
         std::shared_ptr< ExternalFieldMono<Shape> > m_external;//!< External Field
-        detail::AABBTree m_aabb_tree;               //!< Bounding volume hierarchy for overlap checks
+        detail::AABBTreeWide m_aabb_tree;           //!< Bounding volume hierarchy for overlap checks
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_refit;                     //!< Flag if the particles have moved since the tree was built or refit
+        unsigned int m_aabb_tree_n;                 //!< Number of particles in the aabb tree
+        Scalar m_aabb_tree_build_cost;              //!< Surface area cost of the aabb tree after the last build
+        Scalar m_aabb_tree_max_cost;                //!< Rebuild the tree when a refit increases its cost by more than this factor
+        unsigned int m_aabb_tree_builds;            //!< Number of aabb tree builds since the last resetStats()
+        unsigned int m_aabb_tree_refits;            //!< Number of aabb tree refits since the last resetStats()
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
@@ -355,14 +363,26 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int> m_cb_cell_start;      //!< First entry of every checkerboard cell in m_cb_cell_particles (plus one past the end)
+        std::vector<unsigned int> m_cb_cell_particles;  //!< Local and ghost particle indices sorted by checkerboard cell
+        std::vector<unsigned int> m_cb_particle_cell;   //!< Checkerboard cell of every local and ghost particle
+
+        //! Get the dimensions of the checkerboard cell grid
+        bool getCheckerboardDim(uint3& dim);
+
+        //! Perform the trial moves of one step on multiple threads
+        void updateCheckerboard(unsigned int timestep, const uint3& dim, hpmc_counters_t& counters);
+        #endif
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
             m_image_list_valid = false;
             // changing the box does not necessarily invalidate the AABB tree - however, practically
             // anything that changes the box (i.e. NPT, box_resize) is also moving the particles,
-            // so use it as a sign to rebuild the AABB tree
-            m_aabb_tree_invalid = true;
+            // so use it as a sign to refit the AABB tree
+            m_aabb_tree_refit = true;
             }
 
         //! callback so that the particle sort signal can invalidate the AABB tree
@@ -400,6 +420,12 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_refit = false;
+    m_aabb_tree_n = 0;
+    m_aabb_tree_build_cost = 0.0;
+    m_aabb_tree_max_cost = 1.25;
+    m_aabb_tree_builds = 0;
+    m_aabb_tree_refits = 0;
     }
 
 
@@ -470,12 +496,18 @@ void IntegratorHPMCMono<Shape>::printStats()
 
     m_exec_conf->msg->notice(2) << "Avg AABB tree height: " << total_height / Scalar(m_pdata->getN()) << std::endl;
     m_exec_conf->msg->notice(2) << "Max AABB tree height: " << max_height << std::endl;*/
+
+    m_exec_conf->msg->notice(2) << "AABB tree builds:              " << m_aabb_tree_builds << std::endl;
+    m_exec_conf->msg->notice(2) << "AABB tree refits:              " << m_aabb_tree_refits << std::endl;
     }
 
 template <class Shape>
 void IntegratorHPMCMono<Shape>::resetStats()
     {
     IntegratorHPMC::resetStats();
+
+    m_aabb_tree_builds = 0;
+    m_aabb_tree_refits = 0;
     }
 
 template <class Shape>
@@ -508,6 +540,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_exec_conf->msg->notice(10) << "HPMCMono update: " << timestep << std::endl;
     IntegratorHPMC::update(timestep);
 
+    // measure the time spent outside of communication (for load balancing)
+    int64_t start_time = this->m_compute_clock.getTime();
+
     // get needed vars
     ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::readwrite);
     hpmc_counters_t& counters = h_counters.data[0];
@@ -524,8 +559,16 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_update_order.resize(m_pdata->getN());
     m_update_order.shuffle(timestep);
 
+    // distribute the trial moves over threads with a checkerboard decomposition when enabled and possible
+    bool checkerboard = false;
+    #ifdef ENABLE_TBB
+    uint3 cb_dim;
+    checkerboard = getCheckerboardDim(cb_dim);
+    #endif
+
     // update the AABB Tree
-    buildAABBTree();
+    if (!checkerboard)
+        buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
     limitMoveDistances();
     // update the image list
@@ -538,11 +581,22 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         m_external->compute(timestep);
         }
 
+    #ifdef ENABLE_TBB
+    if (checkerboard)
+        updateCheckerboard(timestep, cb_dim, counters);
+    #endif
+
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // leaf nodes of the AABB tree found by a query
+    std::vector<unsigned int> hits;
+
+    // neighbors within the patch cut-off, evaluated in one batch per configuration
+    PatchEnergyBatch patch_batch;
+
     // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect && !checkerboard; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -632,8 +686,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
+            patch_batch.clear();
 
-            // check for overlaps with neighboring particle's positions (also calculate the new energy)
+            // check for overlaps with neighboring particle's positions (also collect the neighbors for the new energy)
             // All image boxes (including the primary)
             const unsigned int n_images = m_image_list.size();
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
@@ -642,81 +697,64 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                 detail::AABB aabb = aabb_i_local;
                 aabb.translate(pos_i_image);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                // find the leaf nodes of the tree that overlap
+                hits.clear();
+                m_aabb_tree.queryNodes(hits, aabb);
+                for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                     {
-                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    unsigned int cur_node_idx = hits[cur_hit];
+                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        // read in its position and orientation
+                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        Scalar4 orientation_j;
+
+                        // handle j==i situations
+                        if ( j != i )
                             {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            // load the position and orientation of the j particle
+                            postype_j = h_postype.data[j];
+                            orientation_j = h_orientation.data[j];
+                            }
+                        else
+                            {
+                            if (cur_image == 0)
+                                {
+                                // in the first image, skip i == j
+                                continue;
+                                }
+                            else
                                 {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                                // If this is particle i and we are in an outside image, use the translated position and orientation
+                                postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                                orientation_j = quat_to_scalar4(shape_i.orientation);
+                                }
+                            }
 
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                                // handle j==i situations
-                                if ( j != i )
-                                    {
-                                    // load the position and orientation of the j particle
-                                    postype_j = h_postype.data[j];
-                                    orientation_j = h_orientation.data[j];
-                                    }
-                                else
-                                    {
-                                    if (cur_image == 0)
-                                        {
-                                        // in the first image, skip i == j
-                                        continue;
-                                        }
-                                    else
-                                        {
-                                        // If this is particle i and we are in an outside image, use the translated position and orientation
-                                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
-                                        orientation_j = quat_to_scalar4(shape_i.orientation);
-                                        }
-                                    }
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                        Scalar rcut = 0.0;
+                        if (m_patch)
+                            rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                Scalar rcut = 0.0;
-                                if (m_patch)
-                                    rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
-
-                                counters.overlap_checks++;
-                                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
-                                    {
-                                    overlap = true;
-                                    break;
-                                    }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
-                                    {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
-                                    }
-                                }
+                        counters.overlap_checks++;
+                        if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            overlap = true;
+                            break;
+                            }
+                        else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, collect the pair
+                            {
+                            patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), h_diameter.data[j], h_charge.data[j]);
                             }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
                         }
 
                     if (overlap)
@@ -730,77 +768,69 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             // calculate old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !m_patch_log && !overlap)
                 {
+                // deltaU = U_old - U_new: subtract energy of new configuration
+                patch_field_energy_diff -= patch_batch.energy(*m_patch, typ_i, quat<float>(shape_i.orientation),
+                    h_diameter.data[i], h_charge.data[i]);
+                patch_batch.clear();
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
                     detail::AABB aabb = aabb_i_local;
                     aabb.translate(pos_i_image);
 
-                    // stackless search
-                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                    // find the leaf nodes of the tree that overlap
+                    hits.clear();
+                    m_aabb_tree.queryNodes(hits, aabb);
+                    for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                         {
-                        if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        unsigned int cur_node_idx = hits[cur_hit];
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                             {
-                            if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            // read in its position and orientation
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            Scalar4 postype_j;
+                            Scalar4 orientation_j;
+
+                            // handle j==i situations
+                            if ( j != i )
+                                {
+                                // load the position and orientation of the j particle
+                                postype_j = h_postype.data[j];
+                                orientation_j = h_orientation.data[j];
+                                }
+                            else
                                 {
-                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                if (cur_image == 0)
+                                    {
+                                    // in the first image, skip i == j
+                                    continue;
+                                    }
+                                else
                                     {
-                                    // read in its position and orientation
-                                    unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                    Scalar4 postype_j;
-                                    Scalar4 orientation_j;
-
-                                    // handle j==i situations
-                                    if ( j != i )
-                                        {
-                                        // load the position and orientation of the j particle
-                                        postype_j = h_postype.data[j];
-                                        orientation_j = h_orientation.data[j];
-                                        }
-                                    else
-                                        {
-                                        if (cur_image == 0)
-                                            {
-                                            // in the first image, skip i == j
-                                            continue;
-                                            }
-                                        else
-                                            {
-                                            // If this is particle i and we are in an outside image, use the translated position and orientation
-                                            postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
-                                            orientation_j = quat_to_scalar4(shape_old.orientation);
-                                            }
-                                        }
+                                    // If this is particle i and we are in an outside image, use the translated position and orientation
+                                    postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
+                                    orientation_j = quat_to_scalar4(shape_old.orientation);
+                                    }
+                                }
 
-                                    // put particles in coordinate system of particle i
-                                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                            // put particles in coordinate system of particle i
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
 
-                                    Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+                            Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                    // deltaU = U_old - U_new: add energy of old configuration
-                                    if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
-                                    }
-                                }
-                            }
-                        else
-                            {
-                            // skip ahead
-                            cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                            if (dot(r_ij,r_ij) <= rcut*rcut)
+                                patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), h_diameter.data[j], h_charge.data[j]);
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                patch_field_energy_diff += patch_batch.energy(*m_patch, typ_i, quat<float>(orientation_i),
+                    h_diameter.data[i], h_charge.data[i]);
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -891,12 +921,434 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
+    this->m_compute_time += double(this->m_compute_clock.getTime() - start_time) * 1e-9;
+
     // migrate and exchange particles
     communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
-    m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit
+    m_aabb_tree_refit = true;
+    }
+
+#ifdef ENABLE_TBB
+/*! \param dim Returns the number of checkerboard cells along each lattice direction of the local box
+    \returns true if the trial moves of this step can be distributed over threads
+
+    The cells are at least as wide as the nominal width, so that particles in cells that do not share a face, edge
+    or corner cannot interact. Along periodic directions the number of cells is even, so that the checkerboard
+    pattern continues across the boundary. The grid is coarsened so that it has no more cells than local particles.
+
+    The trial moves are distributed over threads when the checkerboard decomposition is enabled (see
+    setCheckerboard()), more than one thread is available, there is no external field, and every cell set has at
+    least two cells on average.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::getCheckerboardDim(uint3& dim)
+    {
+    if (!m_checkerboard || m_exec_conf->getNumThreads() <= 1 || m_external || m_nominal_width <= Scalar(0.0))
+        return false;
+
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 npd = box.getNearestPlaneDistance();
+    uchar3 periodic = box.getPeriodic();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+
+    Scalar L[3] = {npd.x, npd.y, npd.z};
+    bool wrap[3] = {periodic.x != 0, periodic.y != 0, periodic.z != 0};
+
+    // the largest number of cells that fit, and the factor needed to limit the number of cells
+    double n_cells = 1.0;
+    for (unsigned int d = 0; d < ndim; d++)
+        n_cells *= std::floor(L[d] / m_nominal_width);
+    double coarsen = 1.0;
+    if (n_cells > double(m_pdata->getN()))
+        coarsen = std::pow(n_cells / double(std::max(m_pdata->getN(), 1u)), 1.0/double(ndim));
+
+    unsigned int n[3] = {1, 1, 1};
+    unsigned int n_sets = 1;
+    for (unsigned int d = 0; d < ndim; d++)
+        {
+        double n_d = std::floor(L[d] / (m_nominal_width * coarsen));
+        n[d] = (unsigned int)std::max(n_d, 0.0);
+        if (wrap[d])
+            n[d] -= n[d] % 2;
+        if (n[d] < (wrap[d] ? 2u : 1u))
+            return false;
+        n_sets *= 2;
+        }
+
+    dim = make_uint3(n[0], n[1], n[2]);
+    return (unsigned long long)dim.x * dim.y * dim.z >= 2 * n_sets;
+    }
+
+/*! \param timestep Current time step
+    \param dim Number of checkerboard cells along each lattice direction of the local box
+    \param counters Acceptance counters to add to
+
+    The local box is divided into a grid of cells that are at least as wide as the nominal width. Cells are grouped
+    into 2^d sets by the parity of their coordinates, such that no two cells of the same set touch. The sets are
+    processed one after another, and the cells of one set in parallel. Every trial move is confined to the cell of
+    the particle, so that the particles in the cells of one set can only interact with particles in cells that do
+    not move. This is the same decomposition the GPU implementation uses.
+
+    Along periodic directions, the cell grid is shifted by a random offset on every sweep so that the cell
+    boundaries do not bias the sampling. Along directions that are not periodic (i.e. with domain decomposition),
+    the existing random shift of the particles against the domain boundaries serves the same purpose, and an
+    extra layer of cells on either side holds the ghost particles.
+
+    Every local particle receives m_nselect trial moves per step, with the same random numbers as in the serial
+    update. The result does not depend on the number of threads.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCheckerboard(unsigned int timestep, const uint3& dim, hpmc_counters_t& counters)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    uchar3 periodic = box.getPeriodic();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int N_total = N + m_pdata->getNGhosts();
+
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = m_nominal_width / npd;
+    #endif
+
+    const int n[3] = {int(dim.x), int(dim.y), int(dim.z)};
+    bool wrap[3] = {periodic.x != 0, periodic.y != 0, periodic.z != 0};
+    int offset[3];
+    unsigned int ext[3];
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        if (d >= ndim)
+            wrap[d] = true;
+        offset[d] = wrap[d] ? 0 : 1;
+        ext[d] = n[d] + 2*offset[d];
+        }
+    Index3D cell_idx(ext[0], ext[1], ext[2]);
+    const unsigned int NOT_IN_GRID = 0xffffffff;
+
+    // offset of the cell grid along periodic directions, in fractional coordinates
+    Scalar grid_shift[3] = {0, 0, 0};
+
+    // find the cell of a position, local particles are always placed in the cells of the local box
+    auto get_cell = [&](const vec3<Scalar>& pos, bool local)->unsigned int
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(pos));
+        Scalar fr[3] = {f.x, f.y, f.z};
+        int c[3] = {0, 0, 0};
+        for (unsigned int d = 0; d < ndim; d++)
+            {
+            if (wrap[d])
+                {
+                Scalar u = fr[d] + grid_shift[d];
+                u -= std::floor(u);
+                c[d] = std::min(int(u * n[d]), n[d]-1);
+                }
+            else
+                {
+                c[d] = int(std::floor(fr[d] * n[d]));
+                if (local)
+                    c[d] = std::max(0, std::min(c[d], n[d]-1));
+                else if (c[d] < -1 || c[d] > n[d])
+                    return NOT_IN_GRID;
+                c[d] += offset[d];
+                }
+            }
+        return cell_idx(c[0], c[1], c[2]);
+        };
+
+    // the cells of every set
+    const unsigned int n_sets = 1 << ndim;
+    std::vector< std::vector<unsigned int> > set_cells(n_sets);
+    for (int k = 0; k < n[2]; k++)
+        for (int j = 0; j < n[1]; j++)
+            for (int i = 0; i < n[0]; i++)
+                {
+                unsigned int set = (i & 1) | ((j & 1) << 1) | ((k & 1) << 2);
+                set_cells[set].push_back(cell_idx(i + offset[0], j + offset[1], k + offset[2]));
+                }
+    detail::UpdateOrder set_order(m_seed + m_exec_conf->getRank(), n_sets);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    // access move sizes and interaction matrix
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    tbb::enumerable_thread_specific<PatchEnergyBatch> thread_patch_batch;
+
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        hoomd::RandomGenerator rng(hoomd::RNGIdentifier::HPMCMonoCheckerboard, m_seed, timestep, i_nselect);
+        for (unsigned int d = 0; d < ndim; d++)
+            if (wrap[d])
+                grid_shift[d] = hoomd::detail::generate_canonical<Scalar>(rng);
+
+        // sort the particles into cells, local particles in the shuffled update order
+        m_cb_particle_cell.resize(N_total);
+        m_cb_cell_start.assign(cell_idx.getNumElements()+1, 0);
+        for (unsigned int i = 0; i < N_total; i++)
+            {
+            unsigned int cell = get_cell(vec3<Scalar>(h_postype.data[i]), i < N);
+            m_cb_particle_cell[i] = cell;
+            if (cell != NOT_IN_GRID)
+                m_cb_cell_start[cell+1]++;
+            }
+        for (unsigned int cell = 0; cell < cell_idx.getNumElements(); cell++)
+            m_cb_cell_start[cell+1] += m_cb_cell_start[cell];
+
+        m_cb_cell_particles.resize(m_cb_cell_start.back());
+        std::vector<unsigned int> fill(m_cb_cell_start.begin(), m_cb_cell_start.end()-1);
+        for (unsigned int k = 0; k < N_total; k++)
+            {
+            unsigned int i = k < N ? m_update_order[k] : k;
+            unsigned int cell = m_cb_particle_cell[i];
+            if (cell != NOT_IN_GRID)
+                m_cb_cell_particles[fill[cell]++] = i;
+            }
+
+        set_order.shuffle(timestep, i_nselect+1);
+        for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+            {
+            const std::vector<unsigned int>& cells = set_cells[set_order[cur_set]];
+
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)cells.size()),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                hpmc_counters_t& my_counters = thread_counters.local();
+                PatchEnergyBatch& patch_batch = thread_patch_batch.local();
+
+                for (unsigned int cur_cell = r.begin(); cur_cell != r.end(); ++cur_cell)
+                    {
+                    const unsigned int cell = cells[cur_cell];
+                    int c[3] = {int(cell % ext[0]), int((cell / ext[0]) % ext[1]), int(cell / (ext[0]*ext[1]))};
+
+                    // the neighboring cells (including this one), each listed once when there are only two cells
+                    // along a periodic direction
+                    unsigned int nb_cell[27];
+                    unsigned int n_nb = 0;
+                    int range_z = ndim == 3 ? 1 : 0;
+                    for (int dz = -range_z; dz <= range_z; dz++)
+                        for (int dy = -1; dy <= 1; dy++)
+                            for (int dx = -1; dx <= 1; dx++)
+                                {
+                                int nc[3] = {c[0]+dx, c[1]+dy, c[2]+dz};
+                                for (unsigned int d = 0; d < ndim; d++)
+                                    if (wrap[d])
+                                        nc[d] = (nc[d] + n[d]) % n[d];
+
+                                unsigned int nb = cell_idx(nc[0], nc[1], nc[2]);
+                                if (std::find(nb_cell, nb_cell + n_nb, nb) == nb_cell + n_nb)
+                                    nb_cell[n_nb++] = nb;
+                                }
+
+                    for (unsigned int cur_p = m_cb_cell_start[cell]; cur_p < m_cb_cell_start[cell+1]; cur_p++)
+                        {
+                        unsigned int i = m_cb_cell_particles[cur_p];
+                        if (i >= N)
+                            continue;
+
+                        // read in the current position and orientation
+                        Scalar4 postype_i = h_postype.data[i];
+                        Scalar4 orientation_i = h_orientation.data[i];
+                        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                        #ifdef ENABLE_MPI
+                        if (m_comm)
+                            {
+                            // only move particle if active
+                            if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                                continue;
+                            }
+                        #endif
+
+                        // make a trial move for i
+                        hoomd::RandomGenerator rng_i(hoomd::RNGIdentifier::HPMCMonoTrialMove, m_seed, i, m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+                        int typ_i = __scalar_as_int(postype_i.w);
+                        Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+                        unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+                        bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_move_ratio);
+
+                        Shape shape_old(quat<Scalar>(orientation_i), m_params[typ_i]);
+                        vec3<Scalar> pos_old = pos_i;
+
+                        if (move_type_translate)
+                            {
+                            // skip if no overlap check is required
+                            if (h_d.data[typ_i] == 0.0)
+                                {
+                                if (!shape_i.ignoreStatistics())
+                                    my_counters.translate_accept_count++;
+                                continue;
+                                }
+
+                            move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                            #ifdef ENABLE_MPI
+                            if (m_comm)
+                                {
+                                // check if particle has moved into the ghost layer, and skip if it is
+                                if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                                    continue;
+                                }
+                            #endif
+
+                            // reject moves out of the cell
+                            if (get_cell(pos_i, true) != cell)
+                                {
+                                if (!shape_i.ignoreStatistics())
+                                    my_counters.translate_reject_count++;
+                                continue;
+                                }
+                            }
+                        else
+                            {
+                            if (h_a.data[typ_i] == 0.0)
+                                {
+                                if (!shape_i.ignoreStatistics())
+                                    my_counters.rotate_accept_count++;
+                                continue;
+                                }
+
+                            move_rotate(shape_i.orientation, rng_i, h_a.data[typ_i], ndim);
+                            }
+
+                        bool overlap = false;
+                        OverlapReal r_cut_patch = 0;
+
+                        if (m_patch && !m_patch_log)
+                            {
+                            r_cut_patch = m_patch->getRCut() + 0.5*m_patch->getAdditiveCutoff(typ_i);
+                            }
+
+                        // patch interaction deltaU
+                        double patch_field_energy_diff = 0;
+                        patch_batch.clear();
+
+                        // check for overlaps with the particles in the neighboring cells (also collect the neighbors
+                        // for the new energy)
+                        for (unsigned int cur_nb = 0; cur_nb < n_nb && !overlap; cur_nb++)
+                            {
+                            const unsigned int nb = nb_cell[cur_nb];
+                            for (unsigned int cur_j = m_cb_cell_start[nb]; cur_j < m_cb_cell_start[nb+1]; cur_j++)
+                                {
+                                unsigned int j = m_cb_cell_particles[cur_j];
+                                if (j == i)
+                                    continue;
+
+                                Scalar4 postype_j = h_postype.data[j];
+                                Scalar4 orientation_j = h_orientation.data[j];
+
+                                // put particles in coordinate system of particle i
+                                vec3<Scalar> r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_i)));
+
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                                Scalar rcut = 0.0;
+                                if (m_patch)
+                                    rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                                my_counters.overlap_checks++;
+                                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                    && test_overlap(r_ij, shape_i, shape_j, my_counters.overlap_err_count))
+                                    {
+                                    overlap = true;
+                                    break;
+                                    }
+                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut)
+                                    {
+                                    patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), h_diameter.data[j], h_charge.data[j]);
+                                    }
+                                }
+                            }
+
+                        // calculate old patch energy only if m_patch not NULL and no overlaps
+                        if (m_patch && !m_patch_log && !overlap)
+                            {
+                            // deltaU = U_old - U_new: subtract energy of new configuration
+                            patch_field_energy_diff -= patch_batch.energy(*m_patch, typ_i, quat<float>(shape_i.orientation),
+                                h_diameter.data[i], h_charge.data[i]);
+                            patch_batch.clear();
+
+                            for (unsigned int cur_nb = 0; cur_nb < n_nb; cur_nb++)
+                                {
+                                const unsigned int nb = nb_cell[cur_nb];
+                                for (unsigned int cur_j = m_cb_cell_start[nb]; cur_j < m_cb_cell_start[nb+1]; cur_j++)
+                                    {
+                                    unsigned int j = m_cb_cell_particles[cur_j];
+                                    if (j == i)
+                                        continue;
+
+                                    Scalar4 postype_j = h_postype.data[j];
+                                    Scalar4 orientation_j = h_orientation.data[j];
+
+                                    // put particles in coordinate system of particle i
+                                    vec3<Scalar> r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_old)));
+                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                                    Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                                    if (dot(r_ij,r_ij) <= rcut*rcut)
+                                        patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), h_diameter.data[j], h_charge.data[j]);
+                                    }
+                                }
+
+                            // deltaU = U_old - U_new: add energy of old configuration
+                            patch_field_energy_diff += patch_batch.energy(*m_patch, typ_i, quat<float>(orientation_i),
+                                h_diameter.data[i], h_charge.data[i]);
+                            }
+
+                        // If no overlaps and Metropolis criterion is met, accept
+                        // trial move and update positions  and/or orientations.
+                        if (!overlap && hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(patch_field_energy_diff))
+                            {
+                            // increment accept counter and assign new position
+                            if (!shape_i.ignoreStatistics())
+                                {
+                                if (move_type_translate)
+                                    my_counters.translate_accept_count++;
+                                else
+                                    my_counters.rotate_accept_count++;
+                                }
+
+                            // update position of particle
+                            h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+                            if (shape_i.hasOrientation())
+                                {
+                                h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                                }
+                            }
+                        else
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                {
+                                // increment reject counter
+                                if (move_type_translate)
+                                    my_counters.translate_reject_count++;
+                                else
+                                    my_counters.rotate_reject_count++;
+                                }
+                            }
+                        } // end loop over particles in the cell
+                    } // end loop over cells
+                });
+            } // end loop over cell sets
+        } // end loop over nselect
+
+    for (auto it = thread_counters.begin(); it != thread_counters.end(); ++it)
+        counters = counters + *it;
     }
+#endif
 
 /*! \param timestep current step
     \param early_exit exit at first overlap found if true
@@ -931,6 +1383,9 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(unsigned int timestep, boo
     // access parameters and interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // leaf nodes of the AABB tree found by a query
+    std::vector<unsigned int> hits;
+
     // Loop over all particles
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
@@ -951,52 +1406,44 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(unsigned int timestep, boo
             detail::AABB aabb = aabb_i_local;
             aabb.translate(pos_i_image);
 
-            // stackless search
-            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+            // find the leaf nodes of the tree that overlap
+            hits.clear();
+            m_aabb_tree.queryNodes(hits, aabb);
+            for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                 {
-                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                unsigned int cur_node_idx = hits[cur_hit];
+                for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                     {
-                    if (m_aabb_tree.isNodeLeaf(cur_node_idx))
-                        {
-                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                            {
-                            // read in its position and orientation
-                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                    // read in its position and orientation
+                    unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                            // skip i==j in the 0 image
-                            if (cur_image == 0 && i == j)
-                                continue;
+                    // skip i==j in the 0 image
+                    if (cur_image == 0 && i == j)
+                        continue;
 
-                            Scalar4 postype_j = h_postype.data[j];
-                            Scalar4 orientation_j = h_orientation.data[j];
+                    Scalar4 postype_j = h_postype.data[j];
+                    Scalar4 orientation_j = h_orientation.data[j];
 
-                            // put particles in coordinate system of particle i
-                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                    // put particles in coordinate system of particle i
+                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                            unsigned int typ_j = __scalar_as_int(postype_j.w);
-                            Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
 
-                            if (h_tag.data[i] <= h_tag.data[j]
-                                && h_overlaps.data[m_overlap_idx(typ_i,typ_j)]
-                                && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                && test_overlap(r_ij, shape_i, shape_j, err_count)
-                                && test_overlap(-r_ij, shape_j, shape_i, err_count))
-                                {
-                                overlap_count++;
-                                if (early_exit)
-                                    {
-                                    // exit early from loop over neighbor particles
-                                    break;
-                                    }
-                                }
+                    if (h_tag.data[i] <= h_tag.data[j]
+                        && h_overlaps.data[m_overlap_idx(typ_i,typ_j)]
+                        && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                        && test_overlap(r_ij, shape_i, shape_j, err_count)
+                        && test_overlap(-r_ij, shape_j, shape_i, err_count))
+                        {
+                        overlap_count++;
+                        if (early_exit)
+                            {
+                            // exit early from loop over neighbor particles
+                            break;
                             }
                         }
                     }
-                else
-                    {
-                    // skip ahead
-                    cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
-                    }
 
                 if (overlap_count && early_exit)
                     {
@@ -1066,11 +1513,15 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
 
     // Loop over all particles
     #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<PatchEnergyBatch> thread_patch_batch;
     energy = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
         0.0f,
         [&](const tbb::blocked_range<unsigned int>& r, float energy)->float {
+        PatchEnergyBatch& patch_batch = thread_patch_batch.local();
         for (unsigned int i = r.begin(); i != r.end(); ++i)
     #else
+    // neighbors of particle i within the cut-off
+    PatchEnergyBatch patch_batch;
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
     #endif
         {
@@ -1083,6 +1534,7 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
 
         Scalar d_i = h_diameter.data[i];
         Scalar charge_i = h_charge.data[i];
+        patch_batch.clear();
 
         // the cut-off
         float r_cut = m_patch->getRCut() + 0.5*m_patch->getAdditiveCutoff(typ_i);
@@ -1131,15 +1583,7 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
 
                             if (h_tag.data[i] <= h_tag.data[j] && dot(r_ij,r_ij) <= rcut_ij*rcut_ij)
                                 {
-                                energy += m_patch->energy(r_ij,
-                                       typ_i,
-                                       quat<float>(orientation_i),
-                                       d_i,
-                                       charge_i,
-                                       typ_j,
-                                       quat<float>(orientation_j),
-                                       d_j,
-                                       charge_j);
+                                patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), d_j, charge_j);
                                 }
                             }
                         }
@@ -1152,6 +1596,8 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
 
                 } // end loop over AABB nodes
             } // end loop over images
+
+        energy += patch_batch.energy(*m_patch, typ_i, quat<float>(orientation_i), d_i, charge_i);
         } // end loop over particles
     #ifdef ENABLE_TBB
     return energy;
@@ -1459,33 +1905,39 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
 
 
 /*! Call any time an up to date AABB tree is needed. IntegratorHPMCMono internally tracks whether
-    the tree needs to be rebuilt or if the current tree can be used.
+    the tree needs to be rebuilt, refit, or if the current tree can be used.
 
-    buildAABBTree() relies on the member variable m_aabb_tree_invalid to work correctly. Any time particles
-    are moved (and not updated with m_aabb_tree->update()) or the particle list changes order, m_aabb_tree_invalid
-    needs to be set to true. Then buildAABBTree() will know to rebuild the tree from scratch on the next call. Typically
-    this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be rebuilt several times in a
-    single step because of box volume moves.
+    buildAABBTree() relies on the member variables m_aabb_tree_invalid and m_aabb_tree_refit to work correctly. Any
+    time the particle list changes order or the particles are exchanged with other ranks, m_aabb_tree_invalid needs
+    to be set to true. Then buildAABBTree() will know to rebuild the tree from scratch on the next call. Any time
+    particles are moved (and not updated with m_aabb_tree->update()) but keep their indices, m_aabb_tree_refit
+    needs to be set to true. Then buildAABBTree() refits the boxes of the existing tree to the new particle
+    positions, which is much cheaper than a rebuild. Typically this is on the next timestep. But in some cases
+    (i.e. NPT), the tree may need to be refit several times in a single step because of box volume moves.
 
-    Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
-    erroneous simulations will result.
+    A refit tree gets less efficient as the particles move away from their neighbors at the time of the build.
+    The tree is rebuilt when a refit increases its surface area cost (AABBTree::getCost()) by more than a factor of
+    m_aabb_tree_max_cost over the cost after the last build.
+
+    Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid or m_aabb_tree_refit
+    appropriately, or erroneous simulations will result.
 
     \returns A reference to the tree.
 */
 template <class Shape>
-const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
+const detail::AABBTreeWide& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
-    if (m_aabb_tree_invalid)
+    if (m_aabb_tree_invalid || m_aabb_tree_refit)
         {
-        m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
-        if (this->m_prof) this->m_prof->push(this->m_exec_conf, "AABB tree build");
-        // build the AABB tree
+        unsigned int n_aabb = m_pdata->getN()+m_pdata->getNGhosts();
+        bool rebuild = m_aabb_tree_invalid || n_aabb != m_aabb_tree_n;
+
+        if (this->m_prof) this->m_prof->push(this->m_exec_conf, rebuild ? "AABB tree build" : "AABB tree refit");
             {
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
 
             // grow the AABB list to the needed size
-            unsigned int n_aabb = m_pdata->getN()+m_pdata->getNGhosts();
             if (n_aabb > 0)
                 {
                 growAABBList(n_aabb);
@@ -1504,14 +1956,35 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the existing tree, unless that makes it too inefficient
+                if (!rebuild)
+                    {
+                    m_aabb_tree.refit(m_aabbs, n_aabb);
+                    if (m_aabb_tree.getCost() > m_aabb_tree_max_cost*m_aabb_tree_build_cost)
+                        rebuild = true;
+                    else
+                        m_aabb_tree_refits++;
+                    }
+
+                // build the AABB tree
+                if (rebuild)
+                    {
+                    m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls "
+                                                << m_pdata->getNGhosts() << " ghosts" << std::endl;
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    m_aabb_tree_build_cost = m_aabb_tree.getCost();
+                    m_aabb_tree_builds++;
+                    }
                 }
+            m_aabb_tree_n = n_aabb;
             }
 
         if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
         }
 
     m_aabb_tree_invalid = false;
+    m_aabb_tree_refit = false;
     return m_aabb_tree;
     }
 
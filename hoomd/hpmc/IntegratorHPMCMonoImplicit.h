@@ -430,6 +430,9 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     ArrayHandle<Scalar> h_d_min(m_d_min, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_d_max(m_d_max, access_location::host, access_mode::read);
 
+    // neighbors within the patch cut-off, evaluated in one batch per configuration
+    PatchEnergyBatch patch_batch;
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
         {
@@ -521,6 +524,7 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
 
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
+            patch_batch.clear();
 
             // All image boxes (including the primary)
             const unsigned int n_images = this->m_image_list.size();
@@ -591,18 +595,10 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                                     overlap = true;
                                     break;
                                     }
-                                // If there is no overlap and m_patch is not NULL, calculate energy
+                                // If there is no overlap and m_patch is not NULL, collect the pair
                                 else if (this->m_patch && !this->m_patch_log && rsq <= r_cut_ij*r_cut_ij)
                                     {
-                                    patch_field_energy_diff -= this->m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
+                                    patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), h_diameter.data[j], h_charge.data[j]);
                                     }
                                 }
                             }
@@ -631,6 +627,10 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
             // and then exponentiating directly (rather than exp(-(U_new-U_old)))
             if (this->m_patch && !this->m_patch_log && accept)
                 {
+                patch_field_energy_diff -= patch_batch.energy(*this->m_patch, typ_i, quat<float>(shape_i.orientation),
+                    h_diameter.data[i], h_charge.data[i]);
+                patch_batch.clear();
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + this->m_image_list[cur_image];
@@ -679,15 +679,7 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                                     unsigned int typ_j = __scalar_as_int(postype_j.w);
                                     Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
                                     if (dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
-                                        patch_field_energy_diff += this->m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
+                                        patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j), h_diameter.data[j], h_charge.data[j]);
                                     }
                                 }
                             }
@@ -698,6 +690,9 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                patch_field_energy_diff += patch_batch.energy(*this->m_patch, typ_i, quat<float>(orientation_i),
+                    h_diameter.data[i], h_charge.data[i]);
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -815,8 +810,8 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     // migrate and exchange particles
     this->communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
-    this->m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit
+    this->m_aabb_tree_refit = true;
     }
 
 
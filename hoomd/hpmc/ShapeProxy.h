@@ -442,6 +442,9 @@ typename ShapeUnion<Shape>::param_type make_union_params(pybind11::list _members
     // set the diameter
     result.diameter = diameter;
 
+    // precompute the distance field for fast rejection of non-overlapping pairs
+    result.buildDistanceField();
+
     // build tree and store GPU accessible version in parameter structure
     typedef typename ShapeUnion<Shape>::param_type::gpu_tree_type gpu_tree_type;
     OBBTree tree;
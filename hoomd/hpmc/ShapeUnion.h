@@ -26,7 +26,9 @@
 #else
 #define DEVICE
 #define HOSTDEVICE
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #endif
 
 //#define SHAPE_UNION_LEAVES_AGAINST_TREE_TRAVERSAL
@@ -46,7 +48,7 @@ struct union_params : param_base
 
     //! Default constructor
     DEVICE union_params()
-        : diameter(0.0), N(0), ignore(0)
+        : diameter(0.0), N(0), ignore(0), distance_dim(0), distance_scale(0.0)
         { }
 
     //! Load dynamic data members into shared memory and increase pointer
@@ -79,13 +81,96 @@ struct union_params : param_base
     #ifndef NVCC
     //! Shape constructor
     union_params(unsigned int _N, bool _managed)
-        : N(_N)
+        : N(_N), distance_dim(0), distance_scale(0.0)
         {
         mpos = ManagedArray<vec3<OverlapReal> >(N,_managed);
         morientation = ManagedArray<quat<OverlapReal> >(N,_managed);
         mparams = ManagedArray<mparam_type>(N,_managed);
         moverlap = ManagedArray<unsigned int>(N,_managed);
         }
+
+    //! Build the distance field of the member shapes
+    /*! \param max_dim Maximum number of grid cells along each direction
+
+        Stores a lower bound of the distance to the circumspheres of the members on a regular grid that covers the
+        circumsphere of the union, in the body frame. The grid spacing is half of the smallest member circumsphere
+        radius, up to \a max_dim cells along each direction. Call after all members and the diameter are set.
+    */
+    void buildDistanceField(unsigned int max_dim=32)
+        {
+        OverlapReal R = diameter/OverlapReal(2.0);
+        if (N == 0 || R <= OverlapReal(0.0))
+            {
+            distance_field = ManagedArray<float>();
+            distance_dim = 0;
+            return;
+            }
+
+        std::vector<OverlapReal> radius(N);
+        OverlapReal min_radius = R;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Shape shape(quat<Scalar>(), mparams[i]);
+            radius[i] = shape.getCircumsphereDiameter()/OverlapReal(2.0);
+            min_radius = std::min(min_radius, radius[i]);
+            }
+
+        OverlapReal dim = std::ceil(OverlapReal(4.0)*R/std::max(min_radius, R/OverlapReal(max_dim)));
+        distance_dim = std::max(std::min((unsigned int)dim, max_dim), 1u);
+        OverlapReal h = OverlapReal(2.0)*R/OverlapReal(distance_dim);
+        distance_scale = OverlapReal(1.0)/h;
+
+        distance_field = ManagedArray<float>(distance_dim*distance_dim*distance_dim, mpos.isManaged());
+        for (unsigned int k = 0; k < distance_dim; k++)
+            for (unsigned int j = 0; j < distance_dim; j++)
+                for (unsigned int i = 0; i < distance_dim; i++)
+                    {
+                    vec3<OverlapReal> r(-R + (OverlapReal(i)+OverlapReal(0.5))*h,
+                                        -R + (OverlapReal(j)+OverlapReal(0.5))*h,
+                                        -R + (OverlapReal(k)+OverlapReal(0.5))*h);
+
+                    OverlapReal d = R + sqrt(dot(r,r));
+                    for (unsigned int m = 0; m < N; m++)
+                        {
+                        vec3<OverlapReal> dr = r - mpos[m];
+                        d = std::min(d, sqrt(dot(dr,dr)) - radius[m]);
+                        }
+
+                    distance_field[(k*distance_dim + j)*distance_dim + i] = float(d);
+                    }
+        }
+
+    //! Get a lower bound of the distance of a point to the member shapes
+    /*! \param r Point in the body frame
+        \returns A lower bound of the distance to the closest member shape (negative values mean no bound)
+
+        The bound is lowered by a margin of 1e-5 R to cover the rounding of the single precision field and of the
+        distance computations, so that callers can compare it against circumsphere radii directly.
+    */
+    OverlapReal getDistanceBound(const vec3<OverlapReal>& r) const
+        {
+        OverlapReal R = diameter/OverlapReal(2.0);
+        OverlapReal margin = OverlapReal(1e-5)*R;
+        OverlapReal fx = (r.x + R)*distance_scale;
+        OverlapReal fy = (r.y + R)*distance_scale;
+        OverlapReal fz = (r.z + R)*distance_scale;
+        OverlapReal n = OverlapReal(distance_dim);
+
+        // outside of the grid, the members are inside the circumsphere
+        if (!(fx >= OverlapReal(0.0) && fx < n && fy >= OverlapReal(0.0) && fy < n
+            && fz >= OverlapReal(0.0) && fz < n))
+            return sqrt(dot(r,r)) - R - margin;
+
+        unsigned int i = (unsigned int)fx;
+        unsigned int j = (unsigned int)fy;
+        unsigned int k = (unsigned int)fz;
+
+        // the distance changes at most as much as the distance to the cell center
+        vec3<OverlapReal> dc(fx - (OverlapReal(i)+OverlapReal(0.5)),
+                             fy - (OverlapReal(j)+OverlapReal(0.5)),
+                             fz - (OverlapReal(k)+OverlapReal(0.5)));
+        return distance_field[(k*distance_dim + j)*distance_dim + i] - sqrt(dot(dc,dc))/distance_scale - margin;
+        }
     #endif
 
     gpu_tree_type tree;                      //!< OBB tree for constituent shapes
@@ -96,6 +181,9 @@ struct union_params : param_base
     OverlapReal diameter;                    //!< Precalculated overall circumsphere diameter
     unsigned int N;                           //!< Number of member shapes
     unsigned int ignore;                     //!<  Bitwise ignore flag for stats. 1 will ignore, 0 will not ignore
+    ManagedArray<float> distance_field;       //!< Lower bound of the distance to the members on a grid (host only)
+    unsigned int distance_dim;                //!< Number of grid cells of the distance field along each direction
+    OverlapReal distance_scale;               //!< Inverse grid spacing of the distance field
     } __attribute__((aligned(32)));
 
 } // end namespace detail
@@ -249,6 +337,44 @@ DEVICE inline bool test_narrow_phase_overlap(vec3<OverlapReal> dr,
     return false;
     }
 
+#ifndef NVCC
+//! Test if the members of one shape are separated from another shape by the distance field of the latter
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape, with a distance field
+    \returns true if no member of \a a can overlap with \a b
+
+    The test is conservative: it may return false for shapes that do not overlap.
+*/
+template<class Shape>
+inline bool test_distance_field_separation(const vec3<Scalar>& r_ab,
+                                           const ShapeUnion<Shape>& a,
+                                           const ShapeUnion<Shape>& b)
+    {
+    // position and orientation of a in the body frame of b
+    quat<OverlapReal> q(conj(quat<OverlapReal>(b.orientation))*quat<OverlapReal>(a.orientation));
+    vec3<OverlapReal> dr(rotate(conj(quat<OverlapReal>(b.orientation)), -vec3<OverlapReal>(r_ab)));
+
+    // the whole shape
+    if (b.members.getDistanceBound(dr) > a.members.diameter/OverlapReal(2.0))
+        return true;
+
+    rotmat3<OverlapReal> rot(q);
+    for (unsigned int i = 0; i < a.members.N; i++)
+        {
+        if (!a.members.moverlap[i])
+            continue;
+
+        Shape shape_i(quat<Scalar>(), a.members.mparams[i]);
+        vec3<OverlapReal> pos_i = rot*a.members.mpos[i] + dr;
+        if (b.members.getDistanceBound(pos_i) <= shape_i.getCircumsphereDiameter()/OverlapReal(2.0))
+            return false;
+        }
+
+    return true;
+    }
+#endif
+
 template <class Shape >
 DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                                 const ShapeUnion<Shape>& a,
@@ -258,6 +384,21 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     const detail::GPUTree& tree_a = a.members.tree;
     const detail::GPUTree& tree_b = b.members.tree;
 
+    #ifndef NVCC
+    // reject pairs early by testing the members of the shape with fewer members against the distance field of
+    // the other shape
+    if (b.members.distance_dim && (a.members.N <= b.members.N || !a.members.distance_dim))
+        {
+        if (test_distance_field_separation(r_ab, a, b))
+            return false;
+        }
+    else if (a.members.distance_dim)
+        {
+        if (test_distance_field_separation(-r_ab, b, a))
+            return false;
+        }
+    #endif
+
     #ifdef SHAPE_UNION_LEAVES_AGAINST_TREE_TRAVERSAL
     #ifdef NVCC
     // Parallel tree traversal
@@ -18,9 +18,11 @@
 #include "HPMCCounters.h"
 #include "IntegratorHPMCMono.h"
 
+#include <atomic>
+#include <memory>
+
 #ifdef ENABLE_TBB
 #include <tbb/tbb.h>
-#include <atomic>
 #endif
 
 namespace hpmc
@@ -29,216 +31,156 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
+//! Connected components of an undirected graph
+/*! Graph finds the connected components of a graph with a union-find (disjoint set) data structure. The edges are
+    not stored, addEdge() merges the sets of its two vertices right away. addEdge() may be called concurrently from
+    multiple threads: the parent links are only changed with atomic compare and swap operations, and paths are
+    compressed by path halving.
+
+    The root with the larger index is always linked to the one with the smaller index, so every set is represented
+    by its smallest vertex. connectedComponents() lists the components in the order of their smallest vertex,
+    independent of the order in which the edges were added.
+*/
+class Graph
     {
     public:
         //! Default constructor
-        my_atomic_flag()
+        Graph()
+            : m_n(0), m_capacity(0)
             {
-            f.clear();
             }
 
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
-            {
-            f.clear();
-            }
-
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
-            }
-
-        //! Sets flag and returns old value
-        bool test_and_set()
-            {
-            return f.test_and_set();
-            }
-
-    private:
-        std::atomic_flag f;
-    };
-#endif
-
-// Graph class represents a undirected graph
-// using adjacency list representation
-class Graph
-    {
-    public:
-        Graph() {}      //!< Default constructor
-
-        inline Graph(unsigned int V);   // Constructor
+        //! Constructor
+        /*! \param V Number of vertices
+        */
+        inline Graph(unsigned int V);
 
+        //! Remove all edges and set the number of vertices
         inline void resize(unsigned int V);
 
+        //! Add an undirected edge
         inline void addEdge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
-        inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
+        //! Get the connected components
+        inline void connectedComponents(std::vector<unsigned int>& cc_start, std::vector<unsigned int>& cc);
 
     private:
-        #ifndef ENABLE_TBB
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
-
-        #ifndef ENABLE_TBB
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
-
-        #ifndef ENABLE_TBB
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
+        std::unique_ptr< std::atomic<unsigned int>[] > m_parent; //!< Parent of every vertex in its set
+        unsigned int m_n;                                          //!< Number of vertices
+        unsigned int m_capacity;                                   //!< Capacity of m_parent
 
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
+        //! Find the root of the set of a vertex
+        inline unsigned int find(unsigned int v);
+    };
 
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB
+Graph::Graph(unsigned int V)
+    : m_n(0), m_capacity(0)
+    {
+    resize(V);
+    }
 
-    };
+/*! \param V Number of vertices
 
-// Gather connected components in an undirected graph
-#ifdef ENABLE_TBB
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
-void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
+    Every vertex is in a set of its own.
+*/
+void Graph::resize(unsigned int V)
     {
-    #ifdef ENABLE_TBB
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    if (V > m_capacity)
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
+        m_parent.reset(new std::atomic<unsigned int>[V]);
+        m_capacity = V;
         }
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
-        {
-        if (visited[v] == false)
-            {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
-            }
-        }
-    #endif
+    m_n = V;
+    for (unsigned int v = 0; v < m_n; ++v)
+        m_parent[v].store(v, std::memory_order_relaxed);
     }
 
-#ifndef ENABLE_TBB
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
+/*! \param v Vertex
+    \returns The smallest vertex in the set of \a v
+*/
+unsigned int Graph::find(unsigned int v)
     {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
+    while (true)
         {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
+        unsigned int parent = m_parent[v].load(std::memory_order_relaxed);
+        if (parent == v)
+            return v;
+
+        unsigned int grandparent = m_parent[parent].load(std::memory_order_relaxed);
+        if (grandparent == parent)
+            return parent;
+
+        // path halving, fails harmlessly if another thread has changed the link already
+        m_parent[v].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+        v = grandparent;
         }
     }
-#endif
-Graph::Graph(unsigned int V)
+
+/*! \param v First vertex
+    \param w Second vertex
+
+    Merges the sets of \a v and \a w. Thread safe.
+*/
+void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    #ifndef ENABLE_TBB
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
+    while (true)
+        {
+        v = find(v);
+        w = find(w);
+        if (v == w)
+            return;
+
+        if (v < w)
+            std::swap(v, w);
+
+        // link the larger root, unless another thread has linked it in the meantime
+        unsigned int expected = v;
+        if (m_parent[v].compare_exchange_strong(expected, w, std::memory_order_relaxed))
+            return;
+        }
     }
 
-void Graph::resize(unsigned int V)
+/*! \param cc_start Output: index of the first vertex of every component in \a cc, plus one past the end
+    \param cc Output: vertices sorted by component, in increasing order within each component
+
+    Must not be called concurrently with addEdge().
+*/
+void Graph::connectedComponents(std::vector<unsigned int>& cc_start, std::vector<unsigned int>& cc)
     {
-    #ifndef ENABLE_TBB
-    visited.resize(V, 0);
+    std::vector<unsigned int> component(m_n);
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, m_n, [&](unsigned int v)
+        {
+        component[v] = find(v);
+        });
     #else
-    visited.clear();
-    visited.resize(V);
+    for (unsigned int v = 0; v < m_n; ++v)
+        component[v] = find(v);
     #endif
 
-    adj.clear();
-    }
+    // number the components by their smallest vertex, the root precedes all other vertices of its set
+    unsigned int n_components = 0;
+    for (unsigned int v = 0; v < m_n; ++v)
+        {
+        if (component[v] == v)
+            component[v] = n_components++;
+        else
+            component[v] = component[component[v]];
+        }
 
-// method to add an undirected edge
-void Graph::addEdge(unsigned int v, unsigned int w)
-    {
-    adj.insert(std::make_pair(v,w));
-    adj.insert(std::make_pair(w,v));
+    // sort the vertices by component
+    cc_start.assign(n_components+1, 0);
+    for (unsigned int v = 0; v < m_n; ++v)
+        cc_start[component[v]+1]++;
+    for (unsigned int c = 0; c < n_components; ++c)
+        cc_start[c+1] += cc_start[c];
+
+    cc.resize(m_n);
+    std::vector<unsigned int> pos(cc_start.begin(), cc_start.end()-1);
+    for (unsigned int v = 0; v < m_n; ++v)
+        cc[pos[component[v]]++] = v;
     }
 } // end namespace detail
 
@@ -425,16 +367,13 @@ class UpdaterClusters : public Updater
         Scalar m_swap_move_ratio;                   //!< Type swap / geometric move ratio
         Scalar m_flip_probability;                  //!< Cluster flip probability
 
-        #ifdef ENABLE_TBB
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
-        std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
+        std::vector<unsigned int> m_cluster_start;      //!< First entry of every cluster in m_clusters (plus one past the end)
+        std::vector<unsigned int> m_clusters;           //!< Particles sorted by cluster
 
         detail::Graph m_G; //!< The graph
 
         unsigned int m_n_particles_old;                //!< Number of local particles in the old configuration
-        detail::AABBTree m_aabb_tree_old;              //!< Locality lookup for old configuration
+        detail::AABBTreeWide m_aabb_tree_old;          //!< Locality lookup for old configuration
         std::vector<Scalar4> m_postype_backup;         //!< Old local positions
         std::vector<Scalar4> m_orientation_backup;     //!< Old local orientations
         std::vector<Scalar> m_diameter_backup;         //!< Old local diameters
@@ -570,7 +509,7 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
     unsigned int nptl = m_pdata->getN();
 
     // locality data in new configuration
-    const detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
+    const detail::AABBTreeWide& aabb_tree = m_mc->buildAABBTree();
 
     // access particle data
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -580,6 +519,13 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
 
+    // leaf nodes of the AABB tree found by a query
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific< std::vector<unsigned int> > hits_tls;
+    #else
+    std::vector<unsigned int> hits;
+    #endif
+
     if (patch)
         {
         // test old configuration against itself
@@ -589,6 +535,10 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
         for (unsigned int i = 0; i < m_n_particles_old; ++i)
         #endif
             {
+            #ifdef ENABLE_TBB
+            std::vector<unsigned int>& hits = hits_tls.local();
+            #endif
+
             unsigned int typ_i = __scalar_as_int(m_postype_backup[i].w);
 
             vec3<Scalar> pos_i(m_postype_backup[i]);
@@ -611,90 +561,81 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                 detail::AABB aabb_i_image = aabb_local;
                 aabb_i_image.translate(pos_i_image);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
+                // find the leaf nodes of the old tree that overlap
+                hits.clear();
+                m_aabb_tree_old.queryNodes(hits, aabb_i_image);
+                for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                     {
-                    if (detail::overlap(m_aabb_tree_old.getNodeAABB(cur_node_idx), aabb_i_image))
+                    unsigned int cur_node_idx = hits[cur_hit];
+                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
+                        // read in its position and orientation
+                        unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
+
+                        if (m_tag_backup[i] == m_tag_backup[j] && cur_image == 0) continue;
+
+                        // load the position and orientation of the j particle
+                        vec3<Scalar> pos_j = vec3<Scalar>(m_postype_backup[j]);
+                        unsigned int typ_j = __scalar_as_int(m_postype_backup[j].w);
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = pos_j - pos_i_image;
+                        Scalar rsq_ij = dot(r_ij, r_ij);
+
+                        Scalar rcut_ij = r_cut_patch + extent_i + 0.5*patch->getAdditiveCutoff(typ_j);
+
+                        if (rsq_ij <= rcut_ij*rcut_ij)
                             {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
+                            // the particle pair
+                            unsigned int new_tag_i;
                                 {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
-
-                                if (m_tag_backup[i] == m_tag_backup[j] && cur_image == 0) continue;
-
-                                // load the position and orientation of the j particle
-                                vec3<Scalar> pos_j = vec3<Scalar>(m_postype_backup[j]);
-                                unsigned int typ_j = __scalar_as_int(m_postype_backup[j].w);
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = pos_j - pos_i_image;
-                                Scalar rsq_ij = dot(r_ij, r_ij);
-
-                                Scalar rcut_ij = r_cut_patch + extent_i + 0.5*patch->getAdditiveCutoff(typ_j);
-
-                                if (rsq_ij <= rcut_ij*rcut_ij)
-                                    {
-                                    // the particle pair
-                                    unsigned int new_tag_i;
-                                        {
-                                        auto it = map.find(m_tag_backup[i]);
-                                        assert(it != map.end());
-                                        new_tag_i = it->second;
-                                        }
-
-                                    unsigned int new_tag_j;
-                                        {
-                                        auto it = map.find(m_tag_backup[j]);
-                                        assert(it!=map.end());
-                                        new_tag_j = it->second;
-                                        }
-                                    auto p = std::make_pair(new_tag_i,new_tag_j);
-
-                                    // if particle interacts in different image already, add to that energy
-                                    float U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_old_old.find(p);
-                                        if (it_energy != m_energy_old_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += patch->energy(r_ij, typ_i,
-                                                        quat<float>(orientation_i),
-                                                        d_i,
-                                                        charge_i,
-                                                        typ_j,
-                                                        quat<float>(m_orientation_backup[j]),
-                                                        m_diameter_backup[j],
-                                                        m_charge_backup[j]);
-
-                                    // update map
-                                    m_energy_old_old[p] = U;
-
-                                    int3 delta_img = m_image_backup[i] - m_image_backup[j];
-                                    bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
-                                    interacts_via_pbc |= cur_image != 0;
-
-                                    if (line && !swap && interacts_via_pbc)
-                                        {
-                                        // if interaction across PBC, reject cluster move
-                                        m_local_reject.insert(new_tag_i);
-                                        m_local_reject.insert(new_tag_j);
-                                        }
-                                    } // end if overlap
-
-                                } // end loop over AABB tree leaf
-                            } // end is leaf
-                        } // end if overlap
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
-                        }
+                                auto it = map.find(m_tag_backup[i]);
+                                assert(it != map.end());
+                                new_tag_i = it->second;
+                                }
+
+                            unsigned int new_tag_j;
+                                {
+                                auto it = map.find(m_tag_backup[j]);
+                                assert(it!=map.end());
+                                new_tag_j = it->second;
+                                }
+                            auto p = std::make_pair(new_tag_i,new_tag_j);
+
+                            // if particle interacts in different image already, add to that energy
+                            float U = 0.0;
+                                {
+                                auto it_energy = m_energy_old_old.find(p);
+                                if (it_energy != m_energy_old_old.end())
+                                    U = it_energy->second;
+                                }
+
+                            U += patch->energy(r_ij, typ_i,
+                                                quat<float>(orientation_i),
+                                                d_i,
+                                                charge_i,
+                                                typ_j,
+                                                quat<float>(m_orientation_backup[j]),
+                                                m_diameter_backup[j],
+                                                m_charge_backup[j]);
 
-                    } // end loop over nodes
+                            // update map
+                            m_energy_old_old[p] = U;
+
+                            int3 delta_img = m_image_backup[i] - m_image_backup[j];
+                            bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
+                            interacts_via_pbc |= cur_image != 0;
+
+                            if (line && !swap && interacts_via_pbc)
+                                {
+                                // if interaction across PBC, reject cluster move
+                                m_local_reject.insert(new_tag_i);
+                                m_local_reject.insert(new_tag_j);
+                                }
+                            } // end if overlap
+
+                        } // end loop over AABB tree leaf
+                    } // end loop over hits
 
                 } // end loop over images
 
@@ -711,6 +652,10 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
     for (unsigned int i = 0; i < nptl; ++i)
     #endif
         {
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int>& hits = hits_tls.local();
+        #endif
+
         unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
 
         vec3<Scalar> pos_i_new(h_postype.data[i]);
@@ -733,79 +678,70 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
             detail::AABB aabb_i_image = aabb_i_local;
             aabb_i_image.translate(pos_i_image);
 
-            // stackless search
-            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
+            // find the leaf nodes of the old tree that overlap
+            hits.clear();
+            m_aabb_tree_old.queryNodes(hits, aabb_i_image);
+            for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                 {
-                if (detail::overlap(m_aabb_tree_old.getNodeAABB(cur_node_idx), aabb_i_image))
+                unsigned int cur_node_idx = hits[cur_hit];
+                for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
                     {
-                    if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
+                    // read in its position and orientation
+                    unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
+
+                    unsigned int new_tag_j;
                         {
-                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
-                            {
-                            // read in its position and orientation
-                            unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
+                        auto it = map.find(m_tag_backup[j]);
+                        assert(it != map.end());
+                        new_tag_j = it->second;
+                        }
 
-                            unsigned int new_tag_j;
-                                {
-                                auto it = map.find(m_tag_backup[j]);
-                                assert(it != map.end());
-                                new_tag_j = it->second;
-                                }
+                    if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
+
+                    // load the position and orientation of the j particle
+                    vec3<Scalar> pos_j = vec3<Scalar>(m_postype_backup[j]);
+                    unsigned int typ_j = __scalar_as_int(m_postype_backup[j].w);
+                    Shape shape_j(quat<Scalar>(m_orientation_backup[j]), params[typ_j]);
 
-                            if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
+                    // put particles in coordinate system of particle i
+                    vec3<Scalar> r_ij = pos_j - pos_i_image;
 
-                            // load the position and orientation of the j particle
-                            vec3<Scalar> pos_j = vec3<Scalar>(m_postype_backup[j]);
-                            unsigned int typ_j = __scalar_as_int(m_postype_backup[j].w);
-                            Shape shape_j(quat<Scalar>(m_orientation_backup[j]), params[typ_j]);
+                    // check for circumsphere overlap
+                    Scalar r_excl_j = shape_j.getCircumsphereDiameter()/Scalar(2.0);
+                    Scalar RaRb = r_excl_i + r_excl_j;
+                    Scalar rsq_ij = dot(r_ij, r_ij);
 
-                            // put particles in coordinate system of particle i
-                            vec3<Scalar> r_ij = pos_j - pos_i_image;
+                    unsigned int err = 0;
+                    if (rsq_ij <= RaRb*RaRb)
+                        {
+                        if (h_overlaps.data[overlap_idx(typ_i,typ_j)]
+                            && test_overlap(r_ij, shape_i, shape_j, err))
+                            {
+
+                            int3 delta_img = h_image.data[i] - m_image_backup[j];
+                            bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
+                            interacts_via_pbc |= cur_image != 0;
 
-                            // check for circumsphere overlap
-                            Scalar r_excl_j = shape_j.getCircumsphereDiameter()/Scalar(2.0);
-                            Scalar RaRb = r_excl_i + r_excl_j;
-                            Scalar rsq_ij = dot(r_ij, r_ij);
+                            bool reject = (line &&!swap) && interacts_via_pbc;
 
-                            unsigned int err = 0;
-                            if (rsq_ij <= RaRb*RaRb)
+                            if (swap && ((typ_i != m_ab_types[0] && typ_i != m_ab_types[1])
+                                || (typ_j != m_ab_types[0] && typ_j != m_ab_types[1])))
+                                reject = true;
+
+                            // add connection
+                            m_overlap.push_back(std::make_pair(h_tag.data[i],new_tag_j));
+
+                            if (reject)
                                 {
-                                if (h_overlaps.data[overlap_idx(typ_i,typ_j)]
-                                    && test_overlap(r_ij, shape_i, shape_j, err))
-                                    {
-
-                                    int3 delta_img = h_image.data[i] - m_image_backup[j];
-                                    bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
-                                    interacts_via_pbc |= cur_image != 0;
-
-                                    bool reject = (line &&!swap) && interacts_via_pbc;
-
-                                    if (swap && ((typ_i != m_ab_types[0] && typ_i != m_ab_types[1])
-                                        || (typ_j != m_ab_types[0] && typ_j != m_ab_types[1])))
-                                        reject = true;
-
-                                    // add connection
-                                    m_overlap.push_back(std::make_pair(h_tag.data[i],new_tag_j));
-
-                                    if (reject)
-                                        {
-                                        // if interaction across PBC, reject cluster move
-                                        m_local_reject.insert(h_tag.data[i]);
-                                        m_local_reject.insert(new_tag_j);
-                                        }
-                                    } // end if overlap
+                                // if interaction across PBC, reject cluster move
+                                m_local_reject.insert(h_tag.data[i]);
+                                m_local_reject.insert(new_tag_j);
                                 }
+                            } // end if overlap
+                        }
 
-                            } // end loop over AABB tree leaf
-                        } // end is leaf
-                    } // end if overlap
-                else
-                    {
-                    // skip ahead
-                    cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
-                    }
-
-                } // end loop over nodes
+                    } // end loop over AABB tree leaf
+                } // end loop over hits
             } // end loop over images
 
         if (patch)
@@ -823,83 +759,74 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                 detail::AABB aabb_i_image = aabb_local;
                 aabb_i_image.translate(pos_i_image);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
+                // find the leaf nodes of the old tree that overlap
+                hits.clear();
+                m_aabb_tree_old.queryNodes(hits, aabb_i_image);
+                for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                     {
-                    if (detail::overlap(m_aabb_tree_old.getNodeAABB(cur_node_idx), aabb_i_image))
+                    unsigned int cur_node_idx = hits[cur_hit];
+                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
+                        // read in its position and orientation
+                        unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
+
+                        unsigned int new_tag_j;
+                            {
+                            auto it = map.find(m_tag_backup[j]);
+                            assert(it != map.end());
+                            new_tag_j = it->second;
+                            }
+
+                        if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
+
+                        vec3<Scalar> pos_j(m_postype_backup[j]);
+                        unsigned int typ_j = __scalar_as_int(m_postype_backup[j].w);
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = pos_j - pos_i_image;
+
+                        // check for excluded volume sphere overlap
+                        Scalar rsq_ij = dot(r_ij, r_ij);
+
+                        Scalar rcut_ij = r_cut_patch + extent_i + 0.5*patch->getAdditiveCutoff(typ_j);
+
+                        if (rsq_ij <= rcut_ij*rcut_ij)
                             {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
+                            auto p = std::make_pair(h_tag.data[i], new_tag_j);
+
+                            // if particle interacts in different image already, add to that energy
+                            float U = 0.0;
                                 {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
-
-                                unsigned int new_tag_j;
-                                    {
-                                    auto it = map.find(m_tag_backup[j]);
-                                    assert(it != map.end());
-                                    new_tag_j = it->second;
-                                    }
-
-                                if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
-
-                                vec3<Scalar> pos_j(m_postype_backup[j]);
-                                unsigned int typ_j = __scalar_as_int(m_postype_backup[j].w);
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = pos_j - pos_i_image;
-
-                                // check for excluded volume sphere overlap
-                                Scalar rsq_ij = dot(r_ij, r_ij);
-
-                                Scalar rcut_ij = r_cut_patch + extent_i + 0.5*patch->getAdditiveCutoff(typ_j);
-
-                                if (rsq_ij <= rcut_ij*rcut_ij)
-                                    {
-                                    auto p = std::make_pair(h_tag.data[i], new_tag_j);
-
-                                    // if particle interacts in different image already, add to that energy
-                                    float U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_new_old.find(p);
-                                        if (it_energy != m_energy_new_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += patch->energy(r_ij, typ_i,
-                                                            quat<float>(shape_i.orientation),
-                                                            h_diameter.data[i],
-                                                            h_charge.data[i],
-                                                            typ_j,
-                                                            quat<float>(m_orientation_backup[j]),
-                                                            m_diameter_backup[j],
-                                                            m_charge_backup[j]);
-
-                                    // update map
-                                    m_energy_new_old[p] = U;
-
-                                    int3 delta_img = h_image.data[i] - m_image_backup[j];
-                                    bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
-                                    interacts_via_pbc |= cur_image != 0;
-
-                                    if (line && !swap && interacts_via_pbc)
-                                        {
-                                        // if interaction across PBC, reject cluster move
-                                        m_local_reject.insert(h_tag.data[i]);
-                                        m_local_reject.insert(new_tag_j);
-                                        }
-                                    }
-                                } // end loop over AABB tree leaf
-                            } // end is leaf
-                        } // end if overlap
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
-                        }
+                                auto it_energy = m_energy_new_old.find(p);
+                                if (it_energy != m_energy_new_old.end())
+                                    U = it_energy->second;
+                                }
 
-                    } // end loop over nodes
+                            U += patch->energy(r_ij, typ_i,
+                                                    quat<float>(shape_i.orientation),
+                                                    h_diameter.data[i],
+                                                    h_charge.data[i],
+                                                    typ_j,
+                                                    quat<float>(m_orientation_backup[j]),
+                                                    m_diameter_backup[j],
+                                                    m_charge_backup[j]);
+
+                            // update map
+                            m_energy_new_old[p] = U;
+
+                            int3 delta_img = h_image.data[i] - m_image_backup[j];
+                            bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
+                            interacts_via_pbc |= cur_image != 0;
+
+                            if (line && !swap && interacts_via_pbc)
+                                {
+                                // if interaction across PBC, reject cluster move
+                                m_local_reject.insert(h_tag.data[i]);
+                                m_local_reject.insert(new_tag_j);
+                                }
+                            }
+                        } // end loop over AABB tree leaf
+                    } // end loop over hits
 
                 } // end loop over images
             } // end if patch
@@ -917,6 +844,10 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
         for (unsigned int i = 0; i < nptl; ++i)
         #endif
             {
+            #ifdef ENABLE_TBB
+            std::vector<unsigned int>& hits = hits_tls.local();
+            #endif
+
             unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
 
             vec3<Scalar> pos_i_new(h_postype.data[i]);
@@ -944,69 +875,60 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                 detail::AABB aabb_i_image = aabb_i;
                 aabb_i_image.translate(image_list[cur_image]);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes(); cur_node_idx++)
+                // find the leaf nodes of the new tree that overlap
+                hits.clear();
+                aabb_tree.queryNodes(hits, aabb_i_image);
+                for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                     {
-                    if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb_i_image))
+                    unsigned int cur_node_idx = hits[cur_hit];
+                    for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (aabb_tree.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                // no trivial bonds
-                                if (h_tag.data[i] == h_tag.data[j]) continue;
+                        // read in its position and orientation
+                        unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                                // load the position and orientation of the j particle
-                                vec3<Scalar> pos_j = vec3<Scalar>(h_postype.data[j]);
-                                unsigned int typ_j = __scalar_as_int(h_postype.data[j].w);
-                                Shape shape_j(quat<Scalar>(h_orientation.data[j]), params[typ_j]);
+                        // no trivial bonds
+                        if (h_tag.data[i] == h_tag.data[j]) continue;
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = pos_j - pos_i_image;
+                        // load the position and orientation of the j particle
+                        vec3<Scalar> pos_j = vec3<Scalar>(h_postype.data[j]);
+                        unsigned int typ_j = __scalar_as_int(h_postype.data[j].w);
+                        Shape shape_j(quat<Scalar>(h_orientation.data[j]), params[typ_j]);
 
-                                // check for circumsphere overlap
-                                Scalar r_excl_j = shape_j.getCircumsphereDiameter()/Scalar(2.0);
-                                Scalar RaRb = r_excl_i + r_excl_j;
-                                Scalar rsq_ij = dot(r_ij, r_ij);
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = pos_j - pos_i_image;
 
-                                Scalar rcut_ij = 0.0;
-                                if (patch)
-                                    rcut_ij = r_cut_patch + extent_i + 0.5*patch->getAdditiveCutoff(typ_j);
+                        // check for circumsphere overlap
+                        Scalar r_excl_j = shape_j.getCircumsphereDiameter()/Scalar(2.0);
+                        Scalar RaRb = r_excl_i + r_excl_j;
+                        Scalar rsq_ij = dot(r_ij, r_ij);
 
-                                bool interact_patch = patch && rsq_ij <= rcut_ij*rcut_ij;
+                        Scalar rcut_ij = 0.0;
+                        if (patch)
+                            rcut_ij = r_cut_patch + extent_i + 0.5*patch->getAdditiveCutoff(typ_j);
 
-                                unsigned int err = 0;
+                        bool interact_patch = patch && rsq_ij <= rcut_ij*rcut_ij;
 
-                                if (interact_patch || (rsq_ij <= RaRb*RaRb && h_overlaps.data[overlap_idx(typ_i,typ_j)]
-                                        && test_overlap(r_ij, shape_i, shape_j, err)))
-                                    {
-                                    int3 delta_img = h_image.data[i] - h_image.data[j];
-                                    bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
-                                    interacts_via_pbc |= cur_image != 0;
+                        unsigned int err = 0;
 
-                                    if (interacts_via_pbc)
-                                        {
-                                        // add to reject list
-                                        m_local_reject.insert(h_tag.data[i]);
-                                        m_local_reject.insert(h_tag.data[j]);
+                        if (interact_patch || (rsq_ij <= RaRb*RaRb && h_overlaps.data[overlap_idx(typ_i,typ_j)]
+                                && test_overlap(r_ij, shape_i, shape_j, err)))
+                            {
+                            int3 delta_img = h_image.data[i] - h_image.data[j];
+                            bool interacts_via_pbc = delta_img.x || delta_img.y || delta_img.z;
+                            interacts_via_pbc |= cur_image != 0;
 
-                                        m_interact_new_new.insert(std::make_pair(h_tag.data[i],h_tag.data[j]));
-                                        }
-                                    } // end if overlap
+                            if (interacts_via_pbc)
+                                {
+                                // add to reject list
+                                m_local_reject.insert(h_tag.data[i]);
+                                m_local_reject.insert(h_tag.data[j]);
 
-                                } // end loop over AABB tree leaf
-                            } // end is leaf
-                        } // end if overlap
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                        }
+                                m_interact_new_new.insert(std::make_pair(h_tag.data[i],h_tag.data[j]));
+                                }
+                            } // end if overlap
 
-                    } // end loop over nodes
+                        } // end loop over AABB tree leaf
+                    } // end loop over hits
                 } // end loop over images
             } // end loop over local particles
         #ifdef ENABLE_TBB
@@ -1653,30 +1575,32 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
 
         if (this->m_prof) this->m_prof->push("connected components");
         // compute connected components
-        m_clusters.clear();
-        m_G.connectedComponents(m_clusters);
+        m_G.connectedComponents(m_cluster_start, m_clusters);
         if (this->m_prof) this->m_prof->pop();
 
         if (this->m_prof) this->m_prof->push("reject");
 
         // move every cluster independently
-        m_count_total.n_clusters += m_clusters.size();
+        unsigned int n_clusters = (unsigned int)m_cluster_start.size() - 1;
+        m_count_total.n_clusters += n_clusters;
 
-        for (unsigned int icluster = 0; icluster < m_clusters.size(); icluster++)
+        for (unsigned int icluster = 0; icluster < n_clusters; icluster++)
             {
-            m_count_total.n_particles_in_clusters += m_clusters[icluster].size();
+            const unsigned int first = m_cluster_start[icluster];
+            const unsigned int last = m_cluster_start[icluster+1];
+            m_count_total.n_particles_in_clusters += last - first;
 
             // if any particle in the cluster is rejected, the cluster is not transformed
             bool reject = false;
-            for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+            for (unsigned int k = first; k < last; ++k)
                 {
                 bool mpi = false;
                 #ifdef ENABLE_MPI
                 mpi = (bool)m_comm;
-                if (mpi && m_ptl_reject.find(*it) != m_ptl_reject.end())
+                if (mpi && m_ptl_reject.find(m_clusters[k]) != m_ptl_reject.end())
                     reject = true;
                 #endif
-                if (!mpi && m_local_reject.find(*it) != m_local_reject.end())
+                if (!mpi && m_local_reject.find(m_clusters[k]) != m_local_reject.end())
                     reject = true;
                 }
 
@@ -1688,9 +1612,9 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 int n_A_old = 0, n_A_new = 0;
                 int n_B_old = 0, n_B_new = 0;
 
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+                for (unsigned int k = first; k < last; ++k)
                     {
-                    unsigned int i = *it;
+                    unsigned int i = m_clusters[k];
                     if (snap.type[i] == m_ab_types[0])
                         n_A_new++;
                     if (snap_old.type[i] == m_ab_types[0])
@@ -1710,10 +1634,10 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
             if (reject || !flip)
                 {
                 // revert cluster
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+                for (unsigned int k = first; k < last; ++k)
                     {
                     // particle index
-                    unsigned int i = *it;
+                    unsigned int i = m_clusters[k];
 
                     snap.pos[i] = snap_old.pos[i];
                     snap.orientation[i] = snap_old.orientation[i];
@@ -1739,10 +1663,10 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 }
             else if (flip)
                 {
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+                for (unsigned int k = first; k < last; ++k)
                     {
                     // particle index
-                    unsigned int i = *it;
+                    unsigned int i = m_clusters[k];
 
                     if (swap)
                         {
@@ -14,6 +14,8 @@
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
 
+#include <map>
+
 namespace hpmc
 {
 
@@ -155,6 +157,16 @@ class UpdaterMuVT : public Updater
 
         unsigned int m_gibbs_other;                           //!< The root-rank of the other partition
 
+        //! Type ids of the other partitions, translated to local type ids (indexed by root-rank of the other partition)
+        std::map<unsigned int, std::vector<unsigned int> > m_gibbs_type_remap;
+
+        //! MPI tags of the messages exchanged during Gibbs ensemble transfer moves
+        enum
+            {
+            gibbs_tag_type = 2,     //!< Type of the particle being transferred
+            gibbs_tag_weight = 3    //!< Boltzmann weight of the removal
+            };
+
         hpmc_muvt_counters_t m_count_total;          //!< Accept/reject total count
         hpmc_muvt_counters_t m_count_run_start;      //!< Count saved at run() start
         hpmc_muvt_counters_t m_count_step_start;     //!< Count saved at the start of the last step
@@ -223,6 +235,11 @@ class UpdaterMuVT : public Updater
         //! Get number of particles of a given type
         unsigned int getNumParticlesType(unsigned int type);
 
+        #ifdef ENABLE_MPI
+        //! Exchange type names with the other Gibbs partition and build the type id translation table
+        void exchangeGibbsTypes();
+        #endif
+
     private:
         //! Handle MaxParticleNumberChange signal
         /*! Resize the m_pos_backup array
@@ -367,31 +384,25 @@ unsigned int UpdaterMuVT<Shape>::getNthTypeTag(unsigned int type, unsigned int t
         // get number of particles of given type
         unsigned int nptl = m_type_map[type].size();
 
-        // have to initialize correctly for prefix sum
+        // have to initialize correctly for prefix sum, the result of MPI_Exscan is undefined on rank 0
         unsigned int begin_offs=0;
-        unsigned int end_offs=0;
 
-        // exclusive scan
+        // exclusive scan, the end of the local range follows from the local count
         MPI_Exscan(&nptl, &begin_offs, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
-
-        // inclusive scan
-        MPI_Scan(&nptl, &end_offs, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        if (m_exec_conf->getRank() == 0)
+            begin_offs = 0;
+        unsigned int end_offs = begin_offs + nptl;
 
         bool is_local = type_offs >= begin_offs && type_offs < end_offs;
 
-        unsigned int rank = is_local ? m_exec_conf->getRank() : 0;
-
-        MPI_Allreduce(MPI_IN_PLACE, &rank, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
-        assert(rank == m_exec_conf->getRank() || !is_local);
-
-        // broadcast the chosen particle tag
+        // the owner contributes the chosen particle tag, a single reduction distributes it to all ranks
         if (is_local)
             {
             assert(type_offs - begin_offs < m_type_map[type].size());
             tag = m_type_map[type][type_offs - begin_offs];
             }
 
-        MPI_Bcast(&tag, 1, MPI_UNSIGNED, rank, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &tag, 1, MPI_UNSIGNED, MPI_MIN, m_exec_conf->getMPICommunicator());
         }
     else
     #endif
@@ -426,8 +437,58 @@ void UpdaterMuVT<Shape>::slotNumTypesChange()
     // resize parameter list
     m_fugacity.resize(m_pdata->getNTypes(), std::shared_ptr<Variant>(new VariantConst(0.0)));
     m_type_map.resize(m_pdata->getNTypes());
+
+    // type ids need to be translated again
+    m_gibbs_type_remap.clear();
     }
 
+#ifdef ENABLE_MPI
+/*! The type names of both partitions are exchanged once (on the root ranks), so that transfer moves only need to
+    communicate a type id instead of a serialized type name.
+ */
+template<class Shape>
+void UpdaterMuVT<Shape>::exchangeGibbsTypes()
+    {
+    // pack local type names into a single buffer
+    std::vector<char> names;
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        {
+        std::string name = m_pdata->getNameByType(i);
+        names.insert(names.end(), name.begin(), name.end());
+        names.push_back('\0');
+        }
+
+    unsigned int n = names.size();
+    unsigned int n_other = 0;
+    MPI_Sendrecv(&n, 1, MPI_UNSIGNED, m_gibbs_other, 0,
+        &n_other, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
+
+    std::vector<char> names_other(n_other);
+    MPI_Sendrecv(names.data(), n, MPI_CHAR, m_gibbs_other, 0,
+        names_other.data(), n_other, MPI_CHAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
+
+    // resolve the type names of the other partition
+    std::vector<unsigned int>& remap = m_gibbs_type_remap[m_gibbs_other];
+    remap.clear();
+    for (unsigned int offs = 0; offs < n_other; )
+        {
+        std::string name(&names_other[offs]);
+        offs += name.size() + 1;
+
+        unsigned int type = UINT_MAX;
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            {
+            if (m_pdata->getNameByType(i) == name)
+                {
+                type = i;
+                break;
+                }
+            }
+        remap.push_back(type);
+        }
+    }
+#endif
+
 /*! Set new box and scale positions
 */
 template<class Shape>
@@ -545,19 +606,19 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
 
         if (active && m_exec_conf->getRank() == 0)
             {
-            unsigned int other_timestep = 0;
-            // make sure random seeds are equal
-            if (mod == 0)
-                {
-                MPI_Status stat;
-                MPI_Recv(&other_timestep, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                MPI_Send(&timestep, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                }
-            else
+            // make sure random seeds are equal, and find out if either box still needs to translate type ids
+            unsigned int sync[2];
+            sync[0] = timestep;
+            sync[1] = m_gibbs_type_remap.count(m_gibbs_other) ? 0 : 1;
+
+            unsigned int sync_other[2];
+            MPI_Sendrecv(sync, 2, MPI_UNSIGNED, m_gibbs_other, 0,
+                sync_other, 2, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
+            unsigned int other_timestep = sync_other[0];
+
+            if (other_timestep == timestep && (sync[1] || sync_other[1]))
                 {
-                MPI_Status stat;
-                MPI_Send(&timestep, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                MPI_Recv(&other_timestep, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
+                exchangeGibbsTypes();
                 }
 
             if (other_timestep != timestep)
@@ -591,7 +652,6 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                 {
                 // Try inserting a particle
                 unsigned int type = 0;
-                std::string type_name;
                 Scalar lnboltzmann(0.0);
 
                 unsigned int nptl_type = 0;
@@ -610,17 +670,20 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     if (is_root)
                         {
                         #ifdef ENABLE_MPI
-                        MPI_Status stat;
-
                         // receive type of particle
-                        unsigned int n;
-                        MPI_Recv(&n, 1, MPI_UNSIGNED, m_gibbs_other,0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                        char s[n];
-                        MPI_Recv(s, n, MPI_CHAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                        type_name = std::string(s);
-
-                        // resolve type name
-                        type = m_pdata->getTypeByName(type_name);
+                        unsigned int other_type;
+                        MPI_Recv(&other_type, 1, MPI_UNSIGNED, m_gibbs_other, gibbs_tag_type,
+                            m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
+
+                        // translate to the local type id
+                        const std::vector<unsigned int>& remap = m_gibbs_type_remap[m_gibbs_other];
+                        type = other_type < remap.size() ? remap[other_type] : UINT_MAX;
+                        if (type == UINT_MAX)
+                            {
+                            m_exec_conf->msg->error() << "UpdaterMuVT: Particle type " << other_type
+                                << " of the other box does not exist in this box." << std::endl;
+                            throw std::runtime_error("Error in update.muvt.");
+                            }
                         #endif
                         }
 
@@ -674,6 +737,17 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                         lnboltzmann = log(fugacity*V/(Scalar)(nptl_type+1));
                         }
 
+                    #ifdef ENABLE_MPI
+                    // the other box computes the removal weight while we test the insertion
+                    Scalar remove_weight[2];
+                    MPI_Request remove_req;
+                    if (m_gibbs && is_root)
+                        {
+                        MPI_Irecv(remove_weight, 2, MPI_HOOMD_SCALAR, m_gibbs_other, gibbs_tag_weight,
+                            m_exec_conf->getHOOMDWorldMPICommunicator(), &remove_req);
+                        }
+                    #endif
+
                     // check if particle can be inserted without overlaps
                     Scalar lnb(0.0);
                     unsigned int nonzero = tryInsertParticle(timestep, type, pos_test, shape_test.orientation, lnb);
@@ -686,17 +760,13 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     #ifdef ENABLE_MPI
                     if (m_gibbs && is_root)
                         {
-                        // receive Boltzmann factor for removal from other rank
-                        MPI_Status stat;
-                        Scalar remove_lnb;
-                        unsigned int remove_nonzero;
-                        MPI_Recv(&remove_lnb, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                        MPI_Recv(&remove_nonzero, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
+                        // wait for Boltzmann factor for removal from other rank
+                        MPI_Wait(&remove_req, MPI_STATUS_IGNORE);
 
                         // avoid divide/multiply by infinity
-                        if (remove_nonzero)
+                        if (remove_weight[1] != Scalar(0.0))
                             {
-                            lnboltzmann += remove_lnb;
+                            lnboltzmann += remove_weight[0];
                             }
                         else
                             {
@@ -767,6 +837,16 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                 assert(m_transfer_types.size() > 0);
                 unsigned int type = m_transfer_types[rand_select(rng_local, m_transfer_types.size()-1)];
 
+                #ifdef ENABLE_MPI
+                // send particle type to other rank right away, so it can start the insertion attempt
+                MPI_Request type_req;
+                if (m_gibbs && is_root)
+                    {
+                    MPI_Isend(&type, 1, MPI_UNSIGNED, m_gibbs_other, gibbs_tag_type,
+                        m_exec_conf->getHOOMDWorldMPICommunicator(), &type_req);
+                    }
+                #endif
+
                 // choose a random particle of that type
                 unsigned int nptl_type = getNumParticlesType(type);
 
@@ -794,23 +874,6 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
 
                     lnboltzmann -= log(fugacity);
                     }
-                else
-                    {
-                    if (is_root)
-                        {
-                        #ifdef ENABLE_MPI
-                        // determine type name
-                        std::string type_name = m_pdata->getNameByType(type);
-
-                        // send particle type to other rank
-                        unsigned int n = type_name.size()+1;
-                        MPI_Send(&n, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                        char s[n];
-                        memcpy(s,type_name.c_str(),n);
-                        MPI_Send(s, n, MPI_CHAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                        #endif
-                        }
-                    }
 
                 // acceptance probability
                 unsigned int nonzero = 1;
@@ -841,15 +904,15 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     if (is_root)
                         {
                         #ifdef ENABLE_MPI
-                        // send result of removal attempt
-                        MPI_Send(&lnboltzmann, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                        MPI_Send(&nonzero, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-
-                        // wait for result of insertion on other rank
+                        // send result of removal attempt and wait for result of insertion on other rank
+                        Scalar remove_weight[2] = {lnboltzmann, Scalar(nonzero)};
                         unsigned int result;
-                        MPI_Status stat;
-                        MPI_Recv(&result, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
+                        MPI_Sendrecv(remove_weight, 2, MPI_HOOMD_SCALAR, m_gibbs_other, gibbs_tag_weight,
+                            &result, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(),
+                            MPI_STATUS_IGNORE);
                         accept = result;
+
+                        MPI_Wait(&type_req, MPI_STATUS_IGNORE);
                         #endif
                         }
                     }
@@ -920,8 +983,8 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     if (m_gibbs && is_root)
                         {
                         // communicate type pair to other box
-                        MPI_Send(&type, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                        MPI_Send(&other_type, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
+                        unsigned int type_pair[2] = {type, other_type};
+                        MPI_Send(type_pair, 2, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
                         }
                     #endif
 
@@ -965,23 +1028,20 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     #ifdef ENABLE_MPI
                     if (m_gibbs)
                         {
-                        unsigned int other_nonzero = 0;
-                        Scalar lnb;
+                        // non-zero flag and Boltzmann weight of the identity change in the other box
+                        Scalar other_weight[2] = {Scalar(0.0), Scalar(0.0)};
                         if (is_root)
                             {
                             // receive result of identity change from other box
-                            MPI_Status stat;
-                            MPI_Recv(&other_nonzero, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                            MPI_Recv(&lnb, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
+                            MPI_Recv(other_weight, 2, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
                             }
                         if (m_pdata->getDomainDecomposition())
                             {
-                            MPI_Bcast(&other_nonzero, 1, MPI_UNSIGNED, 0, m_exec_conf->getMPICommunicator());
-                            MPI_Bcast(&lnb, 1, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
+                            MPI_Bcast(other_weight, 2, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
                             }
-                        if (other_nonzero)
+                        if (other_weight[0] != Scalar(0.0))
                             {
-                            lnboltzmann += lnb;
+                            lnboltzmann += other_weight[1];
                             }
                         else
                             {
@@ -1025,21 +1085,20 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     // slave
                     assert(m_gibbs);
 
-                    unsigned int type=0, other_type=0;
+                    unsigned int type_pair[2] = {0, 0};
                     #ifdef ENABLE_MPI
                     if (is_root)
                         {
-                        MPI_Status stat;
-                        MPI_Recv(&type, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                        MPI_Recv(&other_type, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
+                        MPI_Recv(type_pair, 2, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
                         }
 
                     if (m_pdata->getDomainDecomposition())
                         {
-                        MPI_Bcast(&type, 1, MPI_UNSIGNED, 0, m_exec_conf->getMPICommunicator());
-                        MPI_Bcast(&other_type, 1, MPI_UNSIGNED, 0, m_exec_conf->getMPICommunicator());
+                        MPI_Bcast(type_pair, 2, MPI_UNSIGNED, 0, m_exec_conf->getMPICommunicator());
                         }
                     #endif
+                    unsigned int type = type_pair[0];
+                    unsigned int other_type = type_pair[1];
 
                     // get number of particles of both types
                     unsigned int N_old = getNumParticlesType(other_type);
@@ -1087,12 +1146,11 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                     #ifdef ENABLE_MPI
                     if (is_root)
                         {
-                        MPI_Send(&nonzero, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                        MPI_Send(&lnboltzmann, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-
-                        // receive result of decision from other box
-                        MPI_Status stat;
-                        MPI_Recv(&accept, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
+                        // send result of identity change and receive result of decision from other box
+                        Scalar weight[2] = {Scalar(nonzero), lnboltzmann};
+                        MPI_Sendrecv(weight, 2, MPI_HOOMD_SCALAR, m_gibbs_other, 0,
+                            &accept, 1, MPI_UNSIGNED, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(),
+                            MPI_STATUS_IGNORE);
                         }
 
                     if (m_pdata->getDomainDecomposition())
@@ -1137,25 +1195,9 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
         Scalar V_new,V_new_other;
         if (is_root)
             {
-            if (mod == 0)
-                {
-                // send volume to other rank
-                MPI_Send(&V, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-
-                MPI_Status stat;
-
-                // receive other box volume
-                MPI_Recv(&V_other, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-                }
-            else
-                {
-                // receive other box volume
-                MPI_Status stat;
-                MPI_Recv(&V_other, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), &stat);
-
-                // send volume to other rank
-                MPI_Send(&V, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator());
-                }
+            // exchange box volumes
+            MPI_Sendrecv(&V, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0,
+                &V_other, 1, MPI_HOOMD_SCALAR, m_gibbs_other, 0, m_exec_conf->getHOOMDWorldMPICommunicator(), MPI_STATUS_IGNORE);
 
             if (mod == 0)
                 {
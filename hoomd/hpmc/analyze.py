@@ -22,6 +22,7 @@ class sdf(_analyzer):
         period (int): Number of timesteps between histogram evaluations.
         overwrite (bool): Set to True to overwrite *filename* instead of appending to it.
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        binary (bool): Set to True to write the histograms in binary format instead of text.
 
     :py:class:`sdf` computes a distribution function of scale parameters :math:`x`. For each particle, it finds the smallest
     scale factor :math:`1+x` that would cause the particle to touch one of its neighbors and records that in the histogram
@@ -47,6 +48,13 @@ class sdf(_analyzer):
     :py:class:`sdf` averages *navg* histograms together before writing them out to a
     text file in a plain format: "timestep bin_0 bin_1 bin_2 .... bin_n".
 
+    With ``binary=True``, each line is instead written as a record of 64-bit floating point numbers in native byte
+    order (timestep, bin_0, bin_1, ...). Read it with ``numpy.fromfile(filename).reshape(-1, nbins+1)``, where
+    ``nbins = int(xmax/dx)`` is the number of bins. The binary format avoids the cost of formatting the text in
+    frequent evaluations.
+
+    In builds with TBB, :py:class:`sdf` processes the particles on multiple CPU threads.
+
     :py:class:`sdf` works well with restartable jobs. Ensure that ``navg*period`` is an integer fraction :math:`1/k` of the
     restart period. Then :py:class:`sdf` will have written the final output to its file just before the restart gets
     written. The new data needed for the next line of values is entirely collected after the restart.
@@ -72,8 +80,9 @@ class sdf(_analyzer):
         mc = hpmc.integrate.sphere(seed=415236)
         analyze.sdf(mc=mc, filename='sdf.dat', xmax=0.02, dx=1e-4, navg=100, period=100)
         analyze.sdf(mc=mc, filename='sdf.dat', xmax=0.002, dx=1e-5, navg=100, period=100)
+        analyze.sdf(mc=mc, filename='sdf.bin', xmax=0.02, dx=1e-4, navg=10, period=10, binary=True)
     """
-    def __init__(self, mc, filename, xmax, dx, navg, period, overwrite=False, phase=0):
+    def __init__(self, mc, filename, xmax, dx, navg, period, overwrite=False, phase=0, binary=False):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -105,7 +114,8 @@ class sdf(_analyzer):
                                 dx,
                                 navg,
                                 filename,
-                                overwrite);
+                                overwrite,
+                                binary);
 
         self.setupAnalyzer(period, phase);
 
@@ -116,4 +126,5 @@ class sdf(_analyzer):
         self.navg = navg
         self.period = period
         self.overwrite = overwrite
-        self.metadata_fields = ['filename', 'xmax', 'dx', 'navg', 'period', 'overwrite']
+        self.binary = binary
+        self.metadata_fields = ['filename', 'xmax', 'dx', 'navg', 'period', 'overwrite', 'binary']
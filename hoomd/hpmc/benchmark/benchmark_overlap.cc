@@ -0,0 +1,471 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file benchmark_overlap.cc
+    \brief Measures the throughput of the HPMC pair overlap checks
+
+    For every shape and size, a batch of random pair configurations is generated close to contact, with a given
+    fraction of overlapping pairs. The batch is checked repeatedly with test_overlap() and the number of overlap
+    checks per second is reported, one line per shape, size, and overlap fraction. The measured fraction of
+    overlapping pairs is printed next to the requested one, so that a change in the results of the overlap check
+    shows up as well.
+
+    Usage: benchmark_overlap [--shape name] [--size n] [--fraction f] [--pairs n] [--time seconds] [--seed n]
+
+    --shape, --size, and --fraction may be given multiple times. The size is the number of vertices of the
+    polyhedra, the number of planes of the faceted sphere, and the number of spheres of the sphinx.
+*/
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+#include "hoomd/hpmc/Moves.h"
+#include "hoomd/hpmc/OBBTree.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+#include "hoomd/hpmc/ShapePolyhedron.h"
+#include "hoomd/hpmc/ShapeEllipsoid.h"
+#include "hoomd/hpmc/ShapeFacetedEllipsoid.h"
+#include "hoomd/hpmc/ShapeSphinx.h"
+
+#include "hoomd/extern/quickhull/QuickHull.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+
+//! Benchmark options
+struct Options
+    {
+    std::vector<std::string> shapes;   //!< Shapes to benchmark (all when empty)
+    std::vector<unsigned int> sizes;   //!< Shape sizes to benchmark (defaults of each shape when empty)
+    std::vector<Scalar> fractions;     //!< Fractions of overlapping pairs
+    unsigned int n_pairs;              //!< Number of pair configurations in a batch
+    Scalar min_time;                   //!< Minimum time to check overlaps for, in seconds
+    unsigned int seed;                 //!< Random number seed
+
+    //! Set the defaults
+    Options()
+        : n_pairs(10000), min_time(0.5), seed(42)
+        { }
+
+    //! Test if a shape was selected
+    bool hasShape(const std::string& name) const
+        {
+        if (shapes.size() == 0)
+            return true;
+        for (auto it = shapes.begin(); it != shapes.end(); ++it)
+            if (*it == name)
+                return true;
+        return false;
+        }
+    };
+
+//! Relative position and orientations of a pair of shapes
+struct PairConfiguration
+    {
+    vec3<Scalar> r_ab;         //!< Position of b relative to a
+    quat<Scalar> orientation_a; //!< Orientation of a
+    quat<Scalar> orientation_b; //!< Orientation of b
+    };
+
+//! Draw random points on the unit sphere
+std::vector< vec3<OverlapReal> > generateSpherePoints(unsigned int n, unsigned int seed)
+    {
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::BenchmarkOverlapShapes, seed);
+    hoomd::SpherePointGenerator<OverlapReal> gen;
+
+    std::vector< vec3<OverlapReal> > points(n);
+    for (unsigned int i = 0; i < n; i++)
+        gen(rng, points[i]);
+    return points;
+    }
+
+//! Build the parameters of a convex polyhedron (with optional sweep radius) from vertices on the unit sphere
+poly3d_verts makeConvexPolyhedron(unsigned int n_verts, OverlapReal sweep_radius, unsigned int seed)
+    {
+    std::vector< vec3<OverlapReal> > points = generateSpherePoints(n_verts, seed);
+
+    poly3d_verts result(n_verts, false);
+    result.N = n_verts;
+    result.sweep_radius = sweep_radius;
+    result.ignore = 0;
+
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < n_verts; i++)
+        {
+        result.x[i] = points[i].x;
+        result.y[i] = points[i].y;
+        result.z[i] = points[i].z;
+        radius_sq = std::max(radius_sq, dot(points[i], points[i]));
+        }
+    result.diameter = 2*(sqrt(radius_sq) + sweep_radius);
+
+    return result;
+    }
+
+//! Build the parameters of a general polyhedron from the triangulated convex hull of vertices on the unit sphere
+ShapePolyhedron::param_type makePolyhedron(unsigned int n_verts, unsigned int seed)
+    {
+    std::vector< vec3<OverlapReal> > points = generateSpherePoints(n_verts, seed);
+
+    typedef quickhull::Vector3<OverlapReal> vec;
+    std::vector<vec> qh_pts;
+    for (auto it = points.begin(); it != points.end(); ++it)
+        qh_pts.push_back(vec(it->x, it->y, it->z));
+
+    quickhull::QuickHull<OverlapReal> qh;
+    auto hull = qh.getConvexHull(qh_pts, true, false);
+    auto indexBuffer = hull.getIndexBuffer();
+    auto vertexBuffer = hull.getVertexBuffer();
+
+    unsigned int n_hull_verts = vertexBuffer.size();
+    unsigned int n_faces = indexBuffer.size()/3;
+    if (n_faces == 0)
+        throw std::runtime_error("Error computing the convex hull of the polyhedron");
+
+    ShapePolyhedron::param_type result = poly3d_data(n_hull_verts, n_faces, 3*n_faces, n_hull_verts, false);
+    result.ignore = 0;
+    result.sweep_radius = result.convex_hull_verts.sweep_radius = OverlapReal(0.0);
+    result.n_verts = n_hull_verts;
+    result.n_faces = n_faces;
+    result.origin = vec3<OverlapReal>(0,0,0);
+    result.hull_only = 0;
+
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < n_hull_verts; i++)
+        {
+        vec3<OverlapReal> v(vertexBuffer[i].x, vertexBuffer[i].y, vertexBuffer[i].z);
+        result.verts[i] = v;
+        result.convex_hull_verts.x[i] = v.x;
+        result.convex_hull_verts.y[i] = v.y;
+        result.convex_hull_verts.z[i] = v.z;
+        radius_sq = std::max(radius_sq, dot(v, v));
+        }
+
+    for (unsigned int i = 0; i < n_faces; i++)
+        {
+        result.face_offs[i] = 3*i;
+        result.face_overlap[i] = 1;
+        for (unsigned int j = 0; j < 3; j++)
+            result.face_verts[3*i+j] = indexBuffer[3*i+j];
+        }
+    result.face_offs[n_faces] = 3*n_faces;
+
+    // construct the bounding box tree of the faces
+    hpmc::detail::OBB *obbs = new hpmc::detail::OBB[n_faces];
+    std::vector<std::vector<vec3<OverlapReal> > > internal_coordinates;
+    for (unsigned int i = 0; i < n_faces; ++i)
+        {
+        std::vector<vec3<OverlapReal> > face_vec;
+        for (unsigned int j = result.face_offs[i]; j < result.face_offs[i+1]; ++j)
+            face_vec.push_back(result.verts[result.face_verts[j]]);
+
+        std::vector<OverlapReal> vertex_radii(face_vec.size(), result.sweep_radius);
+        obbs[i] = hpmc::detail::compute_obb(face_vec, vertex_radii, false);
+        obbs[i].mask = result.face_overlap[i];
+        internal_coordinates.push_back(face_vec);
+        }
+
+    OBBTree tree;
+    tree.buildTree(obbs, internal_coordinates, result.sweep_radius, n_faces, 4);
+    result.tree = GPUTree(tree, false);
+    delete [] obbs;
+
+    result.convex_hull_verts.diameter = 2*sqrt(radius_sq);
+
+    return result;
+    }
+
+//! Build the parameters of a unit sphere cut by planes with random normals
+faceted_ellipsoid_params makeFacetedSphere(unsigned int n_planes, unsigned int seed)
+    {
+    std::vector< vec3<OverlapReal> > normals = generateSpherePoints(n_planes, seed);
+    const OverlapReal offset(-0.8);
+
+    faceted_ellipsoid_params result(n_planes, false);
+    result.ignore = 0;
+    result.origin = vec3<OverlapReal>(0,0,0);
+    for (unsigned int i = 0; i < n_planes; i++)
+        {
+        result.n[i] = normals[i];
+        result.offset[i] = offset;
+        }
+
+    // the vertices of the polyhedron are the intersections of three planes that lie inside all other planes
+    std::vector< vec3<OverlapReal> > verts;
+    for (unsigned int i = 0; i < n_planes; i++)
+        for (unsigned int j = i+1; j < n_planes; j++)
+            for (unsigned int k = j+1; k < n_planes; k++)
+                {
+                vec3<OverlapReal> c_jk = cross(normals[j], normals[k]);
+                OverlapReal det = dot(normals[i], c_jk);
+                if (fabs(det) < OverlapReal(1e-6))
+                    continue;
+
+                vec3<OverlapReal> v = -offset*(c_jk + cross(normals[k], normals[i])
+                    + cross(normals[i], normals[j]))/det;
+
+                bool inside = true;
+                for (unsigned int l = 0; l < n_planes; l++)
+                    {
+                    if (dot(normals[l], v) + offset > OverlapReal(1e-5))
+                        {
+                        inside = false;
+                        break;
+                        }
+                    }
+                if (inside)
+                    verts.push_back(v);
+                }
+
+    result.verts = poly3d_verts(verts.size(), false);
+    result.verts.N = verts.size();
+    for (unsigned int i = 0; i < verts.size(); i++)
+        {
+        result.verts.x[i] = verts[i].x;
+        result.verts.y[i] = verts[i].y;
+        result.verts.z[i] = verts[i].z;
+        }
+
+    // add the edge-sphere vertices
+    ShapeFacetedEllipsoid::initializeVertices(result, false);
+
+    return result;
+    }
+
+//! Build the parameters of a unit sphere with spherical dimples cut out by negative spheres
+sphinx3d_params makeSphinx(unsigned int n_spheres, unsigned int seed)
+    {
+    if (n_spheres == 0 || n_spheres > MAX_SPHERE_CENTERS)
+        throw std::runtime_error("Invalid number of sphinx spheres");
+
+    std::vector< vec3<OverlapReal> > directions = generateSpherePoints(n_spheres, seed);
+
+    sphinx3d_params result;
+    result.N = n_spheres;
+    result.ignore = 0;
+    result.circumsphereDiameter = OverlapReal(2.0);
+    for (unsigned int i = 0; i < MAX_SPHERE_CENTERS; i++)
+        {
+        result.diameter[i] = OverlapReal(0.0);
+        result.center[i] = vec3<OverlapReal>(0,0,0);
+        }
+
+    // the positive sphere at the origin
+    result.diameter[0] = OverlapReal(2.0);
+
+    // negative spheres that cut into it
+    for (unsigned int i = 1; i < n_spheres; i++)
+        {
+        result.diameter[i] = OverlapReal(-2.2);
+        result.center[i] = OverlapReal(1.6)*directions[i];
+        }
+
+    return result;
+    }
+
+//! Generate pair configurations near contact with the given fraction of overlapping pairs
+/*! \param params Shape parameters
+    \param fraction Fraction of pairs that overlap
+    \param options Benchmark options
+
+    Each pair is placed along a random direction at the contact distance found by bisection, and then moved by
+    up to 5% of this distance towards or away from each other.
+*/
+template<class Shape>
+std::vector<PairConfiguration> generatePairs(const typename Shape::param_type& params, Scalar fraction,
+    const Options& options)
+    {
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::BenchmarkOverlapPairs, options.seed);
+    hoomd::SpherePointGenerator<Scalar> gen_direction;
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+
+    std::vector<PairConfiguration> pairs(options.n_pairs);
+    for (unsigned int i = 0; i < options.n_pairs; i++)
+        {
+        PairConfiguration& pair = pairs[i];
+        pair.orientation_a = generateRandomOrientation(rng);
+        pair.orientation_b = generateRandomOrientation(rng);
+
+        vec3<Scalar> direction;
+        gen_direction(rng, direction);
+
+        Shape a(pair.orientation_a, params);
+        Shape b(pair.orientation_b, params);
+
+        // bisect the contact distance
+        Scalar r_min(0.0);
+        Scalar r_max = a.getCircumsphereDiameter();
+        unsigned int err = 0;
+        for (unsigned int j = 0; j < 32; j++)
+            {
+            Scalar r = (r_min + r_max)/Scalar(2.0);
+            if (test_overlap(r*direction, a, b, err))
+                r_min = r;
+            else
+                r_max = r;
+            }
+
+        Scalar shift = Scalar(0.05)*uniform(rng);
+        Scalar r = (uniform(rng) < fraction) ? r_min*(Scalar(1.0) - shift) : r_max*(Scalar(1.0) + shift);
+        pair.r_ab = r*direction;
+        }
+
+    return pairs;
+    }
+
+//! Measure and print the throughput of test_overlap() for one shape
+/*! \param name Name of the shape
+    \param size Number of vertices, planes or spheres
+    \param params Shape parameters
+    \param options Benchmark options
+*/
+template<class Shape>
+void benchmark(const std::string& name, unsigned int size, const typename Shape::param_type& params,
+    const Options& options)
+    {
+    for (auto it = options.fractions.begin(); it != options.fractions.end(); ++it)
+        {
+        std::vector<PairConfiguration> pairs = generatePairs<Shape>(params, *it, options);
+
+        unsigned int err = 0;
+        unsigned long int n_checks = 0;
+        unsigned long int n_overlap = 0;
+        std::chrono::duration<double> elapsed(0.0);
+        auto start = std::chrono::steady_clock::now();
+
+        do
+            {
+            for (auto pair = pairs.begin(); pair != pairs.end(); ++pair)
+                {
+                Shape a(pair->orientation_a, params);
+                Shape b(pair->orientation_b, params);
+                n_overlap += test_overlap(pair->r_ab, a, b, err);
+                }
+            n_checks += pairs.size();
+            elapsed = std::chrono::steady_clock::now() - start;
+            } while (elapsed.count() < options.min_time);
+
+        std::cout << std::left << std::setw(26) << name
+                  << std::right << std::setw(6) << size
+                  << std::setw(10) << std::fixed << std::setprecision(3) << *it
+                  << std::setw(10) << double(n_overlap)/double(n_checks)
+                  << std::setw(16) << std::setprecision(0) << double(n_checks)/elapsed.count()
+                  << std::endl;
+        }
+    }
+
+//! Print the usage
+void usage(const char *program)
+    {
+    std::cerr << "Usage: " << program << " [--shape name] [--size n] [--fraction f] [--pairs n] [--time seconds]"
+              << " [--seed n]" << std::endl;
+    std::cerr << "Shapes: convex_polyhedron convex_spheropolyhedron polyhedron ellipsoid faceted_sphere sphinx"
+              << std::endl;
+    }
+
+int main(int argc, char **argv)
+    {
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+        {
+        std::string arg(argv[i]);
+        if (arg == "--help" || arg == "-h")
+            {
+            usage(argv[0]);
+            return 0;
+            }
+        if (i+1 >= argc)
+            {
+            usage(argv[0]);
+            return 1;
+            }
+
+        std::string value(argv[++i]);
+        if (arg == "--shape")
+            options.shapes.push_back(value);
+        else if (arg == "--size")
+            options.sizes.push_back(std::stoul(value));
+        else if (arg == "--fraction")
+            options.fractions.push_back(std::stod(value));
+        else if (arg == "--pairs")
+            options.n_pairs = std::stoul(value);
+        else if (arg == "--time")
+            options.min_time = std::stod(value);
+        else if (arg == "--seed")
+            options.seed = std::stoul(value);
+        else
+            {
+            usage(argv[0]);
+            return 1;
+            }
+        }
+
+    if (options.fractions.size() == 0)
+        options.fractions = {0.0, 0.5, 1.0};
+
+    // default sizes of each shape
+    std::vector<unsigned int> vertex_counts{8, 16, 32, 64};
+    std::vector<unsigned int> plane_counts{4, 8, 16};
+    std::vector<unsigned int> sphere_counts{2, 3, 4};
+    if (options.sizes.size())
+        vertex_counts = plane_counts = sphere_counts = options.sizes;
+
+    std::cout << std::left << std::setw(26) << "# shape"
+              << std::right << std::setw(6) << "size"
+              << std::setw(10) << "fraction"
+              << std::setw(10) << "overlap"
+              << std::setw(16) << "checks/s" << std::endl;
+
+    try
+        {
+        for (auto n = vertex_counts.begin(); n != vertex_counts.end(); ++n)
+            {
+            if (options.hasShape("convex_polyhedron"))
+                benchmark<ShapeConvexPolyhedron>("convex_polyhedron", *n,
+                    makeConvexPolyhedron(*n, OverlapReal(0.0), options.seed), options);
+            if (options.hasShape("convex_spheropolyhedron"))
+                benchmark<ShapeSpheropolyhedron>("convex_spheropolyhedron", *n,
+                    makeConvexPolyhedron(*n, OverlapReal(0.1), options.seed), options);
+            if (options.hasShape("polyhedron"))
+                benchmark<ShapePolyhedron>("polyhedron", *n, makePolyhedron(*n, options.seed), options);
+            }
+
+        if (options.hasShape("ellipsoid"))
+            {
+            ell_params axes;
+            axes.x = OverlapReal(1.0);
+            axes.y = OverlapReal(0.7);
+            axes.z = OverlapReal(0.4);
+            axes.ignore = 0;
+            benchmark<ShapeEllipsoid>("ellipsoid", 0, axes, options);
+            }
+
+        for (auto n = plane_counts.begin(); n != plane_counts.end(); ++n)
+            if (options.hasShape("faceted_sphere"))
+                benchmark<ShapeFacetedEllipsoid>("faceted_sphere", *n, makeFacetedSphere(*n, options.seed), options);
+
+        for (auto n = sphere_counts.begin(); n != sphere_counts.end(); ++n)
+            if (options.hasShape("sphinx"))
+                benchmark<ShapeSphinx>("sphinx", *n, makeSphinx(*n, options.seed), options);
+        }
+    catch (std::exception& e)
+        {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+        }
+
+    return 0;
+    }
@@ -412,7 +412,8 @@ class mode_hpmc(_integrator):
                    nR=None,
                    depletant_type=None,
                    ntrial=None,
-                   deterministic=None):
+                   deterministic=None,
+                   checkerboard=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -425,9 +426,18 @@ class mode_hpmc(_integrator):
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
                 (Only supported with **depletant_mode='circumsphere'**)
             deterministic (bool): (if set) Make HPMC integration deterministic on the GPU by sorting the cell list.
+            checkerboard (bool): (if set) Run the trial moves on multiple CPU threads with a checkerboard
+                decomposition of the box (default: False).
 
         .. note:: Simulations are only deterministic with respect to the same execution configuration (CPU or GPU) and
                   number of MPI ranks. Simulation output will not be identical if either of these is changed.
+
+        With *checkerboard* set to True and more than one CPU thread (``--nthreads``), the box is divided into cells
+        at least as wide as the largest interaction range, and cells that cannot interact run their trial moves at
+        the same time. Like the GPU integrator, this changes the Markov chain: trial moves that leave the cell of the
+        particle are rejected, and the cell grid is shifted randomly every sweep. The result does not depend on the
+        number of threads, but differs from the result of the serial sweep. The checkerboard is not used with an
+        external field, with one thread, or when the box is too small for at least two cells per set.
         """
 
         hoomd.util.print_status_line();
@@ -479,6 +489,9 @@ class mode_hpmc(_integrator):
         if deterministic is not None:
             self.cpp_integrator.setDeterministic(deterministic);
 
+        if checkerboard is not None:
+            self.cpp_integrator.setCheckerboard(checkerboard);
+
     def map_overlaps(self):
         R""" Build an overlap map of the system
 
@@ -0,0 +1,80 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import hoomd
+import unittest
+import numpy
+
+context.initialize()
+
+# Tests the checkerboard decomposition of the CPU trial moves on multiple threads (set_params(checkerboard=True)).
+# Dense systems must stay free of overlaps, and the trajectory must not depend on the number of threads.
+
+cube_verts = [(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+              (0.5, -0.5, -0.5), (0.5, -0.5, 0.5), (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]
+
+@unittest.skipIf(not hoomd._hoomd.is_TBB_available() or hoomd.context.exec_conf.isCUDAEnabled(),
+                 "checkerboard trial moves run only on multiple CPU threads")
+class checkerboard_test(unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+
+    def make_mc(self, shape):
+        if shape == 'sphere':
+            system = init.create_lattice(unitcell=lattice.sc(a=1.02), n=8)
+            mc = hpmc.integrate.sphere(seed=10, d=0.1)
+            mc.shape_param.set('A', diameter=1.0)
+        else:
+            system = init.create_lattice(unitcell=lattice.sc(a=1.1), n=8)
+            mc = hpmc.integrate.convex_polyhedron(seed=10, d=0.05, a=0.05)
+            mc.shape_param.set('A', vertices=cube_verts)
+        return system, mc
+
+    # the checkerboard is opt-in
+    def test_default(self):
+        system, mc = self.make_mc('sphere')
+        self.assertFalse(mc.cpp_integrator.getCheckerboard())
+        mc.set_params(checkerboard=True)
+        self.assertTrue(mc.cpp_integrator.getCheckerboard())
+
+    # dense hard spheres and cubes stay free of overlaps
+    def test_overlaps(self):
+        for shape in ['sphere', 'cube']:
+            context.initialize()
+            hoomd.context.exec_conf.setNumThreads(4)
+            system, mc = self.make_mc(shape)
+            mc.set_params(checkerboard=True)
+
+            self.assertEqual(mc.count_overlaps(), 0)
+            run(100)
+            self.assertEqual(mc.count_overlaps(), 0)
+
+            translate_acceptance = mc.get_translate_acceptance()
+            self.assertGreater(translate_acceptance, 0)
+            self.assertLess(translate_acceptance, 1)
+
+    # the trajectory does not depend on the number of threads
+    def test_threads(self):
+        pos = []
+        orientation = []
+        for num_threads in [2, 4]:
+            context.initialize()
+            hoomd.context.exec_conf.setNumThreads(num_threads)
+            system, mc = self.make_mc('cube')
+            mc.set_params(checkerboard=True)
+            run(50)
+
+            snap = system.take_snapshot(all=True)
+            if comm.get_rank() == 0:
+                pos.append(numpy.array(snap.particles.position))
+                orientation.append(numpy.array(snap.particles.orientation))
+
+        if comm.get_rank() == 0:
+            numpy.testing.assert_array_equal(pos[0], pos[1])
+            numpy.testing.assert_array_equal(orientation[0], orientation[1])
+
+    def tearDown(self):
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,117 @@
+from __future__ import division
+from __future__ import print_function
+
+import hoomd
+from hoomd import context, data, init, analyze
+from hoomd import hpmc, jit
+
+import unittest
+import numpy as np
+
+context.initialize();
+
+# Tests that the batched patch energy evaluation (eval_batch) agrees with summed calls of eval
+class jit_patch_batch(unittest.TestCase):
+    def setUp(self):
+        self.r_cut = 2.5;
+        # an anisotropic interaction, so that the orientations of the neighbors enter the batch
+        self.code = """ float rsq = dot(r_ij, r_ij);
+                        if (rsq > {0}*{0})
+                            return 0.0f;
+                        vec3<float> pi = rotate(q_i, vec3<float>(1,0,0));
+                        vec3<float> pj = rotate(q_j, vec3<float>(1,0,0));
+                        return (1.0f + type_j + charge_i*charge_j) * dot(pi, pj) / (rsq * d_j);
+                    """.format(self.r_cut);
+
+        snap = data.make_snapshot(N=64, box=data.boxdim(L=8), particle_types=['A', 'B']);
+        if hoomd.comm.get_rank() == 0:
+            np.random.seed(10);
+            lattice = np.array([[x, y, z] for x in range(4) for y in range(4) for z in range(4)], dtype=float);
+            snap.particles.position[:] = (lattice - 1.5) * 2.0 + np.random.uniform(-0.3, 0.3, size=(64, 3));
+            q = np.random.normal(size=(64, 4));
+            snap.particles.orientation[:] = q / np.linalg.norm(q, axis=1)[:, np.newaxis];
+            snap.particles.typeid[:] = np.random.randint(0, 2, size=64);
+            snap.particles.charge[:] = np.random.uniform(-1, 1, size=64);
+            snap.particles.diameter[:] = np.random.uniform(0.5, 1.0, size=64);
+        self.system = init.read_snapshot(snap);
+
+        self.mc = hpmc.integrate.sphere(seed=10, d=0, a=0);
+        self.mc.shape_param.set('A', diameter=0.5, orientable=True);
+        self.mc.shape_param.set('B', diameter=0.5, orientable=True);
+        self.patch = jit.patch.user(mc=self.mc, r_cut=self.r_cut, code=self.code);
+
+    # energyBatch of one particle with a list of neighbors equals the sum of energy over the same neighbors
+    def test_energy_batch(self):
+        snap = self.system.take_snapshot();
+        if hoomd.comm.get_rank() != 0:
+            return;
+
+        pos = snap.particles.position;
+        L = snap.box.Lx;
+        q = [hoomd._hoomd.quat_float(float(o[0]), hoomd._hoomd.vec3_float(float(o[1]), float(o[2]), float(o[3])))
+             for o in snap.particles.orientation];
+        evaluator = self.patch.cpp_evaluator;
+
+        for i in range(len(pos)):
+            r_ij = [];
+            for j in range(len(pos)):
+                if j == i:
+                    continue;
+                dr = pos[j] - pos[i];
+                dr -= L * np.round(dr / L);
+                r_ij.append(hoomd._hoomd.vec3_float(float(dr[0]), float(dr[1]), float(dr[2])));
+            others = [j for j in range(len(pos)) if j != i];
+
+            args_i = (int(snap.particles.typeid[i]), q[i], float(snap.particles.diameter[i]),
+                      float(snap.particles.charge[i]));
+            type_j = [int(snap.particles.typeid[j]) for j in others];
+            q_j = [q[j] for j in others];
+            d_j = [float(snap.particles.diameter[j]) for j in others];
+            charge_j = [float(snap.particles.charge[j]) for j in others];
+
+            energy_sum = 0.0;
+            for k in range(len(others)):
+                energy_sum += evaluator.energy(r_ij[k], args_i[0], args_i[1], args_i[2], args_i[3],
+                                               type_j[k], q_j[k], d_j[k], charge_j[k]);
+
+            energy_batch = evaluator.energyBatch(r_ij, args_i[0], args_i[1], args_i[2], args_i[3],
+                                                 type_j, q_j, d_j, charge_j);
+            self.assertAlmostEqual(energy_batch, energy_sum, delta=1e-5 * max(1.0, abs(energy_sum)));
+
+        self.assertEqual(evaluator.energyBatch([], args_i[0], args_i[1], args_i[2], args_i[3], [], [], [], []), 0.0);
+
+    # the integrator, which evaluates neighbors in batches, logs the sum of the pair energies
+    def test_logged_energy(self):
+        log = analyze.log(filename=None, quantities=['hpmc_patch_energy'], period=None, overwrite=True);
+        hoomd.run(0, quiet=True);
+
+        snap = self.system.take_snapshot();
+        if hoomd.comm.get_rank() == 0:
+            pos = snap.particles.position;
+            L = snap.box.Lx;
+            q = [hoomd._hoomd.quat_float(float(o[0]), hoomd._hoomd.vec3_float(float(o[1]), float(o[2]), float(o[3])))
+                 for o in snap.particles.orientation];
+            expected = 0.0;
+            for i in range(len(pos)):
+                for j in range(i+1, len(pos)):
+                    dr = pos[j] - pos[i];
+                    dr -= L * np.round(dr / L);
+                    expected += self.patch.cpp_evaluator.energy(
+                        hoomd._hoomd.vec3_float(float(dr[0]), float(dr[1]), float(dr[2])),
+                        int(snap.particles.typeid[i]), q[i], float(snap.particles.diameter[i]),
+                        float(snap.particles.charge[i]),
+                        int(snap.particles.typeid[j]), q[j], float(snap.particles.diameter[j]),
+                        float(snap.particles.charge[j]));
+
+        energy = log.query('hpmc_patch_energy');
+        if hoomd.comm.get_rank() == 0:
+            self.assertAlmostEqual(energy, expected, delta=1e-4 * max(1.0, abs(expected)));
+
+    def tearDown(self):
+        del self.patch;
+        del self.mc;
+        del self.system;
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -170,6 +170,29 @@ class sdf_test1 (unittest.TestCase):
             invalid = numpy.abs(avg - v) > (8*err);
             self.assertEqual(numpy.sum(invalid), 0);
 
+    def test_sdf_binary(self):
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.hpmc-test-sdf-binary');
+            tmp_file_binary = tmp[1];
+        else:
+            tmp_file_binary = "invalid";
+
+        # write the same histograms in text and binary format
+        xmax=0.02
+        dx=1e-4
+        hpmc.analyze.sdf(mc=self.mc, filename=self.tmp_file, xmax=xmax, dx=dx, navg=20, period=10, phase=0, overwrite=True)
+        hpmc.analyze.sdf(mc=self.mc, filename=tmp_file_binary, xmax=xmax, dx=dx, navg=20, period=10, phase=0,
+                         overwrite=True, binary=True)
+
+        run(1000);
+
+        if comm.get_rank() == 0:
+            r = numpy.loadtxt(self.tmp_file);
+            r_binary = numpy.fromfile(tmp_file_binary).reshape(-1, avg.size+1);
+            self.assertEqual(r_binary.shape, r.shape);
+            numpy.testing.assert_allclose(r_binary, r, rtol=1e-12);
+            os.remove(tmp_file_binary);
+
     def tearDown(self):
         del self.mc
         del self.system
@@ -106,3 +106,180 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+//! Check that queries of the wide tree find the same particles as queries of the binary tree
+void check_wide_queries(const AABBTree& tree, const AABBTreeWide& wide_tree, hoomd::RandomGenerator& rng)
+    {
+    std::vector<unsigned int> hits, wide_hits;
+    for (unsigned int k = 0; k < 500; k++)
+        {
+        vec3<Scalar> p(hoomd::detail::generate_canonical<float>(rng),
+                       hoomd::detail::generate_canonical<float>(rng),
+                       hoomd::detail::generate_canonical<float>(rng));
+        AABB query(p * Scalar(1000), Scalar(5.0) + Scalar(50.0) * hoomd::detail::generate_canonical<float>(rng));
+
+        hits.clear();
+        tree.query(hits, query);
+        wide_hits.clear();
+        wide_tree.query(wide_hits, query);
+
+        std::sort(hits.begin(), hits.end());
+        std::sort(wide_hits.begin(), wide_hits.end());
+        UP_ASSERT(hits == wide_hits);
+        }
+    }
+
+UP_TEST( wide )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(2);
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    AABB wide_aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(1000);
+        aabbs[i] = wide_aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    AABBTreeWide wide_tree;
+    wide_tree.buildTree(wide_aabbs, N);
+
+    // the wide tree has fewer nodes than the binary tree
+    UP_ASSERT(wide_tree.getNumWideNodes() > 0);
+    UP_ASSERT(wide_tree.getNumWideNodes() < wide_tree.getNumNodes());
+
+    // every particle is found
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        wide_tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    check_wide_queries(tree, wide_tree, rng);
+
+    // move the points and update both trees
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng)) * Scalar(10);
+        tree.update(i, AABB(points[i], Scalar(1.0)));
+        wide_tree.update(i, AABB(points[i], Scalar(1.0)));
+        }
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        wide_tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    check_wide_queries(tree, wide_tree, rng);
+
+    // a tree with a single leaf
+    AABB small[3];
+    small[0] = AABB(vec3<Scalar>(0,0,0), Scalar(1.0));
+    small[1] = AABB(vec3<Scalar>(3,0,0), Scalar(1.0));
+    small[2] = AABB(vec3<Scalar>(6,0,0), Scalar(1.0));
+    AABBTreeWide small_tree;
+    small_tree.buildTree(small, 3);
+    hits.clear();
+    small_tree.query(hits, AABB(vec3<Scalar>(2,0,0), vec3<Scalar>(4,0.5,0.5)));
+    UP_ASSERT_EQUAL(hits.size(), 3);
+    hits.clear();
+    small_tree.query(hits, AABB(vec3<Scalar>(2,2,0), vec3<Scalar>(4,2.5,0.5)));
+    UP_ASSERT_EQUAL(hits.size(), 0);
+    }
+
+UP_TEST( refit )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(3);
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    AABB wide_aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(1000);
+        aabbs[i] = wide_aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    AABBTreeWide wide_tree;
+    wide_tree.buildTree(wide_aabbs, N);
+    Scalar build_cost = tree.getCost();
+    UP_ASSERT(build_cost > Scalar(0.0));
+
+    // move the points by a small amount and refit both trees
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5)) * Scalar(10);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(aabbs, N);
+    wide_tree.refit(aabbs, N);
+
+    // every particle is found and the trees agree
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        hits.clear();
+        wide_tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+    check_wide_queries(tree, wide_tree, rng);
+
+    // the nodes are shrunk to the new boxes
+    for (unsigned int node = 0; node < tree.getNumNodes(); node++)
+        {
+        if (!tree.isNodeLeaf(node))
+            continue;
+        AABB leaf_aabb = aabbs[tree.getNodeParticle(node, 0)];
+        for (unsigned int j = 1; j < tree.getNodeNumParticles(node); j++)
+            leaf_aabb = merge(leaf_aabb, aabbs[tree.getNodeParticle(node, j)]);
+        UP_ASSERT(contains(leaf_aabb, tree.getNodeAABB(node)));
+        UP_ASSERT(contains(tree.getNodeAABB(node), leaf_aabb));
+        }
+
+    // small moves keep the cost close to that of the build, random positions increase it
+    UP_ASSERT(tree.getCost() < Scalar(1.25)*build_cost);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(1000);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(aabbs, N);
+    wide_tree.refit(aabbs, N);
+    UP_ASSERT(tree.getCost() > Scalar(2.0)*build_cost);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        wide_tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+    check_wide_queries(tree, wide_tree, rng);
+    }
@@ -0,0 +1,144 @@
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/RandomNumbers.h"
+
+#include "hoomd/hpmc/UpdaterClusters.h"
+
+#include <iostream>
+#include <vector>
+#include <queue>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+using namespace std;
+using namespace hpmc;
+using namespace hpmc::detail;
+
+//! Check the connected components of a Graph against a breadth first search of the same edges
+void check_components(Graph& G, unsigned int V, const vector< pair<unsigned int, unsigned int> >& edges)
+    {
+    // reference labels
+    vector< vector<unsigned int> > adj(V);
+    for (unsigned int e = 0; e < edges.size(); e++)
+        {
+        adj[edges[e].first].push_back(edges[e].second);
+        adj[edges[e].second].push_back(edges[e].first);
+        }
+
+    vector<unsigned int> label(V, V);
+    unsigned int n_ref = 0;
+    for (unsigned int v = 0; v < V; v++)
+        {
+        if (label[v] != V)
+            continue;
+
+        // components are numbered by their smallest vertex
+        queue<unsigned int> q;
+        q.push(v);
+        label[v] = n_ref;
+        while (!q.empty())
+            {
+            unsigned int u = q.front();
+            q.pop();
+            for (unsigned int k = 0; k < adj[u].size(); k++)
+                {
+                if (label[adj[u][k]] == V)
+                    {
+                    label[adj[u][k]] = n_ref;
+                    q.push(adj[u][k]);
+                    }
+                }
+            }
+        n_ref++;
+        }
+
+    vector<unsigned int> cc_start, cc;
+    G.connectedComponents(cc_start, cc);
+
+    UP_ASSERT_EQUAL(cc_start.size(), n_ref+1);
+    UP_ASSERT_EQUAL(cc.size(), V);
+    UP_ASSERT_EQUAL(cc_start[n_ref], V);
+
+    for (unsigned int c = 0; c < n_ref; c++)
+        {
+        UP_ASSERT(cc_start[c+1] > cc_start[c]);
+        for (unsigned int k = cc_start[c]; k < cc_start[c+1]; k++)
+            {
+            UP_ASSERT_EQUAL(label[cc[k]], c);
+
+            // vertices are sorted within a component
+            if (k > cc_start[c])
+                UP_ASSERT(cc[k] > cc[k-1]);
+            }
+        }
+    }
+
+//! Test components of small graphs
+UP_TEST( graph_basic )
+    {
+    Graph G(6);
+    vector< pair<unsigned int, unsigned int> > edges;
+    edges.push_back(make_pair(5,1));
+    edges.push_back(make_pair(3,4));
+    edges.push_back(make_pair(1,5));
+    edges.push_back(make_pair(2,2));
+    for (unsigned int e = 0; e < edges.size(); e++)
+        G.addEdge(edges[e].first, edges[e].second);
+
+    check_components(G, 6, edges);
+
+    vector<unsigned int> cc_start, cc;
+    G.connectedComponents(cc_start, cc);
+    UP_ASSERT_EQUAL(cc_start.size(), 5);
+    UP_ASSERT_EQUAL(cc[0], 0);
+    UP_ASSERT_EQUAL(cc[1], 1);
+    UP_ASSERT_EQUAL(cc[2], 5);
+
+    // resize removes all edges
+    G.resize(3);
+    G.connectedComponents(cc_start, cc);
+    UP_ASSERT_EQUAL(cc_start.size(), 4);
+
+    // empty graph
+    G.resize(0);
+    G.connectedComponents(cc_start, cc);
+    UP_ASSERT_EQUAL(cc_start.size(), 1);
+    UP_ASSERT_EQUAL(cc.size(), 0);
+    }
+
+//! Test components of random graphs, adding the edges on multiple threads with TBB
+UP_TEST( graph_random )
+    {
+    hoomd::RandomGenerator rng(7);
+    Graph G;
+
+    const unsigned int V = 20000;
+    for (unsigned int n_edges = 1000; n_edges <= 30000; n_edges *= 5)
+        {
+        vector< pair<unsigned int, unsigned int> > edges;
+        for (unsigned int e = 0; e < n_edges; e++)
+            {
+            unsigned int i = hoomd::UniformIntDistribution(V-1)(rng);
+            unsigned int j = hoomd::UniformIntDistribution(V-1)(rng);
+            edges.push_back(make_pair(i,j));
+            }
+
+        G.resize(V);
+
+        #ifdef ENABLE_TBB
+        tbb::parallel_for((unsigned int)0, (unsigned int)edges.size(), [&](unsigned int e)
+            {
+            G.addEdge(edges[e].first, edges[e].second);
+            });
+        #else
+        for (unsigned int e = 0; e < edges.size(); e++)
+            G.addEdge(edges[e].first, edges[e].second);
+        #endif
+
+        check_components(G, V, edges);
+        }
+    }
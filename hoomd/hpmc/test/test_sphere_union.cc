@@ -14,6 +14,7 @@ HOOMD_UP_MAIN();
 
 #include <iostream>
 #include <string>
+#include <limits>
 
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #include <memory>
@@ -242,3 +243,74 @@ UP_TEST( overlapping_dumbbells )
     UP_ASSERT(test_overlap(r_b - r_a, a, b, err_count));
     UP_ASSERT(test_overlap(r_a - r_b, b, a, err_count));
     }
+
+UP_TEST( distance_field )
+    {
+    // chain of spheres of radius 0.25 with a larger sphere of radius 0.5 at one end
+    unsigned int n = 5;
+    ShapeUnion<ShapeSphere>::param_type params(n,false);
+    ShapeUnion<ShapeSphere>::param_type params_df(n,false);
+    OverlapReal diameter(0.0);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        ShapeSphere::param_type par;
+        par.radius = (i == n-1) ? 0.5 : 0.25;
+        par.ignore = 0;
+
+        vec3<Scalar> pos(-1.0 + 0.4*i, 0.1*i, 0);
+        params.mpos[i] = params_df.mpos[i] = pos;
+        params.morientation[i] = params_df.morientation[i] = quat<Scalar>();
+        params.mparams[i] = params_df.mparams[i] = par;
+        params.moverlap[i] = params_df.moverlap[i] = 1;
+        diameter = std::max(diameter, OverlapReal(2*sqrt(dot(pos,pos)) + 2*par.radius));
+        }
+    params.diameter = params_df.diameter = diameter;
+    build_tree<ShapeSphere>(params);
+    build_tree<ShapeSphere>(params_df);
+    params_df.buildDistanceField();
+    UP_ASSERT(params_df.distance_dim > 0);
+
+    // the distance bound never exceeds the distance to the member spheres
+    for (unsigned int i = 0; i < 1000; i++)
+        {
+        vec3<OverlapReal> r(Scalar(rand())/Scalar(RAND_MAX)*4.0-2.0,
+                            Scalar(rand())/Scalar(RAND_MAX)*4.0-2.0,
+                            Scalar(rand())/Scalar(RAND_MAX)*4.0-2.0);
+        OverlapReal d = std::numeric_limits<OverlapReal>::max();
+        for (unsigned int m = 0; m < n; m++)
+            {
+            vec3<OverlapReal> dr = r - params_df.mpos[m];
+            d = std::min(d, OverlapReal(sqrt(dot(dr,dr)) - params_df.mparams[m].radius));
+            }
+        UP_ASSERT(params_df.getDistanceBound(r) <= d);
+        }
+
+    // overlap checks with and without the distance field agree
+    unsigned int n_overlap = 0;
+    for (unsigned int i = 0; i < 1000; i++)
+        {
+        quat<Scalar> o_a(Scalar(rand())/Scalar(RAND_MAX)-0.5, vec3<Scalar>(Scalar(rand())/Scalar(RAND_MAX)-0.5,
+            Scalar(rand())/Scalar(RAND_MAX)-0.5, Scalar(rand())/Scalar(RAND_MAX)-0.5));
+        o_a = o_a * (Scalar)(Scalar(1.0)/sqrt(norm2(o_a)));
+        quat<Scalar> o_b(Scalar(rand())/Scalar(RAND_MAX)-0.5, vec3<Scalar>(Scalar(rand())/Scalar(RAND_MAX)-0.5,
+            Scalar(rand())/Scalar(RAND_MAX)-0.5, Scalar(rand())/Scalar(RAND_MAX)-0.5));
+        o_b = o_b * (Scalar)(Scalar(1.0)/sqrt(norm2(o_b)));
+        vec3<Scalar> r_ab(Scalar(rand())/Scalar(RAND_MAX)*4.0-2.0,
+                          Scalar(rand())/Scalar(RAND_MAX)*4.0-2.0,
+                          Scalar(rand())/Scalar(RAND_MAX)*4.0-2.0);
+
+        ShapeUnion<ShapeSphere> a(o_a, params);
+        ShapeUnion<ShapeSphere> b(o_b, params);
+        ShapeUnion<ShapeSphere> a_df(o_a, params_df);
+        ShapeUnion<ShapeSphere> b_df(o_b, params_df);
+
+        bool overlap = test_overlap(r_ab, a, b, err_count);
+        UP_ASSERT_EQUAL(test_overlap(r_ab, a_df, b_df, err_count), overlap);
+        UP_ASSERT_EQUAL(test_overlap(-r_ab, b_df, a_df, err_count), overlap);
+        UP_ASSERT_EQUAL(test_overlap(r_ab, a, b_df, err_count), overlap);
+        UP_ASSERT_EQUAL(test_overlap(r_ab, a_df, b, err_count), overlap);
+        n_overlap += overlap;
+        }
+    UP_ASSERT(n_overlap > 0);
+    UP_ASSERT(n_overlap < 1000);
+    }
@@ -46,6 +46,8 @@ def create_lattice(unitcell, n):
     lattice is replicated *n[0]* times in the :math:`\vec{a}_1` direction, *n[1]* times in the :math:`\vec{a}_2`
     direction and *n[2]* times in the :math:`\vec{a}_3` direction.
 
+    In MPI simulations, each rank generates only the particles in its own domain.
+
     Examples::
 
         hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=1.0),
@@ -81,12 +83,24 @@ def create_lattice(unitcell, n):
         hoomd.context.msg.error("n must have length equal to the number of dimensions in the unit cell\n");
         raise RuntimeError("Error initializing");
 
-    if snap.box.dimensions == 3:
-        snap.replicate(n[0],n[1],n[2])
     if snap.box.dimensions == 2:
-        snap.replicate(n[0],n[1],1)
-
-    read_snapshot(snapshot=snap);
+        n = [n[0], n[1], 1];
+
+    if _hoomd.is_MPI_available() and hoomd.context.exec_conf.getNRanks() > 1:
+        # replicate the unit cell on every rank and keep only the particles in the local domain
+        snap._broadcast(0, hoomd.context.exec_conf);
+        my_domain_decomposition = _create_domain_decomposition(snap._replicated_box(n[0],n[1],n[2]));
+        tags = snap._replicate_local(n[0],n[1],n[2], my_domain_decomposition);
+
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snap,
+                                                                          tags,
+                                                                          hoomd.context.exec_conf,
+                                                                          my_domain_decomposition);
+        hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, 0);
+        _perform_common_init_tasks();
+    else:
+        snap.replicate(n[0],n[1],n[2])
+        read_snapshot(snapshot=snap);
 
     hoomd.util.unquiet_status();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
@@ -250,7 +264,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, distributed = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -258,6 +272,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file. Negative values index from the end of the file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        distributed (bool): When True, read the particles on all MPI ranks.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -270,6 +285,14 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     step of the simulation instead of the one read from the GSD file *filename*.
     *time_step* is not applied when the file *restart* is read.
 
+    By default, the root rank reads the whole frame and sends the particles to the other ranks. In MPI simulations
+    with *distributed* set to True, every rank opens the file and reads an equal share of the particles, decoding
+    only those rows of quantized data. A single all-to-all exchange then sends each particle to the rank that owns
+    it. The bonds, angles, dihedrals, impropers, constraints, and pairs are split and sent to the ranks that own
+    their members in the same way. This avoids holding the full system in memory on the root rank, and each rank
+    reads only its share of the frame from the file. The file must be accessible from all ranks. *distributed* has
+    no effect on a single rank.
+
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
@@ -287,11 +310,14 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     filename = _hoomd.mpi_bcast_str(filename, hoomd.context.exec_conf);
     restart = _hoomd.mpi_bcast_str(restart, hoomd.context.exec_conf);
 
+    # reading on all ranks only applies to domain decomposition simulations
+    distributed = distributed and _hoomd.is_MPI_available() and hoomd.context.exec_conf.getNRanks() > 1;
+
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0, distributed);
         time_step = reader.getTimeStep();
     else:
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0, distributed);
         if time_step is None:
             time_step = reader.getTimeStep();
 
@@ -301,7 +327,14 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     snapshot._broadcast_box(hoomd.context.exec_conf);
     my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
 
-    if my_domain_decomposition is not None:
+    if distributed:
+        # each rank reads the particles in its own domain
+        reader.readLocalParticles(my_domain_decomposition);
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot,
+                                                                          reader.getLocalTags(),
+                                                                          hoomd.context.exec_conf,
+                                                                          my_domain_decomposition);
+    elif my_domain_decomposition is not None:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
     else:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
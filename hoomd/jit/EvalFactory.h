@@ -20,6 +20,17 @@ class EvalFactory
             float d_j,
             float charge_j);
 
+        typedef float (*EvalBatchFnPtr)(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j);
+
         //! Constructor
         EvalFactory(const std::string& llvm_ir);
 
@@ -29,6 +40,12 @@ class EvalFactory
             return m_eval;
             }
 
+        //! Return the batched evaluator, or NULL if the module does not provide one
+        EvalBatchFnPtr getEvalBatch()
+            {
+            return m_eval_batch;
+            }
+
         //! Get the error message from initialization
         const std::string& getError()
             {
@@ -38,6 +55,7 @@ class EvalFactory
     private:
         std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
         EvalFnPtr m_eval;         //!< Function pointer to evaluator
+        EvalBatchFnPtr m_eval_batch; //!< Function pointer to batched evaluator (optional)
 
         std::string m_error_msg; //!< The error message if initialization fails
     };
@@ -2,6 +2,8 @@
 #include "EvalFactory.h"
 
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
 #define PATCH_ENERGY_LOG_NAME           "patch_energy"
 #define PATCH_ENERGY_RCUT               "patch_energy_rcut"
@@ -18,6 +20,7 @@ PatchEnergyJIT::PatchEnergyJIT(std::shared_ptr<ExecutionConfiguration> exec_conf
 
     // get the evaluator
     m_eval = m_factory->getEval();
+    m_eval_batch = m_factory->getEvalBatch();
 
     if (!m_eval)
         {
@@ -27,6 +30,51 @@ PatchEnergyJIT::PatchEnergyJIT(std::shared_ptr<ExecutionConfiguration> exec_conf
     }
 
 
+/*! \param patch Patch energy evaluator
+    \param r_ij Python list of vec3_float separations
+    \param type_i Type of particle i
+    \param q_i Orientation of particle i
+    \param d_i Diameter of particle i
+    \param charge_i Charge of particle i
+    \param type_j Python list of the types of the neighbors
+    \param q_j Python list of the orientations of the neighbors
+    \param d_j Python list of the diameters of the neighbors
+    \param charge_j Python list of the charges of the neighbors
+
+    Converts the lists and calls PatchEnergyJIT::energyBatch(), so that tests can compare it with energy().
+*/
+static float energyBatchPy(PatchEnergyJIT& patch,
+                           pybind11::list r_ij,
+                           unsigned int type_i,
+                           const quat<float>& q_i,
+                           float d_i,
+                           float charge_i,
+                           pybind11::list type_j,
+                           pybind11::list q_j,
+                           pybind11::list d_j,
+                           pybind11::list charge_j)
+    {
+    unsigned int n = pybind11::len(r_ij);
+    if (pybind11::len(type_j) != n || pybind11::len(q_j) != n || pybind11::len(d_j) != n
+        || pybind11::len(charge_j) != n)
+        throw std::runtime_error("All neighbor lists must have the same length");
+
+    std::vector< vec3<float> > r(n);
+    std::vector<unsigned int> t(n);
+    std::vector< quat<float> > q(n);
+    std::vector<float> d(n), c(n);
+    for (unsigned int k = 0; k < n; k++)
+        {
+        r[k] = r_ij[k].cast< vec3<float> >();
+        t[k] = type_j[k].cast<unsigned int>();
+        q[k] = q_j[k].cast< quat<float> >();
+        d[k] = d_j[k].cast<float>();
+        c[k] = charge_j[k].cast<float>();
+        }
+
+    return patch.energyBatch(n, r.data(), type_i, q_i, d_i, charge_i, t.data(), q.data(), d.data(), c.data());
+    }
+
 void export_PatchEnergyJIT(pybind11::module &m)
     {
       pybind11::class_<hpmc::PatchEnergy, std::shared_ptr<hpmc::PatchEnergy> >(m, "PatchEnergy")
@@ -36,5 +84,6 @@ void export_PatchEnergyJIT(pybind11::module &m)
                                  const std::string&,
                                  Scalar >())
             .def("getRCut", &PatchEnergyJIT::getRCut)
-            .def("energy", &PatchEnergyJIT::energy);
+            .def("energy", &PatchEnergyJIT::energy)
+            .def("energyBatch", &energyBatchPy);
     }
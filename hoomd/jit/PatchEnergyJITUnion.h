@@ -106,6 +106,23 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             float d_j,
             float charge_j);
 
+        //! evaluate the total energy of the patch interactions of particle i with a batch of neighbors
+        /*! The isotropic eval_batch function does not include the constituent particles, so call energy() per pair.
+        */
+        virtual float energyBatch(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j)
+            {
+            return hpmc::PatchEnergy::energyBatch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -97,6 +97,26 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also contain an extern "C" function that returns the sum of the energies of particle *i* with *n*
+    neighbors, which HOOMD calls instead of evaluating one pair at a time:
+
+    .. code::
+
+        float eval_batch(unsigned int n,
+                         const vec3<float> *r_ij,
+                         unsigned int type_i,
+                         const quat<float>& q_i,
+                         float d_i,
+                         float charge_i,
+                         const unsigned int *type_j,
+                         const quat<float> *q_j,
+                         const float *d_j,
+                         const float *charge_j)
+
+    Code passed in *code* is compiled with an ``eval_batch`` function that calls ``eval`` in a loop. This saves one
+    indirect call per pair, and clang may inline ``eval`` into the loop. Whether the loop is also vectorized depends
+    on the code in ``eval``: branches and calls that clang cannot inline usually prevent it.
+
     Compile the file with clang: ``clang -O3 --std=c++11 -DHOOMD_LLVMJIT_BUILD -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -166,6 +186,24 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+float eval_batch(unsigned int n,
+    const vec3<float> *r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int *type_j,
+    const quat<float> *q_j,
+    const float *d_j,
+    const float *charge_j)
+    {
+    float energy = 0.0f;
+    #pragma clang loop vectorize(enable)
+    for (unsigned int k = 0; k < n; ++k)
+        energy += eval(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+    return energy;
+    }
 }
 """
 
@@ -32,6 +32,8 @@ BondTablePotential::BondTablePotential(std::shared_ptr<SystemDefinition> sysdef,
 
     // access the bond data for later use
     m_bond_data = m_sysdef->getBondData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<BondData> >(
+        new BondedGroupColoring<BondData>(m_pdata, m_bond_data));
 
     if (table_width == 0)
         {
@@ -176,12 +178,14 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    ArrayHandle<BondData::members_t> h_groups(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // for each of the bonds, bonds that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the bond
-        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
+        const BondData::members_t bond = h_groups.data[i];
         assert(bond.tag[0] < m_pdata->getN());
         assert(bond.tag[1] < m_pdata->getN());
 
@@ -211,7 +215,7 @@ void BondTablePotential::computeForces(unsigned int timestep)
         dx = box.minImage(dx);
 
         // access needed parameters
-        unsigned int type = m_bond_data->getTypeByIndex(i);
+        unsigned int type = h_typeval.data[i].type;
         Scalar4 params = h_params.data[type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
@@ -286,7 +290,7 @@ void BondTablePotential::computeForces(unsigned int timestep)
             throw std::runtime_error("Error in bond calculation");
             }
 
-        }
+        });
     if (m_prof) m_prof->pop();
     }
 
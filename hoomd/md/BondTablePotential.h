@@ -5,6 +5,7 @@
 // Maintainer: phillicl
 
 #include "hoomd/ForceCompute.h"
+#include "BondedGroupColoring.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/GPUArray.h"
 
@@ -89,6 +90,7 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
 
     protected:
         std::shared_ptr<BondData> m_bond_data;    //!< Bond data to use in computing bonds
+        std::shared_ptr< BondedGroupColoring<BondData> > m_coloring; //!< Distributes the bonds over threads
         unsigned int m_table_width;                 //!< Width of the tables in memory
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         GPUArray<Scalar4> m_params;                 //!< Parameters stored for each table
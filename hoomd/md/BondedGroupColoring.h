@@ -0,0 +1,191 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/ParticleData.h"
+#include "hoomd/BondedGroupData.h"
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \file BondedGroupColoring.h
+    \brief Declares BondedGroupColoring
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __BONDED_GROUP_COLORING_H__
+#define __BONDED_GROUP_COLORING_H__
+
+//! Distributes the local bonded groups of a BondedGroupData over CPU threads
+/*! Bonded force computes add the force of every group to all of its member particles. To run the group loop on
+    several threads without write conflicts, the local groups are colored such that no two groups of the same color
+    share a particle. Colors are processed one after another, and the groups of one color in parallel.
+
+    Since every particle receives at most one contribution per color, and the colors are always processed in the
+    same order, the result does not depend on the number of threads.
+
+    The coloring is computed greedily with up to 64 colors. Groups that do not fit into any of them (e.g. around a
+    particle with more than 64 bonds) form a last color that is processed serially. The coloring only depends on
+    which groups share particles, so it is cached and only recomputed after BondedGroupData signals a change of its
+    local groups.
+
+    \ingroup computes
+*/
+template < class group_data >
+class BondedGroupColoring
+    {
+    public:
+        //! Constructor
+        /*! \param pdata Particle data the groups refer to
+            \param gdata Bonded groups to color
+        */
+        BondedGroupColoring(std::shared_ptr<ParticleData> pdata, std::shared_ptr<group_data> gdata)
+            : m_pdata(pdata), m_group_data(gdata), m_dirty(true)
+            {
+            m_group_data->getGroupNumChangeSignal().template connect<BondedGroupColoring<group_data>,
+                &BondedGroupColoring<group_data>::setDirty>(this);
+            m_group_data->getGroupReorderSignal().template connect<BondedGroupColoring<group_data>,
+                &BondedGroupColoring<group_data>::setDirty>(this);
+            }
+
+        //! Destructor
+        ~BondedGroupColoring()
+            {
+            m_group_data->getGroupNumChangeSignal().template disconnect<BondedGroupColoring<group_data>,
+                &BondedGroupColoring<group_data>::setDirty>(this);
+            m_group_data->getGroupReorderSignal().template disconnect<BondedGroupColoring<group_data>,
+                &BondedGroupColoring<group_data>::setDirty>(this);
+            }
+
+        //! Call a kernel for every local group
+        /*! \param num_threads Number of threads (as returned by ExecutionConfiguration::getNumThreads())
+            \param kernel Functor called as kernel(group_idx)
+
+            With a single thread (or without TBB), the groups are processed in order of their index. Otherwise,
+            groups that share a particle are never processed concurrently.
+
+            The particle rtags must be up to date, including those of ghost particles.
+        */
+        template<class Kernel>
+        void forEach(unsigned int num_threads, const Kernel& kernel)
+            {
+            const unsigned int n_groups = m_group_data->getN();
+
+            #ifdef ENABLE_TBB
+            if (num_threads > 1 && n_groups > 1)
+                {
+                if (m_dirty)
+                    computeColoring();
+
+                const unsigned int n_colors = (unsigned int)m_color_start.size() - 1;
+                for (unsigned int c = 0; c < n_colors; ++c)
+                    {
+                    const unsigned int first = m_color_start[c];
+                    const unsigned int last = m_color_start[c+1];
+
+                    if (c == max_colors)
+                        {
+                        // groups that share particles with groups of every other color
+                        for (unsigned int k = first; k < last; ++k)
+                            kernel(m_order[k]);
+                        }
+                    else
+                        {
+                        tbb::parallel_for(tbb::blocked_range<unsigned int>(first, last),
+                            [&](const tbb::blocked_range<unsigned int>& r)
+                            {
+                            for (unsigned int k = r.begin(); k != r.end(); ++k)
+                                kernel(m_order[k]);
+                            });
+                        }
+                    }
+                return;
+                }
+            #endif
+
+            for (unsigned int i = 0; i < n_groups; ++i)
+                kernel(i);
+            }
+
+    private:
+        static const unsigned int max_colors = 64; //!< Number of colors processed in parallel
+
+        std::shared_ptr<ParticleData> m_pdata;     //!< Particle data
+        std::shared_ptr<group_data> m_group_data;  //!< Bonded groups
+        bool m_dirty;                              //!< True if the coloring needs to be recomputed
+        std::vector<unsigned int> m_order;         //!< Local group indices sorted by color
+        std::vector<unsigned int> m_color_start;   //!< First entry of every color in m_order (plus one past the end)
+
+        //! Mark the coloring as out of date
+        void setDirty()
+            {
+            m_dirty = true;
+            }
+
+        //! Compute the coloring of the local groups
+        void computeColoring()
+            {
+            const unsigned int n_groups = m_group_data->getN();
+            const unsigned int n_particles = m_pdata->getN() + m_pdata->getNGhosts();
+
+            ArrayHandle<typename group_data::members_t> h_groups(m_group_data->getMembersArray(),
+                access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+            // the colors already taken by the groups of every particle
+            std::vector<uint64_t> used(n_particles, 0);
+            std::vector<unsigned int> color(n_groups);
+            std::vector<unsigned int> n_color(max_colors+1, 0);
+
+            for (unsigned int i = 0; i < n_groups; ++i)
+                {
+                const typename group_data::members_t& g = h_groups.data[i];
+                uint64_t mask = 0;
+                bool complete = true;
+                for (unsigned int j = 0; j < group_data::size; ++j)
+                    {
+                    unsigned int idx = h_rtag.data[g.tag[j]];
+                    if (idx >= n_particles)
+                        complete = false;
+                    else
+                        mask |= used[idx];
+                    }
+
+                // incomplete groups are left to the serial color, the kernel reports them
+                unsigned int c = 0;
+                if (complete)
+                    while (c < max_colors && (mask & (uint64_t(1) << c)))
+                        c++;
+                else
+                    c = max_colors;
+
+                if (c < max_colors)
+                    for (unsigned int j = 0; j < group_data::size; ++j)
+                        used[h_rtag.data[g.tag[j]]] |= uint64_t(1) << c;
+
+                color[i] = c;
+                n_color[c]++;
+                }
+
+            // sort the groups by color, keeping the order of the indices within a color
+            m_color_start.assign(max_colors+2, 0);
+            for (unsigned int c = 0; c <= max_colors; ++c)
+                m_color_start[c+1] = m_color_start[c] + n_color[c];
+
+            m_order.resize(n_groups);
+            std::vector<unsigned int> pos(m_color_start.begin(), m_color_start.end()-1);
+            for (unsigned int i = 0; i < n_groups; ++i)
+                m_order[pos[color[i]]++] = i;
+
+            m_dirty = false;
+            }
+    };
+
+#endif
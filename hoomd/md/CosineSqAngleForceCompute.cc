@@ -31,6 +31,8 @@ CosineSqAngleForceCompute::CosineSqAngleForceCompute(std::shared_ptr<SystemDefin
 
     // access the angle data for later use
     m_angle_data = m_sysdef->getAngleData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<AngleData> >(
+        new BondedGroupColoring<AngleData>(m_pdata, m_angle_data));
 
     // check for some silly errors a user could make
     if (m_angle_data->getNTypes() == 0)
@@ -137,12 +139,14 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    ArrayHandle<AngleData::members_t> h_groups(m_angle_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // for each of the angles, angles that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
+        const AngleData::members_t& angle = h_groups.data[i];
         assert(angle.tag[0] <= m_pdata->getMaximumTag());
         assert(angle.tag[1] <= m_pdata->getMaximumTag());
         assert(angle.tag[2] <= m_pdata->getMaximumTag());
@@ -202,7 +206,7 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
         if (c_abbc < -1.0) c_abbc = -1.0;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
+        unsigned int angle_type = h_typeval.data[i].type;
         Scalar dcosth = c_abbc - cos(m_t_0[angle_type]);  // = cos(t) - cos(t0)
         Scalar tk = m_K[angle_type]*dcosth;  // = k(cos(t) - cos(t0))
 
@@ -266,7 +270,7 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
             for (int j = 0; j < 6; j++)
                 h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
             }
-        }
+        });
 
     if (m_prof) m_prof->pop();
     }
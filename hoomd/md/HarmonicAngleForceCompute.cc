@@ -34,6 +34,8 @@ HarmonicAngleForceCompute::HarmonicAngleForceCompute(std::shared_ptr<SystemDefin
 
     // access the angle data for later use
     m_angle_data = m_sysdef->getAngleData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<AngleData> >(
+        new BondedGroupColoring<AngleData>(m_pdata, m_angle_data));
 
     // check for some silly errors a user could make
     if (m_angle_data->getNTypes() == 0)
@@ -138,12 +140,15 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    ArrayHandle<AngleData::members_t> h_groups(m_angle_data->getMembersArray(),
+        access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // for each of the angles, angles that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
+        const AngleData::members_t& angle = h_groups.data[i];
         assert(angle.tag[0] <= m_pdata->getMaximumTag());
         assert(angle.tag[1] <= m_pdata->getMaximumTag());
         assert(angle.tag[2] <= m_pdata->getMaximumTag());
@@ -208,7 +213,7 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         s_abbc = 1.0/s_abbc;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
+        unsigned int angle_type = h_typeval.data[i].type;
         Scalar dth = acos(c_abbc) - m_t_0[angle_type];
         Scalar tk = m_K[angle_type]*dth;
 
@@ -271,7 +276,7 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
             for (int j = 0; j < 6; j++)
                 h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
             }
-        }
+        });
 
     if (m_prof) m_prof->pop();
     }
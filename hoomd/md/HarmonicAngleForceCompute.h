@@ -5,6 +5,7 @@
 // Maintainer: dnlebard
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedGroupColoring.h"
 
 #include <memory>
 
@@ -65,6 +66,7 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
         Scalar* m_t_0;  //!< r_0 parameter for multiple angle types
 
         std::shared_ptr<AngleData> m_angle_data;  //!< Angle data to use in computing angles
+        std::shared_ptr< BondedGroupColoring<AngleData> > m_coloring; //!< Distributes the angles over threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
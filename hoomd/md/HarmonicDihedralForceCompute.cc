@@ -34,6 +34,8 @@ HarmonicDihedralForceCompute::HarmonicDihedralForceCompute(std::shared_ptr<Syste
 
     // access the dihedral data for later use
     m_dihedral_data = m_sysdef->getDihedralData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<DihedralData> >(
+        new BondedGroupColoring<DihedralData>(m_pdata, m_dihedral_data));
 
     // check for some silly errors a user could make
     if (m_dihedral_data->getNTypes() == 0)
@@ -145,12 +147,15 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    ArrayHandle<DihedralData::members_t> h_groups(m_dihedral_data->getMembersArray(),
+        access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // for each of the dihedrals, dihedrals that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        const ImproperData::members_t& dihedral = h_groups.data[i];
         assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
@@ -231,7 +236,7 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         if (c_abcd > 1.0) c_abcd = 1.0;
         if (c_abcd < -1.0) c_abcd = -1.0;
 
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
+        unsigned int dihedral_type = h_typeval.data[i].type;
         int multi = (int)m_multi[dihedral_type];
         Scalar p = Scalar(1.0);
         Scalar dfab = Scalar(0.0);
@@ -345,7 +350,7 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         h_force.data[idx_d].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
            h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+       });
 
     if (m_prof) m_prof->pop();
     }
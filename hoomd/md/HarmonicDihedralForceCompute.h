@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedGroupColoring.h"
 
 #include <memory>
 
@@ -67,6 +68,7 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
         Scalar *m_multi; //!< multiplicity parameter for multiple dihedral types
 
         std::shared_ptr<DihedralData> m_dihedral_data;    //!< Dihedral data to use in computing dihedrals
+        std::shared_ptr< BondedGroupColoring<DihedralData> > m_coloring; //!< Distributes the dihedrals over threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
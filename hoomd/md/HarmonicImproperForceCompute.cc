@@ -33,6 +33,8 @@ HarmonicImproperForceCompute::HarmonicImproperForceCompute(std::shared_ptr<Syste
 
     // access the improper data for later use
     m_improper_data = m_sysdef->getImproperData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<ImproperData> >(
+        new BondedGroupColoring<ImproperData>(m_pdata, m_improper_data));
 
     // check for some silly errors a user could make
     if (m_improper_data->getNTypes() == 0)
@@ -137,12 +139,15 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the impropers
-    const unsigned int size = (unsigned int)m_improper_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    ArrayHandle<ImproperData::members_t> h_groups(m_improper_data->getMembersArray(),
+        access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_improper_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // for each of the impropers, impropers that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the improper
-        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
+        const ImproperData::members_t& improper = h_groups.data[i];
         assert(improper.tag[0] <= m_pdata->getMaximumTag());
         assert(improper.tag[1] <= m_pdata->getMaximumTag());
         assert(improper.tag[2] <= m_pdata->getMaximumTag());
@@ -220,7 +225,7 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         Scalar s = sqrt(1.0 - c*c);
         if (s < SMALL) s = SMALL;
 
-        unsigned int improper_type = m_improper_data->getTypeByIndex(i);
+        unsigned int improper_type = h_typeval.data[i].type;
         Scalar domega = acos(c) - m_chi[improper_type];
         Scalar a = m_K[improper_type] * domega;
 
@@ -311,7 +316,7 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
             for (int k = 0; k < 6; k++)
                 h_virial.data[k*virial_pitch+idx_d]  += improper_virial[k];
             }
-        }
+        });
 
     if (m_prof) m_prof->pop();
     }
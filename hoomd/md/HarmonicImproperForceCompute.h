@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedGroupColoring.h"
 
 #include <memory>
 
@@ -66,6 +67,7 @@ class PYBIND11_EXPORT HarmonicImproperForceCompute : public ForceCompute
         Scalar *m_chi;  //!< Chi parameter for multiple impropers
 
         std::shared_ptr<ImproperData> m_improper_data;    //!< Improper data to use in computing impropers
+        std::shared_ptr< BondedGroupColoring<ImproperData> > m_coloring; //!< Distributes the impropers over threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -108,6 +108,9 @@ void IntegratorTwoStep::update(unsigned int timestep)
     if (m_prof)
         m_prof->push("Integrate");
 
+    // measure the time spent outside of communication (for load balancing)
+    int64_t start_time = m_compute_clock.getTime();
+
     // perform the first step of the integration on all groups
     std::vector< std::shared_ptr<IntegrationMethodTwoStep> >::iterator method;
     for (method = m_methods.begin(); method != m_methods.end(); ++method)
@@ -116,6 +119,8 @@ void IntegratorTwoStep::update(unsigned int timestep)
     if (m_prof)
         m_prof->pop();
 
+    int64_t elapsed_time = m_compute_clock.getTime() - start_time;
+
 #ifdef ENABLE_MPI
     if (m_comm)
         {
@@ -124,7 +129,8 @@ void IntegratorTwoStep::update(unsigned int timestep)
         // b) that forces are calculated correctly, if ghost atom positions are updated every time step
 
         // also updates rigid bodies after ghost updating
-        m_comm->communicate(timestep+1);
+        // on the CPU, the ghost update may be left pending to overlap it with the force computation
+        m_comm->communicate(timestep+1, m_exec_conf->exec_mode == ExecutionConfiguration::CPU);
         }
     else
 #endif
@@ -132,6 +138,8 @@ void IntegratorTwoStep::update(unsigned int timestep)
         updateRigidBodies(timestep+1);
         }
 
+    start_time = m_compute_clock.getTime();
+
     // compute the net force on all particles
 #ifdef ENABLE_CUDA
     if (m_exec_conf->exec_mode == ExecutionConfiguration::GPU)
@@ -164,6 +172,9 @@ void IntegratorTwoStep::update(unsigned int timestep)
 
     if (m_prof)
         m_prof->pop();
+
+    elapsed_time += m_compute_clock.getTime() - start_time;
+    m_compute_time += double(elapsed_time) * 1e-9;
     }
 
 /*! \param deltaT new deltaT to set
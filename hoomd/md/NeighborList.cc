@@ -11,6 +11,10 @@
 #include "NeighborList.h"
 #include "hoomd/BondedGroupData.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 #include <iostream>
@@ -34,7 +38,7 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
       m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
-      m_dist_check(true), m_has_been_updated_once(false)
+      m_dist_check(true), m_has_been_updated_once(false), m_num_builds(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
 
@@ -365,6 +369,7 @@ void NeighborList::compute(unsigned int timestep)
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_num_builds++;
         }
     if (m_prof) m_prof->pop();
     }
@@ -1105,7 +1110,18 @@ bool NeighborList::distanceCheck(unsigned int timestep)
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
+    #ifdef ENABLE_TBB
+    result = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+        false,
+        [&](const tbb::blocked_range<unsigned int>& r, bool result)->bool {
+        // another range already found a particle that moved too far
+        if (result)
+            return result;
+
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #endif
         {
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
 
@@ -1131,6 +1147,10 @@ bool NeighborList::distanceCheck(unsigned int timestep)
             break;
             }
         }
+    #ifdef ENABLE_TBB
+    return result;
+    }, [](bool x, bool y)->bool { return x || y; } );
+    #endif
 
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -232,19 +232,19 @@ class PYBIND11_EXPORT NeighborList : public Compute
         // @{
 
         //! Get the number of neighbors array
-        const GlobalArray<unsigned int>& getNNeighArray()
+        virtual const GlobalArray<unsigned int>& getNNeighArray()
             {
             return m_n_neigh;
             }
 
         //! Get the neighbor list
-        const GlobalArray<unsigned int>& getNListArray()
+        virtual const GlobalArray<unsigned int>& getNListArray()
             {
             return m_nlist;
             }
 
         //! Get the head list
-        const GlobalArray<unsigned int>& getHeadList()
+        virtual const GlobalArray<unsigned int>& getHeadList()
             {
             return m_head_list;
             }
@@ -448,6 +448,28 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_last_updated_tstep == timestep && m_has_been_updated_once;
             }
 
+        //! Return true if a call to compute() at this time step will not rebuild the list
+        /*! \param timestep Current time step
+         *
+         *  This is conservative: it only returns true if the rebuild check for this time step has already
+         *  been performed (e.g. by peekUpdate()) and was negative. A current list does not access the
+         *  positions of ghost particles when computed.
+         */
+        bool isCurrent(unsigned int timestep) const
+            {
+            return m_has_been_updated_once && !m_force_update && !m_rcut_changed &&
+                   m_last_checked_tstep == timestep && !m_last_check_result;
+            }
+
+        //! Get the number of times the list has been built
+        /*! Unlike getNumUpdates(), this also counts the builds that are not recorded in the statistics,
+         *  so it can be used to detect any change of the list contents.
+         */
+        unsigned int getNumBuilds() const
+            {
+            return m_num_builds;
+            }
+
         Nano::Signal<void ()>& getRCutChangeSignal()
             {
             return m_rcut_signal;
@@ -550,6 +572,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         bool m_force_update;            //!< Flag to handle the forcing of neighborlist updates
         bool m_dist_check;              //!< Set to false to disable distance checks (nlist always built m_every steps)
         bool m_has_been_updated_once;   //!< True if the neighbor list has been updated at least once
+        unsigned int m_num_builds;      //!< Number of times the list has been built
 
         unsigned int m_last_updated_tstep; //!< Track the last time step we were updated
         unsigned int m_last_checked_tstep; //!< Track the last time step we have checked
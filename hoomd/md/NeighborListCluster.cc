@@ -0,0 +1,576 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file NeighborListCluster.cc
+    \brief Defines NeighborListCluster
+*/
+
+#include "NeighborListCluster.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+namespace py = pybind11;
+
+//! Marks an unused lane of a cluster
+const unsigned int CLUSTER_EMPTY = 0xffffffff;
+
+/*! \param sysdef System definition
+    \param r_cut Default cutoff radius
+    \param r_buff Buffer width
+    \param cl Cell list (a new one is created if not specified)
+    \param cluster_size Number of particles per cluster, 4 or 8
+*/
+NeighborListCluster::NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef,
+                                         Scalar r_cut,
+                                         Scalar r_buff,
+                                         std::shared_ptr<CellList> cl,
+                                         unsigned int cluster_size)
+    : NeighborList(sysdef, r_cut, r_buff), m_cl(cl), m_cluster_size(cluster_size), m_n_local_clusters(0),
+      m_cluster_nmax(8), m_particle_list_valid(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListCluster" << endl;
+
+    if (m_cluster_size != 4 && m_cluster_size != 8)
+        {
+        m_exec_conf->msg->error() << "nlist.cluster: cluster size must be 4 or 8" << endl;
+        throw runtime_error("Error initializing NeighborListCluster");
+        }
+
+    // create a default cell list if one was not specified
+    if (!m_cl)
+        m_cl = std::shared_ptr<CellList>(new CellList(sysdef));
+
+    m_cl->setRadius(1);
+    m_cl->setComputeXYZF(true);
+    m_cl->setComputeTDB(false);
+    m_cl->setFlagIndex();
+
+    // call this class's special setRCut
+    setRCut(r_cut, r_buff);
+    }
+
+NeighborListCluster::~NeighborListCluster()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListCluster" << endl;
+    }
+
+void NeighborListCluster::setRCut(Scalar r_cut, Scalar r_buff)
+    {
+    NeighborList::setRCut(r_cut, r_buff);
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
+void NeighborListCluster::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut)
+    {
+    NeighborList::setRCutPair(typ1,typ2,r_cut);
+
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
+void NeighborListCluster::setMaximumDiameter(Scalar d_max)
+    {
+    NeighborList::setMaximumDiameter(d_max);
+
+    // need to update the cell list settings appropriately
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
+void NeighborListCluster::printStats()
+    {
+    // return early if the notice level is less than 1
+    if (m_exec_conf->msg->getNoticeLevel() < 1)
+        return;
+
+    // the generic statistics are computed from the per particle list
+    expandParticleList();
+    NeighborList::printStats();
+
+    unsigned long long n_pairs = 0;
+    unsigned long long n_bits = 0;
+    for (unsigned int c = 0; c < m_n_local_clusters; c++)
+        {
+        n_pairs += m_cluster_n_neigh[c];
+        for (unsigned int k = 0; k < m_cluster_n_neigh[c]; k++)
+            {
+            uint64_t mask = m_cluster_mask[c*m_cluster_nmax + k];
+            for (; mask; mask &= mask - 1)
+                n_bits++;
+            }
+        }
+
+    double n_pairs_avg = m_n_local_clusters ? double(n_pairs) / double(m_n_local_clusters) : 0.0;
+    double fill = n_pairs ? double(n_bits) / double(n_pairs*m_cluster_size*m_cluster_size) : 0.0;
+    m_exec_conf->msg->notice(1) << "cluster size: " << m_cluster_size << " / n_clusters: " << m_n_local_clusters
+                                << " / n_cluster_neigh_avg: " << n_pairs_avg << " / mask fill: " << fill << endl;
+    }
+
+/*! Local clusters are created for all cells first, followed by the ghost clusters, so that every cell owns a
+    contiguous range of local clusters and a contiguous range of ghost clusters.
+*/
+void NeighborListCluster::buildClusters()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
+
+    Index3D ci = m_cl->getCellIndexer();
+    Index2D cli = m_cl->getCellListIndexer();
+
+    const unsigned int ncells = ci.getNumElements();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int M = m_cluster_size;
+    const bool is_2d = (m_sysdef->getNDimensions() == 2);
+
+    m_cell_local_start.resize(ncells+1);
+    m_cell_ghost_start.resize(ncells+1);
+    m_cluster_idx.clear();
+    m_cluster_cell.clear();
+
+    std::vector<unsigned int> members;
+    for (unsigned int pass = 0; pass < 2; pass++)
+        {
+        std::vector<unsigned int>& cell_start = (pass == 0) ? m_cell_local_start : m_cell_ghost_start;
+        for (unsigned int cur_cell = 0; cur_cell < ncells; cur_cell++)
+            {
+            cell_start[cur_cell] = m_cluster_cell.size();
+
+            members.clear();
+            unsigned int size = h_cell_size.data[cur_cell];
+            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+                {
+                unsigned int idx = __scalar_as_int(h_cell_xyzf.data[cli(cur_offset, cur_cell)].w);
+                if ((idx < N) == (pass == 0))
+                    members.push_back(idx);
+                }
+
+            // sort along z (y in 2D) so that the clusters are compact
+            std::sort(members.begin(), members.end(), [&](unsigned int a, unsigned int b)
+                {
+                Scalar za = is_2d ? h_pos.data[a].y : h_pos.data[a].z;
+                Scalar zb = is_2d ? h_pos.data[b].y : h_pos.data[b].z;
+                return (za < zb) || (za == zb && a < b);
+                });
+
+            for (unsigned int k0 = 0; k0 < members.size(); k0 += M)
+                {
+                for (unsigned int l = 0; l < M; l++)
+                    m_cluster_idx.push_back(k0 + l < members.size() ? members[k0 + l] : CLUSTER_EMPTY);
+                m_cluster_cell.push_back(cur_cell);
+                }
+            }
+        cell_start[ncells] = m_cluster_cell.size();
+
+        if (pass == 0)
+            m_n_local_clusters = m_cluster_cell.size();
+        }
+
+    // bounding boxes of the clusters
+    const unsigned int n_clusters = m_cluster_cell.size();
+    m_cluster_lo.resize(n_clusters);
+    m_cluster_hi.resize(n_clusters);
+    for (unsigned int c = 0; c < n_clusters; c++)
+        {
+        // the first lane of a cluster is always used
+        const Scalar4& p0 = h_pos.data[m_cluster_idx[c*M]];
+        Scalar3 lo = make_scalar3(p0.x, p0.y, p0.z);
+        Scalar3 hi = lo;
+        for (unsigned int l = 1; l < M; l++)
+            {
+            unsigned int idx = m_cluster_idx[c*M + l];
+            if (idx == CLUSTER_EMPTY)
+                break;
+
+            const Scalar4& p = h_pos.data[idx];
+            lo.x = std::min(lo.x, p.x); lo.y = std::min(lo.y, p.y); lo.z = std::min(lo.z, p.z);
+            hi.x = std::max(hi.x, p.x); hi.y = std::max(hi.y, p.y); hi.z = std::max(hi.z, p.z);
+            }
+        m_cluster_lo[c] = lo;
+        m_cluster_hi[c] = hi;
+        }
+    }
+
+void NeighborListCluster::buildNlist(unsigned int timestep)
+    {
+    m_cl->compute(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compute");
+
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
+
+    // validate that the cutoff fits inside the box
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    // the largest possible r_list, used to find the candidate cluster pairs
+    const Scalar rlistsq_max = rmax*rmax;
+
+    if (m_filter_body)
+        {
+        // add the maximum diameter of all composite particles
+        Scalar max_d_comp = m_pdata->getMaxCompositeParticleDiameter();
+        rmax += 0.5*max_d_comp;
+        }
+
+    if ((box.getPeriodic().x && nearest_plane_distance.x <= rmax * 2.0) ||
+        (box.getPeriodic().y && nearest_plane_distance.y <= rmax * 2.0) ||
+        (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z && nearest_plane_distance.z <= rmax * 2.0))
+        {
+        m_exec_conf->msg->error() << "nlist: Simulation box is too small! Particles would be interacting with themselves." << endl;
+        throw runtime_error("Error updating neighborlist bins");
+        }
+
+    buildClusters();
+    m_particle_list_valid = false;
+
+    // acquire the particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+
+    // access the rlist data
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+
+    // access the cell adjacency
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(), access_location::host, access_mode::read);
+    Index2D cadji = m_cl->getCellAdjIndexer();
+
+    const unsigned int M = m_cluster_size;
+    const unsigned int n_local = m_n_local_clusters;
+    m_cluster_n_neigh.resize(n_local);
+
+    // rebuild the list until there is no overflow
+    bool overflowed = false;
+    do
+        {
+        m_cluster_nlist.resize(n_local*m_cluster_nmax);
+        m_cluster_mask.resize(n_local*m_cluster_nmax);
+        const unsigned int nmax = m_cluster_nmax;
+
+        #ifdef ENABLE_TBB
+        // every cluster only writes to its own row of the cluster list
+        tbb::enumerable_thread_specific<unsigned int> max_n_neigh_tls(0);
+        tbb::parallel_for(0, (int)n_local, [&] (int c_i)
+        #else
+        unsigned int max_n_neigh = 0;
+        for (int c_i = 0; c_i < (int)n_local; c_i++)
+        #endif
+            {
+            #ifdef ENABLE_TBB
+            unsigned int& max_n_neigh = max_n_neigh_tls.local();
+            #endif
+
+            unsigned int cur_n_neigh = 0;
+
+            const unsigned int *idx_i = &m_cluster_idx[c_i*M];
+            const Scalar3 center_i = (m_cluster_lo[c_i] + m_cluster_hi[c_i]) * Scalar(0.5);
+            const Scalar3 half_i = (m_cluster_hi[c_i] - m_cluster_lo[c_i]) * Scalar(0.5);
+            const unsigned int my_cell = m_cluster_cell[c_i];
+
+            // loop through all neighboring cells
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+
+                // local clusters of that cell, followed by its ghost clusters
+                for (unsigned int pass = 0; pass < 2; pass++)
+                    {
+                    const std::vector<unsigned int>& cell_start = (pass == 0) ? m_cell_local_start : m_cell_ghost_start;
+                    for (unsigned int c_j = cell_start[neigh_cell]; c_j < cell_start[neigh_cell+1]; c_j++)
+                        {
+                        // in half mode, a pair of local clusters is only stored by the lower cluster
+                        if (m_storage_mode == half && c_j < n_local && (int)c_j < c_i)
+                            continue;
+
+                        // distance between the bounding boxes
+                        const Scalar3 center_j = (m_cluster_lo[c_j] + m_cluster_hi[c_j]) * Scalar(0.5);
+                        const Scalar3 half_j = (m_cluster_hi[c_j] - m_cluster_lo[c_j]) * Scalar(0.5);
+                        Scalar3 d = box.minImage(center_j - center_i);
+                        d.x = std::max(Scalar(fabs(d.x)) - half_i.x - half_j.x, Scalar(0.0));
+                        d.y = std::max(Scalar(fabs(d.y)) - half_i.y - half_j.y, Scalar(0.0));
+                        d.z = std::max(Scalar(fabs(d.z)) - half_i.z - half_j.z, Scalar(0.0));
+                        if (dot(d,d) > rlistsq_max)
+                            continue;
+
+                        // build the interaction mask of the cluster pair
+                        const unsigned int *idx_j = &m_cluster_idx[c_j*M];
+                        uint64_t mask = 0;
+                        for (unsigned int a = 0; a < M; a++)
+                            {
+                            unsigned int i = idx_i[a];
+                            if (i == CLUSTER_EMPTY)
+                                continue;
+
+                            const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                            const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+                            const unsigned int body_i = h_body.data[i];
+                            const Scalar diam_i = h_diameter.data[i];
+
+                            // the pairs within a cluster are only stored once in half mode
+                            unsigned int b_first = (m_storage_mode == half && (int)c_j == c_i) ? a+1 : 0;
+                            for (unsigned int b = b_first; b < M; b++)
+                                {
+                                unsigned int j = idx_j[b];
+                                if (j == CLUSTER_EMPTY)
+                                    continue;
+
+                                unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+                                Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i,type_j)];
+
+                                // automatically exclude particles without a distance check when:
+                                // (1) they are the same particle, or
+                                // (2) the r_cut(i,j) indicates to skip, or
+                                // (3) they are in the same body
+                                bool excluded = ((i == j) || (r_cut <= Scalar(0.0)));
+                                if (m_filter_body && body_i != NO_BODY)
+                                    excluded = excluded | (body_i == h_body.data[j]);
+                                if (excluded)
+                                    continue;
+
+                                Scalar3 dx = my_pos - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                                dx = box.minImage(dx);
+
+                                Scalar r_list = r_cut + m_r_buff;
+                                Scalar sqshift = Scalar(0.0);
+                                if (m_diameter_shift)
+                                    {
+                                    const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
+                                    // r^2 < (r_list + delta)^2
+                                    // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                                    sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                                    }
+
+                                Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,type_j)];
+                                if (dot(dx,dx) <= (r_listsq + sqshift))
+                                    mask |= uint64_t(1) << (a*M + b);
+                                }
+                            }
+
+                        if (mask)
+                            {
+                            if (cur_n_neigh < nmax)
+                                {
+                                m_cluster_nlist[c_i*nmax + cur_n_neigh] = c_j;
+                                m_cluster_mask[c_i*nmax + cur_n_neigh] = mask;
+                                }
+                            cur_n_neigh++;
+                            }
+                        }
+                    }
+                }
+
+            m_cluster_n_neigh[c_i] = cur_n_neigh;
+            max_n_neigh = std::max(max_n_neigh, cur_n_neigh);
+            }
+        #ifdef ENABLE_TBB
+            );
+
+        unsigned int max_n_neigh = 0;
+        for (auto it = max_n_neigh_tls.begin(); it != max_n_neigh_tls.end(); ++it)
+            max_n_neigh = std::max(max_n_neigh, *it);
+        #endif
+
+        // grow the list to the next multiple of 8 on overflow
+        overflowed = (max_n_neigh > m_cluster_nmax);
+        if (overflowed)
+            m_cluster_nmax = (max_n_neigh + 7) & ~7;
+        } while (overflowed);
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Clears the bits of all excluded particle pairs from the interaction masks and removes cluster pairs that have no
+    remaining interactions.
+*/
+void NeighborListCluster::filterNlist()
+    {
+    if (m_prof)
+        m_prof->push("filter");
+
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+
+    const unsigned int M = m_cluster_size;
+    const unsigned int nmax = m_cluster_nmax;
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(0, (int)m_n_local_clusters, [&] (int c_i)
+    #else
+    for (int c_i = 0; c_i < (int)m_n_local_clusters; c_i++)
+    #endif
+        {
+        const unsigned int *idx_i = &m_cluster_idx[c_i*M];
+        const unsigned int n_neigh = m_cluster_n_neigh[c_i];
+        unsigned int new_n_neigh = 0;
+
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            const unsigned int c_j = m_cluster_nlist[c_i*nmax + k];
+            const unsigned int *idx_j = &m_cluster_idx[c_j*M];
+            uint64_t mask = m_cluster_mask[c_i*nmax + k];
+
+            for (unsigned int a = 0; a < M; a++)
+                {
+                unsigned int i = idx_i[a];
+                if (i == CLUSTER_EMPTY)
+                    continue;
+
+                unsigned int n_ex = h_n_ex_idx.data[i];
+                for (unsigned int cur_ex_idx = 0; cur_ex_idx < n_ex; cur_ex_idx++)
+                    {
+                    unsigned int cur_ex = h_ex_list_idx.data[m_ex_list_indexer(i, cur_ex_idx)];
+                    for (unsigned int b = 0; b < M; b++)
+                        {
+                        if (idx_j[b] == cur_ex)
+                            mask &= ~(uint64_t(1) << (a*M + b));
+                        }
+                    }
+                }
+
+            // keep the pair if anything is left to interact
+            if (mask)
+                {
+                m_cluster_nlist[c_i*nmax + new_n_neigh] = c_j;
+                m_cluster_mask[c_i*nmax + new_n_neigh] = mask;
+                new_n_neigh++;
+                }
+            }
+
+        m_cluster_n_neigh[c_i] = new_n_neigh;
+        }
+    #ifdef ENABLE_TBB
+        );
+    #endif
+
+    m_particle_list_valid = false;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! The per particle list is only built when it is requested. The number of neighbors of every particle is counted
+    first, then Nmax is grown where necessary and the head list is built as in NeighborList, and finally the pairs are
+    scattered into the rows.
+*/
+void NeighborListCluster::expandParticleList()
+    {
+    if (m_particle_list_valid)
+        return;
+
+    if (m_prof)
+        m_prof->push("expand");
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int M = m_cluster_size;
+    const unsigned int nmax = m_cluster_nmax;
+
+    // count the neighbors of every particle
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::readwrite);
+        memset(h_n_neigh.data, 0, sizeof(unsigned int)*N);
+
+        for (unsigned int c_i = 0; c_i < m_n_local_clusters; c_i++)
+            {
+            for (unsigned int k = 0; k < m_cluster_n_neigh[c_i]; k++)
+                {
+                const unsigned int c_j = m_cluster_nlist[c_i*nmax + k];
+                const uint64_t mask = m_cluster_mask[c_i*nmax + k];
+                for (unsigned int a = 0; a < M; a++)
+                    for (unsigned int b = 0; b < M; b++)
+                        {
+                        if (!((mask >> (a*M + b)) & 1))
+                            continue;
+
+                        unsigned int i = m_cluster_idx[c_i*M + a];
+                        unsigned int j = m_cluster_idx[c_j*M + b];
+                        h_n_neigh.data[(m_storage_mode == half && j < i) ? j : i]++;
+                        }
+                }
+            }
+
+        // the maximum number of neighbors per particle is rounded up to the nearest 8, with a minimum of 8
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+            unsigned int n = h_n_neigh.data[i];
+            if (n > h_Nmax.data[type_i])
+                h_Nmax.data[type_i] = (n > 8) ? (n + 7) & ~7 : 8;
+            }
+        }
+
+    NeighborList::buildHeadList();
+
+    // scatter the pairs into the rows
+        {
+        ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+        memset(h_n_neigh.data, 0, sizeof(unsigned int)*N);
+
+        for (unsigned int c_i = 0; c_i < m_n_local_clusters; c_i++)
+            {
+            for (unsigned int k = 0; k < m_cluster_n_neigh[c_i]; k++)
+                {
+                const unsigned int c_j = m_cluster_nlist[c_i*nmax + k];
+                const uint64_t mask = m_cluster_mask[c_i*nmax + k];
+                for (unsigned int a = 0; a < M; a++)
+                    for (unsigned int b = 0; b < M; b++)
+                        {
+                        if (!((mask >> (a*M + b)) & 1))
+                            continue;
+
+                        unsigned int i = m_cluster_idx[c_i*M + a];
+                        unsigned int j = m_cluster_idx[c_j*M + b];
+                        if (m_storage_mode == half && j < i)
+                            std::swap(i, j);
+
+                        h_nlist.data[h_head_list.data[i] + h_n_neigh.data[i]] = j;
+                        h_n_neigh.data[i]++;
+                        }
+                }
+            }
+        }
+
+    m_particle_list_valid = true;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_NeighborListCluster(py::module& m)
+    {
+    py::class_<NeighborListCluster, std::shared_ptr<NeighborListCluster> >(m, "NeighborListCluster", py::base<NeighborList>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, Scalar, std::shared_ptr<CellList>, unsigned int >())
+    .def("getClusterSize", &NeighborListCluster::getClusterSize)
+                     ;
+    }
@@ -0,0 +1,175 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "NeighborList.h"
+#include "hoomd/CellList.h"
+
+#include <vector>
+#include <stdint.h>
+
+/*! \file NeighborListCluster.h
+    \brief Declares the NeighborListCluster class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTCLUSTER_H__
+#define __NEIGHBORLISTCLUSTER_H__
+
+//! Cluster pair neighbor list on the CPU
+/*! Particles in every cell of a CellList are grouped into clusters of a fixed size M (4 or 8), sorted along z (y in
+    2D) so that each cluster is spatially compact. Local and ghost particles are never mixed within a cluster, and all
+    local clusters come before all ghost clusters. Unused lanes of the last cluster in a cell hold 0xffffffff.
+
+    Instead of one list entry per particle pair, the list stores pairs of clusters whose bounding boxes are within
+    r_list of each other. Every cluster pair carries an interaction mask with bit a*M+b set when particle a of the
+    i cluster and particle b of the j cluster are within r_list(i,j) and not filtered (same particle, r_cut <= 0,
+    same body, or excluded). In half storage mode, a cluster pair (ci, cj) with a local cj is only stored for ci <= cj,
+    and the diagonal pair (ci, ci) only has the bits with a < b set.
+
+    Consumers that understand clusters (PotentialPair) read getClusterNList() and getClusterMasks() directly. They
+    load the particle data of both clusters once per cluster pair and evaluate the pairs selected by the mask. For all
+    other consumers, the regular per particle list (getNNeighArray(), getNListArray() and getHeadList()) is expanded
+    from the cluster list the first time it is requested after a build. The expanded list follows the same conventions as the other neighbor
+    lists: up to Nmax neighbors per type, and the pair i-j is stored by min(i,j) in half mode.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListCluster : public NeighborList
+    {
+    public:
+        //! Constructs the compute
+        NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef,
+                            Scalar r_cut,
+                            Scalar r_buff,
+                            std::shared_ptr<CellList> cl = std::shared_ptr<CellList>(),
+                            unsigned int cluster_size = 4);
+
+        //! Destructor
+        virtual ~NeighborListCluster();
+
+        //! Change the cutoff radius for all pairs
+        virtual void setRCut(Scalar r_cut, Scalar r_buff);
+
+        //! Set the cutoff radius by pair type
+        virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
+
+        //! Set the maximum diameter to use in computing neighbor lists
+        virtual void setMaximumDiameter(Scalar d_max);
+
+        //! Print statistics on the neighborlist
+        virtual void printStats();
+
+        //! Get the number of neighbors array
+        virtual const GlobalArray<unsigned int>& getNNeighArray()
+            {
+            expandParticleList();
+            return m_n_neigh;
+            }
+
+        //! Get the neighbor list
+        virtual const GlobalArray<unsigned int>& getNListArray()
+            {
+            expandParticleList();
+            return m_nlist;
+            }
+
+        //! Get the head list
+        virtual const GlobalArray<unsigned int>& getHeadList()
+            {
+            expandParticleList();
+            return m_head_list;
+            }
+
+        //! Get the number of particles per cluster
+        unsigned int getClusterSize() const
+            {
+            return m_cluster_size;
+            }
+
+        //! Get the number of clusters of local particles
+        unsigned int getNumLocalClusters() const
+            {
+            return m_n_local_clusters;
+            }
+
+        //! Get the particle indices of all clusters (getClusterSize() per cluster, 0xffffffff for unused lanes)
+        const std::vector<unsigned int>& getClusterParticles() const
+            {
+            return m_cluster_idx;
+            }
+
+        //! Get the number of neighboring clusters of every local cluster
+        const std::vector<unsigned int>& getClusterNNeigh() const
+            {
+            return m_cluster_n_neigh;
+            }
+
+        //! Get the maximum number of neighboring clusters stored per local cluster
+        /*! The neighbors of local cluster ci start at ci*getClusterNmax() in getClusterNList() and getClusterMasks()
+        */
+        unsigned int getClusterNmax() const
+            {
+            return m_cluster_nmax;
+            }
+
+        //! Get the neighboring clusters
+        const std::vector<unsigned int>& getClusterNList() const
+            {
+            return m_cluster_nlist;
+            }
+
+        //! Get the interaction masks of the cluster pairs
+        const std::vector<uint64_t>& getClusterMasks() const
+            {
+            return m_cluster_mask;
+            }
+
+    protected:
+        std::shared_ptr<CellList> m_cl;   //!< The cell list
+        unsigned int m_cluster_size;      //!< Number of particles per cluster (M)
+
+        unsigned int m_n_local_clusters;                 //!< Number of clusters of local particles
+        std::vector<unsigned int> m_cluster_idx;         //!< Particle indices of every cluster
+        std::vector<unsigned int> m_cluster_cell;        //!< Cell of every cluster
+        std::vector<Scalar3> m_cluster_lo;               //!< Lower corner of the bounding box of every cluster
+        std::vector<Scalar3> m_cluster_hi;               //!< Upper corner of the bounding box of every cluster
+        std::vector<unsigned int> m_cell_local_start;    //!< First local cluster of every cell (plus one past the end)
+        std::vector<unsigned int> m_cell_ghost_start;    //!< First ghost cluster of every cell (plus one past the end)
+
+        unsigned int m_cluster_nmax;                     //!< Maximum number of cluster neighbors per local cluster
+        std::vector<unsigned int> m_cluster_n_neigh;     //!< Number of neighboring clusters of every local cluster
+        std::vector<unsigned int> m_cluster_nlist;       //!< Neighboring clusters
+        std::vector<uint64_t> m_cluster_mask;            //!< Interaction masks of the cluster pairs
+
+        bool m_particle_list_valid;       //!< True if the per particle list has been expanded since the last build
+
+        //! Builds the neighbor list
+        virtual void buildNlist(unsigned int timestep);
+
+        //! Filter the neighbor list of excluded particles
+        virtual void filterNlist();
+
+        //! The head list of the per particle list is built by expandParticleList()
+        virtual void buildHeadList()
+            {
+            }
+
+        //! Sort the particles in the cell list into clusters
+        void buildClusters();
+
+        //! Build the per particle neighbor list from the cluster pairs
+        void expandParticleList();
+    };
+
+//! Exports NeighborListCluster to python
+void export_NeighborListCluster(pybind11::module& m);
+
+#endif
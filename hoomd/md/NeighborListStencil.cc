@@ -14,6 +14,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 /*!
@@ -194,8 +198,22 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
+    #ifdef ENABLE_TBB
+    // every particle only writes to its own row of the neighbor list, so the rows are built in parallel
+    // overflows are tracked per thread and combined after the loop
+    tbb::enumerable_thread_specific< std::vector<unsigned int> >
+        conditions_tls(std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+    tbb::parallel_for(0, (int)nparticles, [&] (int i)
+    #else
     for (int i = 0; i < (int)nparticles; i++)
+    #endif
         {
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int>& conditions = conditions_tls.local();
+        #else
+        unsigned int *conditions = h_conditions.data;
+        #endif
+
         unsigned int cur_n_neigh = 0;
 
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -326,7 +344,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i] = max(h_conditions.data[type_i], cur_n_neigh+1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh+1);
 
                         ++cur_n_neigh;
                         }
@@ -336,6 +354,14 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
         h_n_neigh.data[i] = cur_n_neigh;
         }
+    #ifdef ENABLE_TBB
+        );
+
+    // combine the overflow conditions of all threads
+    for (auto it = conditions_tls.begin(); it != conditions_tls.end(); ++it)
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            h_conditions.data[cur_type] = max(h_conditions.data[cur_type], (*it)[cur_type]);
+    #endif
 
     if (m_prof)
         m_prof->pop(m_exec_conf);
@@ -17,6 +17,10 @@ namespace py = pybind11;
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 using namespace hpmc::detail;
 
@@ -275,10 +279,9 @@ void NeighborListTree::buildTree()
     }
 
 /*!
- * Each AABBTree is traversed in a stackless fashion. One traversal is performed (per particle)-(per tree)-(per image).
- * The stackless traversal is a variation on left descent, where each node knows how far ahead to advance in the list
- * of nodes if there is no intersection between the current node AABB and the query AABB. Otherwise, the search advances
- * by one to the next node in the list.
+ * One traversal is performed (per particle)-(per tree)-(per image). Each query tests the query AABB against all children
+ * of a wide tree node at once (see AABBTreeWide), and returns the leaf nodes whose particles are then checked against
+ * the cutoff.
  */
 void NeighborListTree::traverseTree()
     {
@@ -298,9 +301,30 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    #ifndef ENABLE_TBB
+    // leaf nodes of the AABB trees found by a query
+    std::vector<unsigned int> hits;
+    #endif
+
     // Loop over all particles
+    #ifdef ENABLE_TBB
+    // every particle only writes to its own row of the neighbor list, so the rows are built in parallel
+    // overflows are tracked per thread and combined after the loop
+    tbb::enumerable_thread_specific< std::vector<unsigned int> >
+        conditions_tls(std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+    tbb::enumerable_thread_specific< std::vector<unsigned int> > hits_tls;
+    tbb::parallel_for((unsigned int)0, m_pdata->getN(), [&] (unsigned int i)
+    #else
     for (unsigned int i=0; i < m_pdata->getN(); ++i)
+    #endif
         {
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int>& conditions = conditions_tls.local();
+        std::vector<unsigned int>& hits = hits_tls.local();
+        #else
+        unsigned int *conditions = h_conditions.data;
+        #endif
+
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
         const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
@@ -334,7 +358,7 @@ void NeighborListTree::traverseTree()
             if (m_diameter_shift)
                 r_list_i += m_d_max - Scalar(1.0);
 
-            AABBTree *cur_aabb_tree = &m_aabb_trees[cur_pair_type];
+            AABBTreeWide *cur_aabb_tree = &m_aabb_trees[cur_pair_type];
 
             for (unsigned int cur_image = 0; cur_image < m_n_images; ++cur_image) // for each image vector
                 {
@@ -342,69 +366,69 @@ void NeighborListTree::traverseTree()
                 vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
                 AABB aabb = AABB(pos_i_image, r_list_i);
 
-                // stackless traversal of the tree
-                for (unsigned int cur_node_idx = 0; cur_node_idx < cur_aabb_tree->getNumNodes(); ++cur_node_idx)
+                // find the leaf nodes of the tree that overlap
+                hits.clear();
+                cur_aabb_tree->queryNodes(hits, aabb);
+                for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
                     {
-                    if (overlap(cur_aabb_tree->getNodeAABB(cur_node_idx), aabb))
+                    unsigned int cur_node_idx = hits[cur_hit];
+                    for (unsigned int cur_p = 0; cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx); ++cur_p)
                         {
-                        if (cur_aabb_tree->isNodeLeaf(cur_node_idx))
+                        // neighbor j
+                        unsigned int j = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
+
+                        // skip self-interaction always
+                        bool excluded = (i == j);
+
+                        if (m_filter_body && body_i != NO_BODY)
+                            excluded = excluded | (body_i == h_body.data[j]);
+
+                        if (!excluded)
                             {
-                            for (unsigned int cur_p = 0; cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx); ++cur_p)
+                            // now we can trim down the actual particles based on diameter
+                            // compute the shift for the cutoff if not excluded
+                            Scalar sqshift = Scalar(0.0);
+                            if (m_diameter_shift)
                                 {
-                                // neighbor j
-                                unsigned int j = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
-
-                                // skip self-interaction always
-                                bool excluded = (i == j);
+                                const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
+                                // r^2 < (r_list + delta)^2
+                                // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                                sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
+                                }
 
-                                if (m_filter_body && body_i != NO_BODY)
-                                    excluded = excluded | (body_i == h_body.data[j]);
+                            // compute distance
+                            Scalar4 postype_j = h_postype.data[j];
+                            Scalar3 drij = make_scalar3(postype_j.x,postype_j.y,postype_j.z)
+                                           - vec_to_scalar3(pos_i_image);
+                            Scalar dr_sq = dot(drij,drij);
 
-                                if (!excluded)
+                            if (dr_sq <= (r_cutsq_i + sqshift))
+                                {
+                                if (m_storage_mode == full || i < j)
                                     {
-                                    // now we can trim down the actual particles based on diameter
-                                    // compute the shift for the cutoff if not excluded
-                                    Scalar sqshift = Scalar(0.0);
-                                    if (m_diameter_shift)
-                                        {
-                                        const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
-                                        // r^2 < (r_list + delta)^2
-                                        // r^2 < r_listsq + delta^2 + 2*r_list*delta
-                                        sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
-                                        }
-
-                                    // compute distance
-                                    Scalar4 postype_j = h_postype.data[j];
-                                    Scalar3 drij = make_scalar3(postype_j.x,postype_j.y,postype_j.z)
-                                                   - vec_to_scalar3(pos_i_image);
-                                    Scalar dr_sq = dot(drij,drij);
-
-                                    if (dr_sq <= (r_cutsq_i + sqshift))
-                                        {
-                                        if (m_storage_mode == full || i < j)
-                                            {
-                                            if (n_neigh_i < Nmax_i)
-                                                h_nlist.data[nlist_head_i + n_neigh_i] = j;
-                                            else
-                                                h_conditions.data[type_i] = max(h_conditions.data[type_i], n_neigh_i+1);
-
-                                            ++n_neigh_i;
-                                            }
-                                        }
+                                    if (n_neigh_i < Nmax_i)
+                                        h_nlist.data[nlist_head_i + n_neigh_i] = j;
+                                    else
+                                        conditions[type_i] = max(conditions[type_i], n_neigh_i+1);
+
+                                    ++n_neigh_i;
                                     }
                                 }
                             }
                         }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += cur_aabb_tree->getNodeSkip(cur_node_idx);
-                        }
                     } // end stackless search
                 } // end loop over images
             } // end loop over pair types
             h_n_neigh.data[i] = n_neigh_i;
         } // end loop over particles
+    #ifdef ENABLE_TBB
+        );
+
+    // combine the overflow conditions of all threads
+    for (auto it = conditions_tls.begin(); it != conditions_tls.end(); ++it)
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            h_conditions.data[cur_type] = max(h_conditions.data[cur_type], (*it)[cur_type]);
+    #endif
 
     if (this->m_prof) this->m_prof->pop();
     }
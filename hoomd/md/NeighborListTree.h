@@ -25,7 +25,8 @@
 /*!
  * A bounding volume hierarchy (BVH) tree is a binary search tree. It is constructed from axis-aligned bounding boxes
  * (AABBs). The AABB for a node in the tree encloses all child AABBs. A leaf AABB holds multiple particles. The tree
- * is constructed in a balanced way using a heuristic to minimize AABB volume. We build one tree per particle type,
+ * is constructed in a balanced way using a heuristic to minimize AABB volume, and collapsed into a tree with 4 or 8
+ * children per node that are tested against a query AABB with SIMD instructions. We build one tree per particle type,
  * and use point AABBs for the particles. The neighbor list is built by traversing down the tree with an AABB
  * that encloses the pairwise cutoff for the particle. Periodic boundaries are treated by translating the query AABB
  * by all possible image vectors, many of which are trivially rejected for not intersecting the root node.
@@ -84,7 +85,7 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
 
         // we use stl vectors here because these tree data structures should *never* be
         // accessed on the GPU, they were optimized for the CPU with SIMD support
-        std::vector<hpmc::detail::AABBTree>      m_aabb_trees;     //!< Flat array of AABB trees of all types
+        std::vector<hpmc::detail::AABBTreeWide>  m_aabb_trees;     //!< Flat array of AABB trees of all types
         GPUVector<hpmc::detail::AABB>            m_aabbs;          //!< Flat array of AABBs of all types
         std::vector<unsigned int>  m_num_per_type;   //!< Total number of particles per type
         std::vector<unsigned int>  m_type_head;      //!< Index of first particle of each type, after sorting
@@ -31,6 +31,8 @@ OPLSDihedralForceCompute::OPLSDihedralForceCompute(std::shared_ptr<SystemDefinit
 
     // access the dihedral data for later use
     m_dihedral_data = m_sysdef->getDihedralData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<DihedralData> >(
+        new BondedGroupColoring<DihedralData>(m_pdata, m_dihedral_data));
 
     // check for some silly errors a user could make
     if (m_dihedral_data->getNTypes() == 0)
@@ -130,26 +132,28 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
     unsigned int virial_pitch = m_virial.getPitch();
 
-    // From LAMMPS OPLS dihedral implementation
-    unsigned int i1,i2,i3,i4,n,dihedral_type;
-    Scalar3 vb1,vb2,vb3,vb2m;
-    Scalar4 f1,f2,f3,f4;
-    Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
-    Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
-    Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
-    Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
-    Scalar k1,k2,k3,k4;
-    Scalar dihedral_virial[6];
-
     // get a local copy of the simulation box
     const BoxDim& box = m_pdata->getBox();
 
-    // iterate through each dihedral
-    const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
-    for (n = 0; n < numDihedrals; n++)
+    ArrayHandle<DihedralData::members_t> h_groups(m_dihedral_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // iterate through each dihedral, dihedrals that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int n)
         {
+        // From LAMMPS OPLS dihedral implementation
+        unsigned int i1,i2,i3,i4,dihedral_type;
+        Scalar3 vb1,vb2,vb3,vb2m;
+        Scalar4 f1,f2,f3,f4;
+        Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
+        Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
+        Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
+        Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
+        Scalar k1,k2,k3,k4;
+        Scalar dihedral_virial[6];
+
         // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
+        const ImproperData::members_t& dihedral = h_groups.data[n];
         assert(dihedral.tag[0] < m_pdata->getNGlobal());
         assert(dihedral.tag[1] < m_pdata->getNGlobal());
         assert(dihedral.tag[2] < m_pdata->getNGlobal());
@@ -231,7 +235,7 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
         // get values for k1/2 through k4/2
         // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
+        dihedral_type = h_typeval.data[n].type;
         k1 = h_params.data[dihedral_type].x;
         k2 = h_params.data[dihedral_type].y;
         k3 = h_params.data[dihedral_type].z;
@@ -350,7 +354,7 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
             h_virial.data[virial_pitch*k+i3]  += dihedral_virial[k];
             h_virial.data[virial_pitch*k+i4]  += dihedral_virial[k];
             }
-        }
+        });
 
     if (m_prof) m_prof->pop();
     }
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedGroupColoring.h"
 
 #include <memory>
 #include <vector>
@@ -65,6 +66,7 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
 
         //!< Dihedral data to use in computing dihedrals
         std::shared_ptr<DihedralData> m_dihedral_data;
+        std::shared_ptr< BondedGroupColoring<DihedralData> > m_coloring; //!< Distributes the dihedrals over threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
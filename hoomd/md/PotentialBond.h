@@ -4,6 +4,7 @@
 #include <memory>
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "BondedGroupColoring.h"
 
 #include <vector>
 
@@ -55,6 +56,7 @@ class PotentialBond : public ForceCompute
     protected:
         GPUArray<param_type> m_params;              //!< Bond parameters per type
         std::shared_ptr<BondData> m_bond_data;    //!< Bond data to use in computing bonds
+        std::shared_ptr< BondedGroupColoring<BondData> > m_coloring; //!< Distributes the bonds over threads
         std::string m_log_name;                     //!< Cached log name
         std::string m_prof_name;                    //!< Cached profiler name
 
@@ -75,6 +77,8 @@ PotentialBond< evaluator >::PotentialBond(std::shared_ptr<SystemDefinition> sysd
 
     // access the bond data for later use
     m_bond_data = m_sysdef->getBondData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<BondData> >(
+        new BondedGroupColoring<BondData>(m_pdata, m_bond_data));
     m_log_name = std::string("bond_") + evaluator::getName() + std::string("_energy") + log_suffix;
     m_prof_name = std::string("Bond ") + evaluator::getName();
 
@@ -178,18 +182,14 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
-
-    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(),
+        access_location::host, access_mode::read);
     ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
 
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
 
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // for each of the bonds, bonds that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the bond
         const typename BondData::members_t& bond = h_bonds.data[i];
@@ -260,6 +260,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         if (evaluated)
             {
             // calculate virial
+            Scalar bond_virial[6];
             if (compute_virial)
                 {
                 Scalar force_div2r = Scalar(1.0/2.0)*force_divr;
@@ -299,7 +300,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
             throw std::runtime_error("Error in bond calculation");
             }
-        }
+        });
 
     if (m_prof) m_prof->pop();
     }
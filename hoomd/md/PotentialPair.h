@@ -18,6 +18,7 @@
 #include "hoomd/GlobalArray.h"
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
+#include "NeighborListCluster.h"
 
 #ifdef ENABLE_CUDA
 #include <cuda_runtime.h>
@@ -27,6 +28,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -126,6 +131,12 @@ class PotentialPair : public ForceCompute
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! The forces on interior particles are computed while the ghost update is pending
+        virtual bool canOverlapGhostUpdate()
+            {
+            return true;
+            }
         #endif
 
         //! Calculates the energy between two lists of particles.
@@ -147,9 +158,76 @@ class PotentialPair : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        #ifdef ENABLE_TBB
+        std::vector<unsigned int> m_block_start;    //!< First particle of every thread block (plus one past the end)
+        std::vector<unsigned int> m_block_first_idx; //!< First particle index written by every thread block
+        std::vector<unsigned int> m_block_last_idx; //!< One past the last particle index written by every thread block
+        std::vector< std::vector<Scalar4> > m_block_force;  //!< Forces accumulated by every thread block
+        std::vector< std::vector<Scalar> > m_block_virial;  //!< Virials accumulated by every thread block
+        #endif
+
+        #ifdef ENABLE_MPI
+        std::vector<unsigned int> m_n_neigh_interior; //!< Neighbors of particles without ghost neighbors (0 otherwise)
+        std::vector<unsigned int> m_n_neigh_boundary; //!< Neighbors of particles with ghost neighbors (0 otherwise)
+        unsigned int m_boundary_nlist_builds;         //!< Neighbor list build the interior and boundary rows belong to
+
+        //! Split the neighbor list rows into interior and boundary particles
+        void updateBoundaryRows(const unsigned int *n_neigh, const unsigned int *nlist, const unsigned int *head_list);
+        #endif
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Distribute the force computation over contiguous blocks of work items
+        template<class Kernel, class IndexRange>
+        void computeForcesBlocks(unsigned int n_items,
+                                 const unsigned int *n_work,
+                                 Scalar4 *force,
+                                 Scalar *virial,
+                                 bool third_law,
+                                 bool compute_virial,
+                                 const Kernel& kernel,
+                                 const IndexRange& index_range);
+
+        //! Compute the forces on a contiguous range of clusters of a cluster pair neighbor list
+        template<unsigned int M>
+        void computeForcesCluster(const NeighborListCluster& nlist,
+                                  unsigned int first,
+                                  unsigned int last,
+                                  const Scalar4 *pos,
+                                  const Scalar *diameter,
+                                  const Scalar *charge,
+                                  const Scalar *ronsq_data,
+                                  const Scalar *rcutsq_data,
+                                  const param_type *params,
+                                  const BoxDim& box,
+                                  Scalar4 *force,
+                                  Scalar *virial,
+                                  unsigned int virial_pitch,
+                                  unsigned int offset,
+                                  bool third_law,
+                                  bool compute_virial);
+
+        //! Compute the forces on a contiguous range of particles
+        void computeForcesRange(unsigned int first,
+                                unsigned int last,
+                                const unsigned int *n_neigh,
+                                const unsigned int *nlist,
+                                const unsigned int *head_list,
+                                const Scalar4 *pos,
+                                const Scalar *diameter,
+                                const Scalar *charge,
+                                const Scalar *ronsq_data,
+                                const Scalar *rcutsq_data,
+                                const param_type *params,
+                                const BoxDim& box,
+                                Scalar4 *force,
+                                Scalar *virial,
+                                unsigned int virial_pitch,
+                                unsigned int offset,
+                                bool third_law,
+                                bool compute_virial);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -201,8 +279,13 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift),
+      m_typpair_idx(m_pdata->getNTypes())
     {
+    #ifdef ENABLE_MPI
+    m_boundary_nlist_builds = 0;
+    #endif
+
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
     assert(m_pdata);
@@ -353,6 +436,22 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
 template< class evaluator >
 void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     {
+    // cluster pair neighbor lists are evaluated directly, without expanding them to a per particle list
+    std::shared_ptr<NeighborListCluster> nlist_cluster = std::dynamic_pointer_cast<NeighborListCluster>(m_nlist);
+
+    #ifdef ENABLE_MPI
+    // with a pending ghost update, the forces on interior particles are computed while the ghost positions are in
+    // flight. This requires a current neighbor list, because a rebuild accesses the ghost positions.
+    bool overlap = false;
+    if (m_comm && m_comm->isGhostUpdatePending())
+        {
+        if (!nlist_cluster && m_nlist->isCurrent(timestep))
+            overlap = true;
+        else
+            m_comm->finishUpdateGhosts(timestep);
+        }
+    #endif
+
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
@@ -363,13 +462,7 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
-    // access the neighbor list, particle data, and system box
-    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
-//     Index2D nli = m_nlist->getNListIndexer();
-    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
-
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    // access the particle data and system box
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
@@ -391,12 +484,331 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    if (nlist_cluster)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+        const NeighborListCluster& nlist = *nlist_cluster;
+        const bool large_clusters = (nlist.getClusterSize() == 8);
+        auto kernel = [&](unsigned int first, unsigned int last, Scalar4 *force, Scalar *virial,
+                          unsigned int virial_pitch, unsigned int offset)
+            {
+            if (large_clusters)
+                computeForcesCluster<8>(nlist, first, last, h_pos.data, h_diameter.data, h_charge.data,
+                                        h_ronsq.data, h_rcutsq.data, h_params.data,
+                                        box, force, virial, virial_pitch, offset, third_law, compute_virial);
+            else
+                computeForcesCluster<4>(nlist, first, last, h_pos.data, h_diameter.data, h_charge.data,
+                                        h_ronsq.data, h_rcutsq.data, h_params.data,
+                                        box, force, virial, virial_pitch, offset, third_law, compute_virial);
+            };
+
+        // the local particles of the clusters in [first, last) and of their neighbor clusters
+        auto index_range = [&](unsigned int first, unsigned int last, unsigned int& first_idx, unsigned int& last_idx)
+            {
+            const unsigned int N = m_pdata->getN();
+            const unsigned int M = nlist.getClusterSize();
+            const unsigned int nmax = nlist.getClusterNmax();
+            const unsigned int *cluster_idx = nlist.getClusterParticles().data();
+            const unsigned int *cluster_n_neigh = nlist.getClusterNNeigh().data();
+            const unsigned int *cluster_nlist = nlist.getClusterNList().data();
+            for (unsigned int c_i = first; c_i < last; c_i++)
+                {
+                for (unsigned int k = 0; k <= cluster_n_neigh[c_i]; k++)
+                    {
+                    const unsigned int c = (k == 0) ? c_i : cluster_nlist[c_i*nmax + k - 1];
+                    for (unsigned int a = 0; a < M; a++)
+                        {
+                        const unsigned int idx = cluster_idx[c*M + a];
+                        if (idx >= N)
+                            continue;
+                        first_idx = std::min(first_idx, idx);
+                        last_idx = std::max(last_idx, idx+1);
+                        }
+                    }
+                }
+            };
+
+        computeForcesBlocks(nlist.getNumLocalClusters(), nlist.getClusterNNeigh().data(),
+                            h_force.data, h_virial.data, third_law, compute_virial, kernel, index_range);
+        }
+    else
+        {
+        // access the neighbor list
+        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+        const unsigned int *n_neigh = h_n_neigh.data;
+        const Scalar4 *pos = NULL;
+        auto kernel = [&](unsigned int first, unsigned int last, Scalar4 *force, Scalar *virial,
+                          unsigned int virial_pitch, unsigned int offset)
+            {
+            computeForcesRange(first, last,
+                               n_neigh, h_nlist.data, h_head_list.data,
+                               pos, h_diameter.data, h_charge.data,
+                               h_ronsq.data, h_rcutsq.data, h_params.data,
+                               box, force, virial, virial_pitch, offset, third_law, compute_virial);
+            };
+
+        // the particles in [first, last) and their local neighbors
+        auto index_range = [&](unsigned int first, unsigned int last, unsigned int& first_idx, unsigned int& last_idx)
+            {
+            const unsigned int N = m_pdata->getN();
+            first_idx = std::min(first_idx, first);
+            last_idx = std::max(last_idx, last);
+            for (unsigned int i = first; i < last; i++)
+                {
+                const unsigned int myHead = h_head_list.data[i];
+                for (unsigned int k = 0; k < n_neigh[i]; k++)
+                    {
+                    const unsigned int j = h_nlist.data[myHead + k];
+                    if (j >= N)
+                        continue;
+                    first_idx = std::min(first_idx, j);
+                    last_idx = std::max(last_idx, j+1);
+                    }
+                }
+            };
+
+        #ifdef ENABLE_MPI
+        if (overlap)
+            {
+            updateBoundaryRows(h_n_neigh.data, h_nlist.data, h_head_list.data);
+
+            // interior particles only access local particle data
+                {
+                ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+                pos = h_pos.data;
+                n_neigh = m_n_neigh_interior.data();
+                computeForcesBlocks(m_pdata->getN(), n_neigh, h_force.data, h_virial.data, third_law, compute_virial,
+                                    kernel, index_range);
+                }
+
+            // the particle positions must be released while the communicator completes the update
+            m_comm->finishUpdateGhosts(timestep);
+
+            // add the forces on the boundary particles
+            n_neigh = m_n_neigh_boundary.data();
+            }
+        #endif
+
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        pos = h_pos.data;
+        computeForcesBlocks(m_pdata->getN(), n_neigh, h_force.data, h_virial.data, third_law, compute_virial,
+                            kernel, index_range);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param n_neigh Number of neighbors per particle
+    \param nlist Neighbor list
+    \param head_list Offset of each particle's neighbors in \a nlist
+
+    A particle is a boundary particle if any of its neighbors is a ghost. The rows are only recomputed after the
+    neighbor list has been built, since the ghost indices do not change in between.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::updateBoundaryRows(const unsigned int *n_neigh,
+                                                    const unsigned int *nlist,
+                                                    const unsigned int *head_list)
+    {
+    const unsigned int N = m_pdata->getN();
+    if (m_n_neigh_interior.size() == N && m_boundary_nlist_builds == m_nlist->getNumBuilds())
+        return;
+
+    m_n_neigh_interior.resize(N);
+    m_n_neigh_boundary.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        bool boundary = false;
+        const unsigned int myHead = head_list[i];
+        for (unsigned int k = 0; k < n_neigh[i]; k++)
+            {
+            if (nlist[myHead + k] >= N)
+                {
+                boundary = true;
+                break;
+                }
+            }
+
+        m_n_neigh_interior[i] = boundary ? 0 : n_neigh[i];
+        m_n_neigh_boundary[i] = boundary ? n_neigh[i] : 0;
+        }
+
+    m_boundary_nlist_builds = m_nlist->getNumBuilds();
+    }
+#endif
+
+/*! \param n_items Number of work items (particles or clusters)
+    \param n_work Number of neighbors of every work item, used to balance the blocks
+    \param force Force array to add the computed forces and energies to
+    \param virial Virial array to add the computed virials to
+    \param third_law True if the neighbor list is stored in half mode
+    \param compute_virial True if the virial is requested
+    \param kernel Functor called as kernel(first, last, force, virial, virial_pitch, offset) to add the forces of the
+           work items in [first, last), where force[0] belongs to particle index offset
+    \param index_range Functor called as index_range(first, last, first_idx, last_idx) to extend [first_idx, last_idx)
+           to all local particle indices the kernel writes for the work items in [first, last)
+
+    Without TBB or with a single thread, the kernel is called once for all work items. With a full neighbor list,
+    every block only writes to its own particles and adds to \a force directly. With a half neighbor list, the
+    reaction forces of a block also land on particles of other blocks. Every block then accumulates into its own
+    buffer, which only spans the particle indices the block writes, and the buffers are added to \a force in block
+    order.
+*/
+template< class evaluator >
+template< class Kernel, class IndexRange >
+void PotentialPair< evaluator >::computeForcesBlocks(unsigned int n_items,
+                                                     const unsigned int *n_work,
+                                                     Scalar4 *force,
+                                                     Scalar *virial,
+                                                     bool third_law,
+                                                     bool compute_virial,
+                                                     const Kernel& kernel,
+                                                     const IndexRange& index_range)
+    {
+    #ifdef ENABLE_TBB
+    const unsigned int num_blocks = m_exec_conf->getNumThreads();
+    if (num_blocks > 1 && n_items > num_blocks)
+        {
+        // partition the work items into contiguous blocks with roughly equal numbers of neighbors
+        // the partition only depends on the neighbor list and the number of threads, so the summation order
+        // (and therefore the result) is bitwise reproducible for a given number of threads
+        m_block_start.resize(num_blocks+1);
+        unsigned long long n_work_total = 0;
+        for (unsigned int i = 0; i < n_items; i++)
+            n_work_total += n_work[i] + 1;
+
+        unsigned long long n_work_cur = 0;
+        unsigned int cur_block = 1;
+        m_block_start[0] = 0;
+        for (unsigned int i = 0; i < n_items && cur_block < num_blocks; i++)
+            {
+            n_work_cur += n_work[i] + 1;
+            while (cur_block < num_blocks && n_work_cur*num_blocks >= n_work_total*cur_block)
+                m_block_start[cur_block++] = i+1;
+            }
+        while (cur_block <= num_blocks)
+            m_block_start[cur_block++] = n_items;
+
+        if (!third_law)
+            {
+            // with a full neighbor list, every block only writes to the particles in its own range
+            tbb::parallel_for((unsigned int)0, num_blocks, [&](unsigned int b)
+                {
+                kernel(m_block_start[b], m_block_start[b+1], force, virial, m_virial_pitch, 0);
+                });
+
+            return;
+            }
+
+        m_block_first_idx.resize(num_blocks);
+        m_block_last_idx.resize(num_blocks);
+        m_block_force.resize(num_blocks);
+        m_block_virial.resize(num_blocks);
+
+        const unsigned int N = m_pdata->getN();
+        tbb::parallel_for((unsigned int)0, num_blocks, [&](unsigned int b)
+            {
+            unsigned int first_idx = N;
+            unsigned int last_idx = 0;
+            index_range(m_block_start[b], m_block_start[b+1], first_idx, last_idx);
+            if (last_idx <= first_idx)
+                first_idx = last_idx = 0;
+            m_block_first_idx[b] = first_idx;
+            m_block_last_idx[b] = last_idx;
+
+            // the buffers keep their capacity between steps
+            const unsigned int n_idx = last_idx - first_idx;
+            m_block_force[b].assign(n_idx, make_scalar4(0, 0, 0, 0));
+            if (compute_virial)
+                m_block_virial[b].assign(6*n_idx, Scalar(0.0));
+
+            kernel(m_block_start[b], m_block_start[b+1], m_block_force[b].data(), m_block_virial[b].data(), n_idx,
+                   first_idx);
+            });
+
+        // add the buffers in block order, so that the result does not depend on the scheduling
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N), [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int b = 0; b < num_blocks; b++)
+                {
+                const unsigned int first_idx = m_block_first_idx[b];
+                const unsigned int n_idx = m_block_last_idx[b] - first_idx;
+                const unsigned int begin = std::max(r.begin(), first_idx);
+                const unsigned int end = std::min(r.end(), m_block_last_idx[b]);
+                for (unsigned int i = begin; i < end; i++)
+                    {
+                    const Scalar4& f = m_block_force[b][i - first_idx];
+                    force[i].x += f.x;
+                    force[i].y += f.y;
+                    force[i].z += f.z;
+                    force[i].w += f.w;
+                    if (compute_virial)
+                        for (unsigned int v = 0; v < 6; v++)
+                            virial[v*m_virial_pitch+i] += m_block_virial[b][v*n_idx + i - first_idx];
+                    }
+                }
+            });
+
+        return;
+        }
+    #endif
+
+    kernel(0, n_items, force, virial, m_virial_pitch, 0);
+    }
+
+/*! \param first Index of the first particle to compute forces on
+    \param last One past the index of the last particle to compute forces on
+    \param n_neigh Number of neighbors per particle
+    \param nlist Neighbor list
+    \param head_list Offset of each particle's neighbors in \a nlist
+    \param pos Particle positions and types
+    \param diameter Particle diameters
+    \param charge Particle charges
+    \param ronsq_data r_on squared per type pair
+    \param rcutsq_data r_cut squared per type pair
+    \param params Pair parameters per type pair
+    \param box The global simulation box
+    \param force Force array to add the computed forces and energies to
+    \param virial Virial array to add the computed virials to
+    \param virial_pitch Pitch of \a virial
+    \param offset Index of the particle stored in the first element of \a force and \a virial
+    \param third_law True if the neighbor list is stored in half mode
+    \param compute_virial True if the virial is requested
+
+    Forces on particles \a i in [\a first, \a last) are summed into \a force and \a virial. With \a third_law, the
+    reaction forces on their local neighbors are added as well.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeForcesRange(unsigned int first,
+                                                    unsigned int last,
+                                                    const unsigned int *n_neigh,
+                                                    const unsigned int *nlist,
+                                                    const unsigned int *head_list,
+                                                    const Scalar4 *pos,
+                                                    const Scalar *diameter,
+                                                    const Scalar *charge,
+                                                    const Scalar *ronsq_data,
+                                                    const Scalar *rcutsq_data,
+                                                    const param_type *params,
+                                                    const BoxDim& box,
+                                                    Scalar4 *force,
+                                                    Scalar *virial,
+                                                    unsigned int virial_pitch,
+                                                    unsigned int offset,
+                                                    bool third_law,
+                                                    bool compute_virial)
+    {
+    // for each particle in the range
+    for (unsigned int i = first; i < last; i++)
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        Scalar3 pi = make_scalar3(pos[i].x, pos[i].y, pos[i].z);
+        unsigned int typei = __scalar_as_int(pos[i].w);
 
         // sanity check
         assert(typei < m_pdata->getNTypes());
@@ -405,9 +817,9 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         Scalar di = Scalar(0.0);
         Scalar qi = Scalar(0.0);
         if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
+            di = diameter[i];
         if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+            qi = charge[i];
 
         // initialize current particle force, potential energy, and virial to 0
         Scalar3 fi = make_scalar3(0, 0, 0);
@@ -420,29 +832,29 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         Scalar virialzzi = 0.0;
 
         // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int myHead = head_list[i];
+        const unsigned int size = (unsigned int)n_neigh[i];
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
+            unsigned int j = nlist[myHead + k];
             assert(j < m_pdata->getN() + m_pdata->getNGhosts());
 
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 pj = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
             Scalar3 dx = pi - pj;
 
             // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            unsigned int typej = __scalar_as_int(pos[j].w);
             assert(typej < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
             Scalar dj = Scalar(0.0);
             Scalar qj = Scalar(0.0);
             if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
+                dj = diameter[j];
             if (evaluator::needsCharge())
-                qj = h_charge.data[j];
+                qj = charge[j];
 
             // apply periodic boundary conditions
             dx = box.minImage(dx);
@@ -452,11 +864,11 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
             // get parameters for this type pair
             unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+            param_type param = params[typpair_idx];
+            Scalar rcutsq = rcutsq_data[typpair_idx];
             Scalar ronsq = Scalar(0.0);
             if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+                ronsq = ronsq_data[typpair_idx];
 
             // design specifies that energies are shifted if
             // 1) shift mode is set to shift
@@ -528,42 +940,245 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                 // only add force to local particles
                 if (third_law && j < m_pdata->getN())
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    unsigned int mem_idx = j - offset;
+                    force[mem_idx].x -= dx.x*force_divr;
+                    force[mem_idx].y -= dx.y*force_divr;
+                    force[mem_idx].z -= dx.z*force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virial[0*virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                        virial[1*virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                        virial[2*virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                        virial[3*virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                        virial[4*virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                        virial[5*virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
                         }
                     }
                 }
             }
 
         // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        unsigned int mem_idx = i - offset;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            virial[0*virial_pitch+mem_idx] += virialxxi;
+            virial[1*virial_pitch+mem_idx] += virialxyi;
+            virial[2*virial_pitch+mem_idx] += virialxzi;
+            virial[3*virial_pitch+mem_idx] += virialyyi;
+            virial[4*virial_pitch+mem_idx] += virialyzi;
+            virial[5*virial_pitch+mem_idx] += virialzzi;
             }
         }
 
-    if (m_prof) m_prof->pop();
+    }
+
+/*! \param nlist Cluster pair neighbor list
+    \param first Index of the first local cluster to compute forces on
+    \param last One past the index of the last local cluster to compute forces on
+    \param pos Particle positions and types
+    \param diameter Particle diameters
+    \param charge Particle charges
+    \param ronsq_data r_on squared per type pair
+    \param rcutsq_data r_cut squared per type pair
+    \param params Pair parameters per type pair
+    \param box The global simulation box
+    \param force Force array to add the computed forces and energies to
+    \param virial Virial array to add the computed virials to
+    \param virial_pitch Pitch of \a virial
+    \param offset Index of the particle stored in the first element of \a force and \a virial
+    \param third_law True if the neighbor list is stored in half mode
+    \param compute_virial True if the virial is requested
+
+    Computes the same quantities as computeForcesRange() from a NeighborListCluster with M particles per cluster.
+    The M particles of the i cluster are loaded once, and the M particles of every neighboring j cluster are loaded
+    once per cluster pair and reused for all M x M pairs selected by the interaction mask. Forces on the particles of
+    the i cluster (and, with \a third_law, on the local particles of the j cluster) are accumulated per lane and added
+    to \a force once per cluster (pair).
+*/
+template< class evaluator >
+template< unsigned int M >
+void PotentialPair< evaluator >::computeForcesCluster(const NeighborListCluster& nlist,
+                                                      unsigned int first,
+                                                      unsigned int last,
+                                                      const Scalar4 *pos,
+                                                      const Scalar *diameter,
+                                                      const Scalar *charge,
+                                                      const Scalar *ronsq_data,
+                                                      const Scalar *rcutsq_data,
+                                                      const param_type *params,
+                                                      const BoxDim& box,
+                                                      Scalar4 *force,
+                                                      Scalar *virial,
+                                                      unsigned int virial_pitch,
+                                                      unsigned int offset,
+                                                      bool third_law,
+                                                      bool compute_virial)
+    {
+    assert(nlist.getClusterSize() == M);
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int nmax = nlist.getClusterNmax();
+    const unsigned int *cluster_idx = nlist.getClusterParticles().data();
+    const unsigned int *cluster_n_neigh = nlist.getClusterNNeigh().data();
+    const unsigned int *cluster_nlist = nlist.getClusterNList().data();
+    const uint64_t *cluster_mask = nlist.getClusterMasks().data();
+    const bool xplor_mode = (m_shift_mode == xplor);
+
+    // particle data of the i and j cluster, per lane
+    Scalar3 pos_i[M], pos_j[M];
+    unsigned int type_i[M], type_j[M];
+    Scalar d_i[M], d_j[M], q_i[M], q_j[M];
+
+    // accumulated forces, energies and virials per lane
+    Scalar4 f_i[M], f_j[M];
+    Scalar virial_i[6][M], virial_j[6][M];
+
+    for (unsigned int c_i = first; c_i < last; c_i++)
+        {
+        // unused lanes (0xffffffff) never have a bit set in the masks, load the first particle in their place
+        const unsigned int *idx_i = cluster_idx + c_i*M;
+        for (unsigned int a = 0; a < M; a++)
+            {
+            unsigned int i = (idx_i[a] < N) ? idx_i[a] : idx_i[0];
+            pos_i[a] = make_scalar3(pos[i].x, pos[i].y, pos[i].z);
+            type_i[a] = __scalar_as_int(pos[i].w);
+            d_i[a] = evaluator::needsDiameter() ? diameter[i] : Scalar(0.0);
+            q_i[a] = evaluator::needsCharge() ? charge[i] : Scalar(0.0);
+
+            f_i[a] = make_scalar4(0, 0, 0, 0);
+            for (unsigned int v = 0; v < 6; v++)
+                virial_i[v][a] = Scalar(0.0);
+            }
+
+        const unsigned int n_neigh = cluster_n_neigh[c_i];
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            const unsigned int c_j = cluster_nlist[c_i*nmax + k];
+            const uint64_t mask = cluster_mask[c_i*nmax + k];
+
+            const unsigned int *idx_j = cluster_idx + c_j*M;
+            for (unsigned int b = 0; b < M; b++)
+                {
+                unsigned int j = (idx_j[b] != 0xffffffff) ? idx_j[b] : idx_j[0];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+                pos_j[b] = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
+                type_j[b] = __scalar_as_int(pos[j].w);
+                d_j[b] = evaluator::needsDiameter() ? diameter[j] : Scalar(0.0);
+                q_j[b] = evaluator::needsCharge() ? charge[j] : Scalar(0.0);
+
+                f_j[b] = make_scalar4(0, 0, 0, 0);
+                for (unsigned int v = 0; v < 6; v++)
+                    virial_j[v][b] = Scalar(0.0);
+                }
+
+            for (unsigned int a = 0; a < M; a++)
+                {
+                for (unsigned int b = 0; b < M; b++)
+                    {
+                    if (!((mask >> (a*M + b)) & 1))
+                        continue;
+
+                    Scalar3 dx = box.minImage(pos_i[a] - pos_j[b]);
+                    Scalar rsq = dot(dx, dx);
+
+                    unsigned int typpair_idx = m_typpair_idx(type_i[a], type_j[b]);
+                    Scalar rcutsq = rcutsq_data[typpair_idx];
+                    Scalar ronsq = xplor_mode ? ronsq_data[typpair_idx] : Scalar(0.0);
+
+                    // energies are shifted in shift mode, or in xplor mode when ron > rcut
+                    bool energy_shift = (m_shift_mode == shift) || (xplor_mode && ronsq > rcutsq);
+
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar pair_eng = Scalar(0.0);
+                    evaluator eval(rsq, rcutsq, params[typpair_idx]);
+                    if (evaluator::needsDiameter())
+                        eval.setDiameter(d_i[a], d_j[b]);
+                    if (evaluator::needsCharge())
+                        eval.setCharge(q_i[a], q_j[b]);
+
+                    if (!eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+                        continue;
+
+                    if (xplor_mode && rsq >= ronsq && rsq < rcutsq)
+                        {
+                        // XPLOR smoothing, see computeForcesRange()
+                        Scalar xplor_denom_inv =
+                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+                        Scalar old_pair_eng = pair_eng;
+                        pair_eng = old_pair_eng * s;
+                        force_divr = s * force_divr - ds_dr_divr * old_pair_eng;
+                        }
+
+                    Scalar force_div2r = force_divr * Scalar(0.5);
+                    Scalar virial_pair[6] = {force_div2r*dx.x*dx.x, force_div2r*dx.x*dx.y, force_div2r*dx.x*dx.z,
+                                             force_div2r*dx.y*dx.y, force_div2r*dx.y*dx.z, force_div2r*dx.z*dx.z};
+
+                    f_i[a].x += dx.x*force_divr;
+                    f_i[a].y += dx.y*force_divr;
+                    f_i[a].z += dx.z*force_divr;
+                    f_i[a].w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        for (unsigned int v = 0; v < 6; v++)
+                            virial_i[v][a] += virial_pair[v];
+
+                    if (third_law)
+                        {
+                        f_j[b].x -= dx.x*force_divr;
+                        f_j[b].y -= dx.y*force_divr;
+                        f_j[b].z -= dx.z*force_divr;
+                        f_j[b].w += pair_eng * Scalar(0.5);
+                        if (compute_virial)
+                            for (unsigned int v = 0; v < 6; v++)
+                                virial_j[v][b] += virial_pair[v];
+                        }
+                    }
+                }
+
+            // add the reaction forces to the local particles of the j cluster
+            if (third_law)
+                {
+                for (unsigned int b = 0; b < M; b++)
+                    {
+                    if (idx_j[b] >= N)
+                        continue;
+
+                    unsigned int j = idx_j[b] - offset;
+                    force[j].x += f_j[b].x;
+                    force[j].y += f_j[b].y;
+                    force[j].z += f_j[b].z;
+                    force[j].w += f_j[b].w;
+                    if (compute_virial)
+                        for (unsigned int v = 0; v < 6; v++)
+                            virial[v*virial_pitch+j] += virial_j[v][b];
+                    }
+                }
+            }
+
+        // finally, increment the force, potential energy and virial of the particles in the i cluster
+        for (unsigned int a = 0; a < M; a++)
+            {
+            if (idx_i[a] >= N)
+                continue;
+
+            unsigned int i = idx_i[a] - offset;
+            force[i].x += f_i[a].x;
+            force[i].y += f_i[a].y;
+            force[i].z += f_i[a].z;
+            force[i].w += f_i[a].w;
+            if (compute_virial)
+                for (unsigned int v = 0; v < 6; v++)
+                    virial[v*virial_pitch+i] += virial_i[v][a];
+            }
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -63,6 +63,12 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! The DPD thermostat needs the ghost positions and velocities for all particles
+        virtual bool canOverlapGhostUpdate()
+            {
+            return false;
+            }
         #endif
 
     protected:
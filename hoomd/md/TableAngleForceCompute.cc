@@ -37,6 +37,8 @@ TableAngleForceCompute::TableAngleForceCompute(std::shared_ptr<SystemDefinition>
 
     // access the angle data for later use
     m_angle_data = m_sysdef->getAngleData();
+    m_coloring = std::shared_ptr< BondedGroupColoring<AngleData> >(
+        new BondedGroupColoring<AngleData>(m_pdata, m_angle_data));
 
     // check for some silly errors a user could make
     if (m_angle_data->getNTypes() == 0)
@@ -167,12 +169,14 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    ArrayHandle<AngleData::members_t> h_groups(m_angle_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // for each of the angles, angles that share a particle are never processed concurrently
+    m_coloring->forEach(m_exec_conf->getNumThreads(), [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
+        const AngleData::members_t& angle = h_groups.data[i];
         assert(angle.tag[0] <= m_pdata->getMaximumTag());
         assert(angle.tag[1] <= m_pdata->getMaximumTag());
         assert(angle.tag[2] <= m_pdata->getMaximumTag());
@@ -246,7 +250,7 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
         // compute index into the table and read in values
 
         /// Here we use the table!!
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
+        unsigned int angle_type = h_typeval.data[i].type;
         unsigned int value_i = floor(value_f);
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
@@ -322,7 +326,7 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
             for (int j = 0; j < 6; j++)
                 h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
             }
-        }
+        });
 
     if (m_prof) m_prof->pop();
     }
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedGroupColoring.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/GPUArray.h"
 
@@ -90,6 +91,7 @@ class PYBIND11_EXPORT TableAngleForceCompute : public ForceCompute
 
     protected:
         std::shared_ptr<AngleData> m_angle_data;  //!< Angle data to use in computing angles
+        std::shared_ptr< BondedGroupColoring<AngleData> > m_coloring; //!< Distributes the angles over threads
         unsigned int m_table_width;                 //!< Width of the tables in memory
         GPUArray<Scalar2> m_tables;                  //!< Stored V and T tables
         Index2D m_table_value;                      //!< Index table helper
@@ -31,6 +31,7 @@
 #include "IntegratorTwoStep.h"
 #include "MolecularForceCompute.h"
 #include "NeighborListBinned.h"
+#include "NeighborListCluster.h"
 #include "NeighborList.h"
 #include "NeighborListStencil.h"
 #include "NeighborListTree.h"
@@ -282,6 +283,7 @@ PYBIND11_MODULE(_md, m)
     export_PotentialSpecialPair<PotentialSpecialPairCoulomb>(m, "PotentialSpecialPairCoulomb");
     export_NeighborList(m);
     export_NeighborListBinned(m);
+    export_NeighborListCluster(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
     export_ConstraintSphere(m);
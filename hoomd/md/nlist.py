@@ -899,3 +899,73 @@ class tree(nlist):
         self.set_params(r_buff, check_period, d_max, dist_check)
         hoomd.util.unquiet_status()
 tree.cur_id = 0
+
+class cluster(nlist):
+    R""" Cluster pair neighbor list for the CPU.
+
+    Args:
+        r_buff (float):  Buffer width.
+        check_period (int): How often to attempt to rebuild the neighbor list.
+        d_max (float): The maximum diameter a particle will achieve, only used in conjunction with slj diameter shifting.
+        dist_check (bool): Flag to enable / disable distance checking.
+        name (str): Optional name for this neighbor list instance.
+        cluster_size (int): Number of particles per cluster (4 or 8).
+
+    :py:class:`cluster` groups the particles in every cell of a cell list into small spatially compact clusters of
+    *cluster_size* particles and stores pairs of clusters whose bounding boxes are within the neighbor list cutoff,
+    together with a bit mask of the particle pairs that interact. Pair potentials load the particle data of both
+    clusters once per cluster pair and evaluate the particle pairs selected by the mask one at a time. This reduces the
+    neighbor list size and memory traffic, and can be faster than :py:class:`cell` for dense, nearly monodisperse
+    systems on the CPU. Other consumers of the neighbor list see a regular per particle neighbor list.
+
+    Use base class methods to change parameters (:py:meth:`set_params <nlist.set_params>`), reset the exclusion list
+    (:py:meth:`reset_exclusions <nlist.reset_exclusions>`) or tune *r_buff* (:py:meth:`tune <nlist.tune>`).
+
+    Examples::
+
+        nl_c = nlist.cluster(check_period = 1)
+        nl_c.set_params(r_buff=0.5)
+        nl_c = nlist.cluster(cluster_size=8)
+
+    Note:
+        *d_max* should only be set when slj diameter shifting is required by a pair potential. Currently, slj
+        is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
+        significantly degraded performance or incorrect results.
+
+    .. attention::
+        :py:class:`cluster` is only available on the CPU. Use :py:class:`cell` on the GPU.
+
+    """
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, cluster_size=4):
+        hoomd.util.print_status_line()
+
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("nlist.cluster is not supported on the GPU, use nlist.cell\n")
+            raise RuntimeError("Error creating neighbor list")
+
+        nlist.__init__(self)
+
+        if name is None:
+            self.name = "cluster_nlist_%d" % cluster.cur_id
+            cluster.cur_id += 1
+        else:
+            self.name = name
+
+        # create the C++ mirror class
+        self.cpp_cl = _hoomd.CellList(hoomd.context.current.system_definition)
+        hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
+        self.cpp_nlist = _md.NeighborListCluster(hoomd.context.current.system_definition, 0.0, r_buff, self.cpp_cl, int(cluster_size))
+
+        self.cpp_nlist.setEvery(check_period, dist_check)
+
+        hoomd.context.current.system.addCompute(self.cpp_nlist, self.name)
+
+        # register this neighbor list with the context
+        hoomd.context.current.neighbor_lists += [self]
+
+        # save the user defined parameters
+        hoomd.util.quiet_status()
+        self.set_params(r_buff, check_period, d_max, dist_check)
+        hoomd.util.unquiet_status()
+
+cluster.cur_id = 0
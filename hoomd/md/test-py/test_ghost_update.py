@@ -0,0 +1,120 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md;
+from hoomd.md import _md
+context.initialize()
+import unittest
+import numpy
+
+# Tests that the split ghost update (comm.set_ghost_update_overlap) gives the same forces as the default update
+@unittest.skipIf(context.exec_conf.isCUDAEnabled(), "the split ghost update only applies to CPU simulations")
+class ghost_update_overlap_tests (unittest.TestCase):
+    def setUp(self):
+        print
+
+    ## \internal
+    # \brief Run a perturbed LJ lattice and return the forces, energies and virials of all particles
+    def run_lj(self, overlap, storage):
+        context.initialize()
+        system = init.create_lattice(lattice.sc(a=1.2),n=8);
+
+        # displace the particles so that the forces do not cancel
+        snap = system.take_snapshot()
+        if comm.get_rank() == 0:
+            rng = numpy.random.RandomState(42)
+            snap.particles.position[:] += rng.uniform(-0.05, 0.05, size=(snap.particles.N, 3))
+        system.restore_snapshot(snap)
+
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist = nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        nl.cpp_nlist.setStorageMode(storage)
+
+        md.integrate.mode_standard(dt=0.001);
+        md.integrate.nve(group=group.all());
+        comm.set_ghost_update_overlap(overlap)
+
+        # the overlap is used on the steps without a neighbor list rebuild
+        run(20)
+
+        N = len(system.particles)
+        force = numpy.array([lj.forces[i].force for i in range(N)])
+        energy = numpy.array([lj.forces[i].energy for i in range(N)])
+        virial = numpy.array([lj.forces[i].virial for i in range(N)])
+        return force, energy, virial
+
+    def compare(self, storage):
+        ref = self.run_lj(False, storage)
+        res = self.run_lj(True, storage)
+
+        # forces are summed in a different order with the overlap
+        for a,b in zip(ref, res):
+            numpy.testing.assert_allclose(a, b, rtol=1e-4, atol=1e-4)
+
+    # test the overlap with a half neighbor list
+    def test_half_nlist(self):
+        self.compare(_md.NeighborList.storageMode.half)
+
+    # test the overlap with a full neighbor list
+    def test_full_nlist(self):
+        self.compare(_md.NeighborList.storageMode.full)
+
+    def tearDown(self):
+        context.initialize();
+
+# Tests that persistent requests (comm.set_persistent_ghost_update) deliver the same ghost positions across sorter steps
+@unittest.skipIf(context.exec_conf.isCUDAEnabled(), "persistent ghost update requests only apply to CPU simulations")
+class ghost_update_persistent_tests (unittest.TestCase):
+    def setUp(self):
+        print
+
+    ## \internal
+    # \brief Run a perturbed LJ lattice with frequent particle sorts and return the positions and forces
+    def run_lj(self, persistent):
+        context.initialize()
+        system = init.create_lattice(lattice.sc(a=1.2),n=8);
+
+        snap = system.take_snapshot()
+        if comm.get_rank() == 0:
+            rng = numpy.random.RandomState(42)
+            snap.particles.position[:] += rng.uniform(-0.05, 0.05, size=(snap.particles.N, 3))
+        system.restore_snapshot(snap)
+
+        # sort between neighbor list builds, so that the requests have to follow the reordered arrays
+        context.current.sorter.set_period(5)
+
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist = nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+
+        md.integrate.mode_standard(dt=0.001);
+        md.integrate.nve(group=group.all());
+        comm.set_persistent_ghost_update(persistent)
+
+        run(22)
+
+        # the forces on particles near the domain boundaries depend on the received ghost positions
+        N = len(system.particles)
+        force = numpy.array([lj.forces[i].force for i in range(N)])
+        energy = numpy.array([lj.forces[i].energy for i in range(N)])
+        snap = system.take_snapshot()
+        if comm.get_rank() == 0:
+            pos = numpy.array(snap.particles.position)
+        else:
+            pos = numpy.zeros((N, 3))
+        return pos, force, energy
+
+    # the ghost update only changes how messages are posted, the results are identical
+    def test_sort(self):
+        ref = self.run_lj(False)
+        res = self.run_lj(True)
+
+        for a,b in zip(ref, res):
+            numpy.testing.assert_array_equal(a, b)
+
+    def tearDown(self):
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -24,6 +24,7 @@ using namespace std;
 using namespace std::placeholders;
 
 #include "hoomd/test/upp11_config.h"
+#include "utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -388,6 +389,32 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare the threaded CPU angle force computation against the serial one
+void angle_force_threads_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap =  rand_init.getSnapshot();
+    snap->angle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<HarmonicAngleForceCompute> fc(new HarmonicAngleForceCompute(sysdef));
+    fc->setParams(0, Scalar(1.0), Scalar(1.348));
+
+    // a chain of angles, and more angles around particle 0 than fit into the parallel colors
+    for (unsigned int i = 0; i < N-2; i++)
+        sysdef->getAngleData()->addBondedGroup(Angle(0, i, i+1, i+2));
+    for (unsigned int i = 2; i < 200; i += 2)
+        sysdef->getAngleData()->addBondedGroup(Angle(0, i, 0, i+1));
+
+    compare_threaded_bonded_force(exec_conf, fc, sysdef->getAngleData(), N, 500);
+    }
+#endif
+
 //! HarmonicAngleForceCompute creator for angle_force_basic_tests()
 std::shared_ptr<HarmonicAngleForceCompute> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -412,6 +439,14 @@ UP_TEST( HarmonicAngleForceCompute_basic )
     angle_force_basic_tests(af_creator, exec_conf);
     }
 
+#ifdef ENABLE_TBB
+//! test case for angle forces on several CPU threads
+UP_TEST( HarmonicAngleForceCompute_threads )
+    {
+    angle_force_threads_tests(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for angle forces on the GPU
 UP_TEST( HarmonicAngleForceComputeGPU_basic )
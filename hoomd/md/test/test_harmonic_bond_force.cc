@@ -25,6 +25,7 @@ using namespace std::placeholders;
 */
 
 #include "hoomd/test/upp11_config.h"
+#include "utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -443,6 +444,32 @@ void const_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare the threaded CPU bond force computation against the serial one
+void bond_force_threads_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap =  rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<PotentialBondHarmonic> fc(new PotentialBondHarmonic(sysdef));
+    fc->setParams(0, make_scalar2(Scalar(1.0), Scalar(1.0)));
+
+    // a chain of bonds, and more bonds around particle 0 than fit into the parallel colors
+    for (unsigned int i = 0; i < N-1; i++)
+        sysdef->getBondData()->addBondedGroup(Bond(0, i, i+1));
+    for (unsigned int i = 2; i < 200; i++)
+        sysdef->getBondData()->addBondedGroup(Bond(0, 0, i));
+
+    compare_threaded_bonded_force(exec_conf, fc, sysdef->getBondData(), N, 500);
+    }
+#endif
+
 //! PotentialBondHarmonic creator for bond_force_basic_tests()
 std::shared_ptr<PotentialBondHarmonic> base_class_bf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -464,6 +491,14 @@ UP_TEST( PotentialBondHarmonic_basic )
     bond_force_basic_tests(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for bond forces on several CPU threads
+UP_TEST( PotentialBondHarmonic_threads )
+    {
+    bond_force_threads_tests(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for bond forces on the GPU
 UP_TEST( PotentialBondHarmonicGPU_basic )
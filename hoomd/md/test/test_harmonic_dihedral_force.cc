@@ -24,6 +24,7 @@ using namespace std;
 using namespace std::placeholders;
 
 #include "hoomd/test/upp11_config.h"
+#include "utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -440,6 +441,32 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare the threaded CPU dihedral force computation against the serial one
+void dihedral_force_threads_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap =  rand_init.getSnapshot();
+    snap->dihedral_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<HarmonicDihedralForceCompute> fc(new HarmonicDihedralForceCompute(sysdef));
+    fc->setParams(0, Scalar(3.0), -1, 3);
+
+    // a chain of dihedrals, and more dihedrals around particle 0 than fit into the parallel colors
+    for (unsigned int i = 0; i < N-3; i++)
+        sysdef->getDihedralData()->addBondedGroup(Dihedral(0, i, i+1, i+2, i+3));
+    for (unsigned int i = 4; i < 300; i += 3)
+        sysdef->getDihedralData()->addBondedGroup(Dihedral(0, i, 0, i+1, i+2));
+
+    compare_threaded_bonded_force(exec_conf, fc, sysdef->getDihedralData(), N, 500);
+    }
+#endif
+
 //! HarmonicDihedralForceCompute creator for dihedral_force_basic_tests()
 std::shared_ptr<HarmonicDihedralForceCompute> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -462,6 +489,14 @@ UP_TEST( HarmonicDihedralForceCompute_basic )
     dihedral_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for dihedral forces on several CPU threads
+UP_TEST( HarmonicDihedralForceCompute_threads )
+    {
+    dihedral_force_threads_tests(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for dihedral forces on the GPU
 UP_TEST( HarmonicDihedralForceComputeGPU_basic )
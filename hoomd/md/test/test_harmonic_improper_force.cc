@@ -24,6 +24,7 @@ using namespace std;
 using namespace std::placeholders;
 
 #include "hoomd/test/upp11_config.h"
+#include "utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -478,6 +479,32 @@ void improper_force_comparison_tests(improperforce_creator tf_creator1,
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare the threaded CPU improper force computation against the serial one
+void improper_force_threads_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap =  rand_init.getSnapshot();
+    snap->improper_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<HarmonicImproperForceCompute> fc(new HarmonicImproperForceCompute(sysdef));
+    fc->setParams(0, Scalar(2.0), Scalar(1.5));
+
+    // a chain of impropers, and more impropers around particle 0 than fit into the parallel colors
+    for (unsigned int i = 0; i < N-3; i++)
+        sysdef->getImproperData()->addBondedGroup(Dihedral(0, i, i+1, i+2, i+3));
+    for (unsigned int i = 4; i < 300; i += 3)
+        sysdef->getImproperData()->addBondedGroup(Dihedral(0, i, 0, i+1, i+2));
+
+    compare_threaded_bonded_force(exec_conf, fc, sysdef->getImproperData(), N, 500);
+    }
+#endif
+
 //! HarmonicImproperForceCompute creator for improper_force_basic_tests()
 std::shared_ptr<HarmonicImproperForceCompute> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -500,6 +527,14 @@ UP_TEST( HarmonicImproperForceCompute_basic )
     improper_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for improper forces on several CPU threads
+UP_TEST( HarmonicImproperForceCompute_threads )
+    {
+    improper_force_threads_tests(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for improper forces on the GPU
 UP_TEST( HarmonicImproperForceComputeGPU_basic )
@@ -14,7 +14,9 @@
 #include "hoomd/md/AllPairPotentials.h"
 
 #include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/NeighborListCluster.h"
 #include "hoomd/Initializers.h"
+#include "hoomd/SnapshotSystemData.h"
 
 #include <math.h>
 
@@ -365,6 +367,151 @@ void lj_force_comparison_test(ljforce_creator lj_creator1, ljforce_creator lj_cr
     }
     }
 
+//! Compare forces computed from a cluster pair neighbor list against a regular neighbor list
+void lj_force_cluster_test(NeighborList::storageMode mode, unsigned int cluster_size, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 5000;
+
+    // create a random particle system with two types to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->particle_data.type_mapping.push_back("B");
+    for (unsigned int i = 0; i < N; i += 3)
+        snap->particle_data.type[i] = 1;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist_tree(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    nlist_tree->setStorageMode(mode);
+    std::shared_ptr<NeighborListCluster> nlist_cluster(new NeighborListCluster(sysdef, Scalar(3.0), Scalar(0.8),
+        std::shared_ptr<CellList>(), cluster_size));
+    nlist_cluster->setStorageMode(mode);
+
+    // exclude some of the pairs
+    for (unsigned int i = 0; i < N-1; i += 2)
+        {
+        nlist_tree->addExclusion(i,i+1);
+        nlist_cluster->addExclusion(i,i+1);
+        }
+
+    std::shared_ptr<PotentialPairLJ> fc_tree(new PotentialPairLJ(sysdef, nlist_tree));
+    std::shared_ptr<PotentialPairLJ> fc_cluster(new PotentialPairLJ(sysdef, nlist_cluster));
+
+    std::shared_ptr<PotentialPairLJ> fc[2] = {fc_tree, fc_cluster};
+    for (unsigned int n = 0; n < 2; n++)
+        {
+        fc[n]->setShiftMode(PotentialPairLJ::xplor);
+        fc[n]->setParams(0,0,make_scalar2(Scalar(4.0),Scalar(4.0)));
+        fc[n]->setParams(0,1,make_scalar2(Scalar(4.0)*pow(Scalar(1.2),Scalar(12.0)),Scalar(4.0)*pow(Scalar(1.2),Scalar(6.0))));
+        fc[n]->setParams(1,1,make_scalar2(Scalar(2.0),Scalar(0.0)));
+        fc[n]->setRcut(0, 0, Scalar(3.0));
+        fc[n]->setRcut(0, 1, Scalar(2.5));
+        fc[n]->setRcut(1, 1, Scalar(1.5));
+        fc[n]->setRon(0, 0, Scalar(2.0));
+        fc[n]->setRon(0, 1, Scalar(2.0));
+        fc[n]->setRon(1, 1, Scalar(2.0));
+        fc[n]->compute(0);
+        }
+
+    ArrayHandle<Scalar4> h_force_tree(fc_tree->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_tree(fc_tree->getVirialArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_cluster(fc_cluster->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_cluster(fc_cluster->getVirialArray(), access_location::host, access_mode::read);
+    unsigned int pitch = fc_tree->getVirialArray().getPitch();
+
+    double deltaf2 = 0.0;
+    double deltav2 = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        deltaf2 += double(h_force_cluster.data[i].x - h_force_tree.data[i].x) * double(h_force_cluster.data[i].x - h_force_tree.data[i].x);
+        deltaf2 += double(h_force_cluster.data[i].y - h_force_tree.data[i].y) * double(h_force_cluster.data[i].y - h_force_tree.data[i].y);
+        deltaf2 += double(h_force_cluster.data[i].z - h_force_tree.data[i].z) * double(h_force_cluster.data[i].z - h_force_tree.data[i].z);
+        deltaf2 += double(h_force_cluster.data[i].w - h_force_tree.data[i].w) * double(h_force_cluster.data[i].w - h_force_tree.data[i].w);
+        for (unsigned int j = 0; j < 6; j++)
+            deltav2 += double(h_virial_cluster.data[j*pitch+i] - h_virial_tree.data[j*pitch+i])
+                       * double(h_virial_cluster.data[j*pitch+i] - h_virial_tree.data[j*pitch+i]);
+        }
+    CHECK_SMALL(deltaf2 / double(N), double(tol_small));
+    CHECK_SMALL(deltav2 / double(N), double(tol_small));
+    }
+
+#ifdef ENABLE_TBB
+//! Compare the threaded CPU pair force computation against the serial one
+void lj_force_threads_test(NeighborList::storageMode mode, unsigned int cluster_size, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 5000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // a cluster size of 0 selects a per particle neighbor list
+    std::shared_ptr<NeighborList> nlist;
+    if (cluster_size)
+        nlist = std::shared_ptr<NeighborList>(new NeighborListCluster(sysdef, Scalar(3.0), Scalar(0.8),
+            std::shared_ptr<CellList>(), cluster_size));
+    else
+        nlist = std::shared_ptr<NeighborList>(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    nlist->setStorageMode(mode);
+
+    std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setRcut(0, 0, Scalar(3.0));
+    Scalar lj1 = Scalar(4.0) * pow(Scalar(1.2),Scalar(12.0));
+    Scalar lj2 = Scalar(0.45) * Scalar(4.0) * pow(Scalar(1.2),Scalar(6.0));
+    fc->setParams(0,0,make_scalar2(lj1,lj2));
+
+    // compute the forces with a single thread, and twice with several threads
+    std::vector<Scalar4> force[3];
+    std::vector<Scalar> virial[3];
+    unsigned int num_threads[3] = {1, 4, 4};
+    for (unsigned int run = 0; run < 3; run++)
+        {
+        exec_conf->setNumThreads(num_threads[run]);
+        fc->compute(run);
+
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            force[run].push_back(h_force.data[i]);
+            for (unsigned int j = 0; j < 6; j++)
+                virial[run].push_back(h_virial.data[j*pitch+i]);
+            }
+        }
+
+    double deltaf2 = 0.0;
+    double deltav2 = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        // repeated runs with the same number of threads give identical results
+        MY_ASSERT_EQUAL(force[1][i].x, force[2][i].x);
+        MY_ASSERT_EQUAL(force[1][i].y, force[2][i].y);
+        MY_ASSERT_EQUAL(force[1][i].z, force[2][i].z);
+        MY_ASSERT_EQUAL(force[1][i].w, force[2][i].w);
+        for (unsigned int j = 0; j < 6; j++)
+            MY_ASSERT_EQUAL(virial[1][6*i+j], virial[2][6*i+j]);
+
+        // and agree with the serial result up to roundoff
+        deltaf2 += double(force[1][i].x - force[0][i].x) * double(force[1][i].x - force[0][i].x);
+        deltaf2 += double(force[1][i].y - force[0][i].y) * double(force[1][i].y - force[0][i].y);
+        deltaf2 += double(force[1][i].z - force[0][i].z) * double(force[1][i].z - force[0][i].z);
+        deltaf2 += double(force[1][i].w - force[0][i].w) * double(force[1][i].w - force[0][i].w);
+        for (unsigned int j = 0; j < 6; j++)
+            deltav2 += double(virial[1][6*i+j] - virial[0][6*i+j]) * double(virial[1][6*i+j] - virial[0][6*i+j]);
+        }
+    CHECK_SMALL(deltaf2 / double(N), double(tol_small));
+    CHECK_SMALL(deltav2 / double(N), double(tol_small));
+
+    // the neighbor list keeps the storage mode chosen by the user
+    UP_ASSERT(nlist->getStorageMode() == mode);
+    }
+#endif
+
 //! Test the ability of the lj force compute to compute forces with different shift modes
 void lj_force_shift_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -570,6 +717,44 @@ UP_TEST( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the cluster pair neighbor list with a half list
+UP_TEST( PotentialPairLJ_cluster_half )
+    {
+    lj_force_cluster_test(NeighborList::half, 4, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the cluster pair neighbor list with a full list
+UP_TEST( PotentialPairLJ_cluster_full )
+    {
+    lj_force_cluster_test(NeighborList::full, 4, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the cluster pair neighbor list with 8 particles per cluster
+UP_TEST( PotentialPairLJ_cluster8_half )
+    {
+    lj_force_cluster_test(NeighborList::half, 8, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! test case for the threaded CPU path with a half neighbor list
+UP_TEST( PotentialPairLJ_threads_half )
+    {
+    lj_force_threads_test(NeighborList::half, 0, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the threaded CPU path with a full neighbor list
+UP_TEST( PotentialPairLJ_threads_full )
+    {
+    lj_force_threads_test(NeighborList::full, 0, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the threaded CPU path with a half cluster pair neighbor list
+UP_TEST( PotentialPairLJ_threads_cluster_half )
+    {
+    lj_force_threads_test(NeighborList::half, 4, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
@@ -12,6 +12,7 @@
 
 #include "hoomd/md/NeighborList.h"
 #include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListCluster.h"
 #include "hoomd/md/NeighborListStencil.h"
 #include "hoomd/md/NeighborListTree.h"
 #include "hoomd/Initializers.h"
@@ -935,6 +936,56 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+#ifdef ENABLE_TBB
+//! Test that a NeighborList built on several threads matches the one built on a single thread
+template <class NL>
+void neighborlist_threads_test(NeighborList::storageMode mode, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NeighborList> nlist1(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    nlist1->setRCutPair(0,0,3.0);
+    nlist1->setStorageMode(mode);
+
+    std::shared_ptr<NeighborList> nlist2(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    nlist2->setRCutPair(0,0,3.0);
+    nlist2->setStorageMode(mode);
+
+    for (unsigned int i=0; i < pdata->getN()-2; i++)
+        {
+        nlist1->addExclusion(i,i+1);
+        nlist2->addExclusion(i,i+1);
+        }
+
+    // the first build overflows the initial row sizes, which exercises the per thread overflow bookkeeping
+    exec_conf->setNumThreads(1);
+    nlist1->compute(0);
+    exec_conf->setNumThreads(4);
+    nlist2->compute(0);
+
+    ArrayHandle<unsigned int> h_n_neigh1(nlist1->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist1(nlist1->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list1(nlist1->getHeadList(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh2(nlist2->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist2(nlist2->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list2(nlist2->getHeadList(), access_location::host, access_mode::read);
+
+    // every row is built by one thread, so the rows are identical and in the same order
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        UP_ASSERT_EQUAL(h_head_list1.data[i], h_head_list2.data[i]);
+        UP_ASSERT_EQUAL(h_n_neigh1.data[i], h_n_neigh2.data[i]);
+
+        for (unsigned int j = 0; j < h_n_neigh1.data[i]; j++)
+            UP_ASSERT_EQUAL(h_nlist1.data[h_head_list1.data[i] + j], h_nlist2.data[h_head_list2.data[i] + j]);
+        }
+    }
+#endif
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template <class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1075,6 +1126,77 @@ void neighborlist_cutoff_exclude_tests(std::shared_ptr<ExecutionConfiguration> e
         }
     }
 
+//! Test the cluster pair neighbor list against the binned list for both storage modes and cluster sizes
+void neighborlist_cluster_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    unsigned int cluster_sizes[] = {4, 8};
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        for (unsigned int s = 0; s < 2; s++)
+            {
+            std::shared_ptr<NeighborListBinned> nlist1(new NeighborListBinned(sysdef, Scalar(2.5), Scalar(0.4)));
+            nlist1->setRCutPair(0,0,2.5);
+            nlist1->setStorageMode(modes[m]);
+
+            std::shared_ptr<NeighborListCluster> nlist2(new NeighborListCluster(sysdef, Scalar(2.5), Scalar(0.4),
+                std::shared_ptr<CellList>(), cluster_sizes[s]));
+            nlist2->setRCutPair(0,0,2.5);
+            nlist2->setStorageMode(modes[m]);
+
+            for (unsigned int i=0; i < pdata->getN()-1; i++)
+                {
+                nlist1->addExclusion(i,i+1);
+                nlist2->addExclusion(i,i+1);
+                }
+
+            nlist1->compute(0);
+            nlist2->compute(0);
+
+            // every local particle is in exactly one local cluster
+            const std::vector<unsigned int>& cluster_idx = nlist2->getClusterParticles();
+            std::vector<unsigned int> n_found(pdata->getN(), 0);
+            for (unsigned int k = 0; k < nlist2->getNumLocalClusters()*cluster_sizes[s]; k++)
+                {
+                if (cluster_idx[k] != 0xffffffff)
+                    n_found[cluster_idx[k]]++;
+                }
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                CHECK_EQUAL_UINT(n_found[i], 1);
+
+            // the expanded per particle list matches the binned list
+            ArrayHandle<unsigned int> h_n_neigh1(nlist1->getNNeighArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_nlist1(nlist1->getNListArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_head_list1(nlist1->getHeadList(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_n_neigh2(nlist2->getNNeighArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_nlist2(nlist2->getNListArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_head_list2(nlist2->getHeadList(), access_location::host, access_mode::read);
+
+            std::vector<unsigned int> tmp_list1;
+            std::vector<unsigned int> tmp_list2;
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                {
+                UP_ASSERT_EQUAL(h_n_neigh1.data[i], h_n_neigh2.data[i]);
+
+                tmp_list1.assign(h_nlist1.data + h_head_list1.data[i],
+                                 h_nlist1.data + h_head_list1.data[i] + h_n_neigh1.data[i]);
+                tmp_list2.assign(h_nlist2.data + h_head_list2.data[i],
+                                 h_nlist2.data + h_head_list2.data[i] + h_n_neigh2.data[i]);
+                sort(tmp_list1.begin(), tmp_list1.end());
+                sort(tmp_list2.begin(), tmp_list2.end());
+
+                UP_ASSERT_EQUAL(tmp_list1,tmp_list2);
+                }
+            }
+        }
+    }
+
 //! Tests for correctness of neighbor search in 2d systems
 template<class NL>
 void neighborlist_2d_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1244,6 +1366,14 @@ UP_TEST( NeighborListBinned_2d )
     {
     neighborlist_2d_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+//! test case for building the binned class on multiple threads
+UP_TEST( NeighborListBinned_threads )
+    {
+    neighborlist_threads_test<NeighborListBinned>(NeighborList::half, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    neighborlist_threads_test<NeighborListBinned>(NeighborList::full, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
 
 ////////////////////
 // STENCIL CPU
@@ -1299,6 +1429,14 @@ UP_TEST( NeighborListStencil_comparison )
     {
     neighborlist_comparison_test<NeighborListBinned, NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+//! test case for building the stencil class on multiple threads
+UP_TEST( NeighborListStencil_threads )
+    {
+    neighborlist_threads_test<NeighborListStencil>(NeighborList::half, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    neighborlist_threads_test<NeighborListStencil>(NeighborList::full, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
 
 ///////////////
 // TREE CPU
@@ -1353,6 +1491,68 @@ UP_TEST( NeighborListTree_comparison )
     {
     neighborlist_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+//! test case for building the tree class on multiple threads
+UP_TEST( NeighborListTree_threads )
+    {
+    neighborlist_threads_test<NeighborListTree>(NeighborList::half, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    neighborlist_threads_test<NeighborListTree>(NeighborList::full, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
+///////////////
+// CLUSTER CPU
+///////////////
+//! basic test case for cluster class
+UP_TEST( NeighborListCluster_basic )
+    {
+    neighborlist_basic_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! exclusion test case for cluster class
+UP_TEST( NeighborListCluster_exclusion )
+    {
+    neighborlist_exclusion_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! large exclusion test case for cluster class
+UP_TEST( NeighborListCluster_large_ex )
+    {
+    neighborlist_large_ex_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! body filter test case for cluster class
+UP_TEST( NeighborListCluster_body_filter )
+    {
+    neighborlist_body_filter_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! diameter filter test case for cluster class
+UP_TEST( NeighborListCluster_diameter_shift )
+    {
+    neighborlist_diameter_shift_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! particle asymmetry test case for cluster class
+UP_TEST( NeighborListCluster_particle_asymm )
+    {
+    neighborlist_particle_asymm_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! cutoff exclusion test case for cluster class
+UP_TEST( NeighborListCluster_cutoff_exclude )
+    {
+    neighborlist_cutoff_exclude_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! type test case for cluster class
+UP_TEST( NeighborListCluster_type )
+    {
+    neighborlist_type_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! 2d tests for cluster class
+UP_TEST( NeighborListCluster_2d )
+    {
+    neighborlist_2d_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! comparison test case for cluster class
+UP_TEST( NeighborListCluster_comparison )
+    {
+    neighborlist_cluster_tests(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 
 #ifdef ENABLE_CUDA
 ///////////////
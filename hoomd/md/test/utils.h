@@ -0,0 +1,88 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef MD_TEST_UTILS_H_
+#define MD_TEST_UTILS_H_
+
+/*! \file utils.h
+    \brief Helpers shared by the md unit tests
+    \note Include this file after hoomd/test/upp11_config.h, which defines the assertion macros.
+*/
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/GPUArray.h"
+
+#include <memory>
+#include <vector>
+
+#ifdef ENABLE_TBB
+//! Compare the threaded CPU evaluation of a bonded force against the serial one
+/*!
+    \param exec_conf Execution configuration whose number of threads is varied
+    \param fc Force compute to evaluate
+    \param groups Bonded group data \a fc acts on
+    \param N Number of particles in the system
+    \param remove_tag Tag of the group removed before the second pass
+
+    The forces and virials are computed with 1, 4 and 3 threads. The threaded results must be identical
+    to each other and agree with the serial result up to roundoff. The second pass checks that the
+    threads pick up the removed group.
+*/
+template<class ForceCompute, class GroupData>
+void compare_threaded_bonded_force(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<ForceCompute> fc,
+                                   std::shared_ptr<GroupData> groups,
+                                   unsigned int N,
+                                   unsigned int remove_tag)
+    {
+    for (unsigned int pass = 0; pass < 2; pass++)
+        {
+        if (pass == 1)
+            groups->removeBondedGroup(remove_tag);
+
+        std::vector<Scalar4> force[3];
+        std::vector<Scalar> virial[3];
+        unsigned int num_threads[3] = {1, 4, 3};
+        for (unsigned int run = 0; run < 3; run++)
+            {
+            exec_conf->setNumThreads(num_threads[run]);
+            fc->compute(3*pass + run);
+
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+            unsigned int pitch = fc->getVirialArray().getPitch();
+            for (unsigned int i = 0; i < N; i++)
+                {
+                force[run].push_back(h_force.data[i]);
+                for (unsigned int j = 0; j < 6; j++)
+                    virial[run].push_back(h_virial.data[j*pitch+i]);
+                }
+            }
+
+        double deltaf2 = 0.0;
+        double deltav2 = 0.0;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            // the result does not depend on the number of threads
+            MY_ASSERT_EQUAL(force[1][i].x, force[2][i].x);
+            MY_ASSERT_EQUAL(force[1][i].y, force[2][i].y);
+            MY_ASSERT_EQUAL(force[1][i].z, force[2][i].z);
+            MY_ASSERT_EQUAL(force[1][i].w, force[2][i].w);
+            for (unsigned int j = 0; j < 6; j++)
+                MY_ASSERT_EQUAL(virial[1][6*i+j], virial[2][6*i+j]);
+
+            // and agrees with the serial result up to roundoff
+            deltaf2 += double(force[1][i].x - force[0][i].x) * double(force[1][i].x - force[0][i].x);
+            deltaf2 += double(force[1][i].y - force[0][i].y) * double(force[1][i].y - force[0][i].y);
+            deltaf2 += double(force[1][i].z - force[0][i].z) * double(force[1][i].z - force[0][i].z);
+            deltaf2 += double(force[1][i].w - force[0][i].w) * double(force[1][i].w - force[0][i].w);
+            for (unsigned int j = 0; j < 6; j++)
+                deltav2 += double(virial[1][6*i+j] - virial[0][6*i+j]) * double(virial[1][6*i+j] - virial[0][6*i+j]);
+            }
+        CHECK_SMALL(deltaf2 / double(N), double(tol_small));
+        CHECK_SMALL(deltav2 / double(N), double(tol_small));
+        }
+    }
+#endif
+
+#endif // MD_TEST_UTILS_H_
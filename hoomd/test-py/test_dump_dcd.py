@@ -58,6 +58,20 @@ class dmp_dcd_tests (unittest.TestCase):
         if (comm.get_rank() == 0):
             os.remove(self.tmp_file)
 
+    # tests that the asynchronous option writes the same file as the synchronous writer
+    def test_asynchronous(self):
+        dump.dcd(filename=self.tmp_file, period=10, asynchronous=True);
+        dump.dcd(filename=self.tmp_file + '.sync', period=10);
+        run(100)
+        if (comm.get_rank() == 0):
+            with open(self.tmp_file, 'rb') as f:
+                data_async = f.read()
+            with open(self.tmp_file + '.sync', 'rb') as f:
+                data_sync = f.read()
+            self.assertEqual(data_async, data_sync);
+            os.remove(self.tmp_file)
+            os.remove(self.tmp_file + '.sync')
+
     # tests variable periods
     def test_variable(self):
         dump.dcd(filename=self.tmp_file, period=lambda n: n*100);
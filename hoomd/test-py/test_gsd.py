@@ -376,6 +376,97 @@ class gsd_read_tests (unittest.TestCase):
             numpy.testing.assert_array_equal(snap.pairs.group, self.snapshot.pairs.group);
 
 
+    # tests data.gsd_snapshot on a file written with streaming
+    def test_gsd_snapshot_stream(self):
+        g = dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, stream=True);
+        g.cpp_analyzer.setStreamBlockSize(3);
+        run(1);
+
+        snap = data.gsd_snapshot(self.tmp_file, frame=0);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+
+    # tests data.gsd_snapshot on a file written asynchronously
+    def test_gsd_snapshot_asynchronous(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, asynchronous=True);
+        run(5);
+
+        snap = data.gsd_snapshot(self.tmp_file, frame=4);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+
+    # tests that streaming cannot be combined with asynchronous writes
+    def test_stream_asynchronous(self):
+        self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=1, overwrite=True,
+                          stream=True, asynchronous=True);
+
+    # tests data.gsd_snapshot on a file written with quantized particle data
+    def test_gsd_snapshot_quantize(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, quantize=12, hoomd_only=True,
+                 dynamic=['momentum']);
+        run(2);
+
+        # frame 0 is stored at full precision
+        snap = data.gsd_snapshot(self.tmp_file, frame=0);
+        if comm.get_rank() == 0:
+            for name in ['position', 'orientation', 'velocity', 'angmom']:
+                numpy.testing.assert_array_equal(getattr(snap.particles, name), getattr(self.snapshot.particles, name));
+
+        snap = data.gsd_snapshot(self.tmp_file, frame=1);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            for name in ['position', 'velocity', 'angmom']:
+                ref = getattr(self.snapshot.particles, name);
+                tol = (ref.max(axis=0) - ref.min(axis=0)) / (2 * (2**12 - 1)) + 1e-6;
+                self.assertTrue(numpy.all(numpy.abs(getattr(snap.particles, name) - ref) <= tol));
+
+            # decoded orientations are normalized
+            ref = self.snapshot.particles.orientation;
+            norm = numpy.linalg.norm(ref, axis=1)[:, numpy.newaxis];
+            tol = 2 * numpy.max((ref.max(axis=0) - ref.min(axis=0)) / (2 * (2**12 - 1))) / numpy.min(norm) + 1e-6;
+            numpy.testing.assert_allclose(numpy.linalg.norm(snap.particles.orientation, axis=1), 1.0, rtol=1e-6);
+            self.assertTrue(numpy.all(numpy.abs(snap.particles.orientation - ref / norm) <= tol));
+
+    def test_quantize_stream(self):
+        self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=1, quantize=16,
+                          hoomd_only=True, stream=True);
+
+    # quantized files can only be read by hoomd, which the user must confirm
+    def test_quantize_hoomd_only(self):
+        self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=1, overwrite=True,
+                          quantize=16);
+
+    # quantized frames are not appended to a file that other readers can open
+    def test_quantize_append(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+
+        # skip the failing run in MPI, only the root rank raises the runtime error resulting in deadlock
+        if hoomd.comm.get_num_ranks() == 1:
+            dump.gsd(filename=self.tmp_file, group=group.all(), period=1, quantize=16, hoomd_only=True);
+            self.assertRaises(RuntimeError, run, 1);
+
     # test changing the order particles
     def test_remove(self):
         # remove particle so that tag 2 points to no particle, and particle tags are no longer contiguous
@@ -445,6 +536,41 @@ class gsd_read_tests (unittest.TestCase):
 
         init.read_gsd(filename=self.tmp_file, frame=-1);
 
+    # tests init.read_gsd reading particles on all ranks
+    def test_read_gsd_distributed(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+        context.initialize();
+
+        s = init.read_gsd(filename=self.tmp_file, frame=-1, distributed=True);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            numpy.testing.assert_array_equal(snap.angles.group, self.snapshot.angles.group);
+
+    # tests that reading the rows of quantized chunks on all ranks decodes the same values as the root rank
+    def test_read_gsd_distributed_quantize(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, quantize=12, hoomd_only=True,
+                 dynamic=['momentum']);
+        run(2);
+        ref = data.gsd_snapshot(self.tmp_file, frame=1);
+        context.initialize();
+
+        s = init.read_gsd(filename=self.tmp_file, frame=1, distributed=True);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, ref.particles.N);
+            for name in ['position', 'orientation', 'velocity', 'angmom', 'image']:
+                numpy.testing.assert_array_equal(getattr(snap.particles, name), getattr(ref.particles, name));
+            numpy.testing.assert_array_equal(snap.bonds.group, ref.bonds.group);
+            numpy.testing.assert_array_equal(snap.constraints.value, ref.constraints.value);
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove(self.tmp_file);
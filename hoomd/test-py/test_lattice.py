@@ -161,6 +161,32 @@ class lattice_unitcell_test (unittest.TestCase):
         sysdef = init.create_lattice(unitcell=uc, n=1);
         snap = sysdef.take_snapshot();
 
+    # check that the lattice built on each rank matches a replicated snapshot
+    def test_replicate(self):
+        uc = hoomd.lattice.unitcell(N = 2,
+                            a1 = [1.5, 0, 0],
+                            a2 = [0.3, 1.2, 0],
+                            a3 = [0.1, -0.2, 1],
+                            dimensions = 3,
+                            position = [[0, 0, 0], [0.74, 0.5, -0.49]],
+                            type_name = ["A", "B"]);
+        sysdef = init.create_lattice(unitcell=uc, n=[9,7,8]);
+        snap = sysdef.take_snapshot();
+
+        context.initialize();
+        ref = uc.get_snapshot();
+        ref.replicate(9,7,8);
+        init.read_snapshot(ref);
+        ref = hoomd.data.system_data(hoomd.context.current.system_definition).take_snapshot();
+
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, 2*9*7*8);
+            numpy.testing.assert_allclose(snap.box.Lx, ref.box.Lx);
+            numpy.testing.assert_allclose(snap.box.xy, ref.box.xy);
+            numpy.testing.assert_allclose(snap.particles.position, ref.particles.position, atol=1e-5);
+            numpy.testing.assert_array_equal(snap.particles.typeid, ref.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+
     def tearDown(self):
         context.initialize();
 
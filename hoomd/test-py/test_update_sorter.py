@@ -6,18 +6,58 @@ import hoomd;
 context.initialize()
 import unittest
 import os
+import numpy
 
 # tests for update.sorter
 class update_sorter_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
 
     # test set_params
     def test_set_params(self):
 
         context.current.sorter.set_params(grid=20);
 
+    # test that adaptive sorting skips sorts until the locality degrades past the tolerance
+    def test_adaptive(self):
+        sorter = context.current.sorter;
+        sorter.set_period(1);
+        sorter.set_params(adaptive=True, tolerance=1.5);
+
+        # the first check always sorts
+        run(1);
+        sorted_locality = sorter.cpp_updater.computeLocality();
+
+        # swapping two particles degrades the locality by less than the tolerance, so the sort is skipped
+        particles = self.s.particles;
+        N = len(particles);
+        p0 = particles[0].position;
+        particles[0].position = particles[N-1].position;
+        particles[N-1].position = p0;
+        locality = sorter.cpp_updater.computeLocality();
+        self.assertGreater(locality, sorted_locality);
+        self.assertLess(locality, 1.5*sorted_locality);
+
+        run(1);
+        self.assertAlmostEqual(sorter.cpp_updater.computeLocality(), locality, places=5);
+
+        # changing the parameters forces a sort
+        sorter.set_params(tolerance=1.5);
+        run(1);
+        self.assertAlmostEqual(sorter.cpp_updater.computeLocality(), sorted_locality, places=5);
+
+        # shuffling the positions degrades the locality past the tolerance, so the particles are sorted again
+        pos = [particles[i].position for i in range(N)];
+        perm = numpy.random.RandomState(42).permutation(N);
+        for i in range(N):
+            particles[i].position = pos[perm[i]];
+        locality = sorter.cpp_updater.computeLocality();
+        self.assertGreater(locality, 1.5*sorted_locality);
+
+        run(1);
+        self.assertAlmostEqual(sorter.cpp_updater.computeLocality(), sorted_locality, places=5);
+
     def tearDown(self):
         context.initialize();
 
@@ -0,0 +1,180 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+#include <cmath>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+
+#include "hoomd/GSDChunkEncoding.h"
+#include "hoomd/extern/gsd.h"
+
+using namespace std;
+using namespace hoomd::detail;
+
+/*! \file test_gsd_chunk_encoding.cc
+    \brief Implements unit tests for the GSD chunk encodings
+    \ingroup unit_tests
+*/
+
+//! Encode, decode and check the error bound for the given number of bits
+void quantize_round_trip(unsigned int bits)
+    {
+    const uint64_t N = 1000;
+    const uint32_t M = 3;
+    vector<float> data(N*M);
+    for (uint64_t i = 0; i < N; i++)
+        {
+        data[i*M + 0] = -50.0f + 0.1f*i;
+        data[i*M + 1] = float(sin(0.37*i));
+        data[i*M + 2] = 7.5f;
+        }
+
+    vector<char> encoded;
+    encodeQuantized(encoded, &data[0], N, M, bits);
+
+    // the payload is packed to the requested number of bits
+    UP_ASSERT_EQUAL(encoded.size(), sizeof(EncodedChunkHeader) + 2*M*sizeof(float) + (N*M*bits + 7)/8);
+
+    EncodedChunkHeader header;
+    UP_ASSERT(readEncodedChunkHeader(header, encoded));
+    UP_ASSERT_EQUAL(header.N, N);
+    UP_ASSERT_EQUAL(header.M, M);
+    UP_ASSERT_EQUAL(header.type, (uint8_t)GSD_TYPE_FLOAT);
+    UP_ASSERT_EQUAL(header.bits, bits);
+
+    vector<float> decoded(N*M);
+    UP_ASSERT(decodeChunk(&decoded[0], encoded));
+
+    float width[3] = {0.1f*(N-1), 2.0f, 0.0f};
+    for (uint64_t i = 0; i < N; i++)
+        for (uint32_t j = 0; j < M; j++)
+            {
+            float tol = width[j] / (2.0f * float((1 << bits) - 1)) + 1e-5f;
+            UP_ASSERT(fabs(decoded[i*M + j] - data[i*M + j]) <= tol);
+            }
+
+    // constant columns are exact
+    for (uint64_t i = 0; i < N; i++)
+        UP_ASSERT_EQUAL(decoded[i*M + 2], 7.5f);
+
+    // the ends of the range are exact
+    UP_ASSERT_EQUAL(decoded[0], data[0]);
+    }
+
+//! Test quantization with byte aligned and unaligned numbers of bits
+UP_TEST( quantize_bits )
+    {
+    quantize_round_trip(1);
+    quantize_round_trip(7);
+    quantize_round_trip(8);
+    quantize_round_trip(12);
+    quantize_round_trip(16);
+    quantize_round_trip(GSD_QUANTIZE_MAX_BITS);
+    }
+
+//! Test that empty chunks and invalid buffers are handled
+UP_TEST( quantize_invalid )
+    {
+    vector<char> encoded;
+    encodeQuantized(encoded, NULL, 0, 3, 16);
+
+    EncodedChunkHeader header;
+    UP_ASSERT(readEncodedChunkHeader(header, encoded));
+    UP_ASSERT_EQUAL(header.N, (uint64_t)0);
+
+    // truncated buffer
+    float data[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    encodeQuantized(encoded, data, 4, 1, 16);
+    encoded.pop_back();
+    UP_ASSERT(!readEncodedChunkHeader(header, encoded));
+
+    // unknown codec
+    encodeQuantized(encoded, data, 4, 1, 16);
+    encoded[0] = 100;
+    float out[4];
+    UP_ASSERT(!decodeChunk(out, encoded));
+    }
+
+//! Test that ranges of rows decode to the same values as the whole chunk
+UP_TEST( quantize_rows )
+    {
+    const uint64_t N = 101;
+    const uint32_t M = 3;
+    vector<float> data(N*M);
+    for (uint64_t i = 0; i < N*M; i++)
+        data[i] = float(cos(0.91*i)) * 10.0f;
+
+    unsigned int bits[3] = {5, 8, 13};
+    for (unsigned int b = 0; b < 3; b++)
+        {
+        vector<char> encoded;
+        encodeQuantized(encoded, &data[0], N, M, bits[b]);
+        vector<float> ref(N*M);
+        UP_ASSERT(decodeChunk(&ref[0], encoded));
+
+        EncodedChunkHeader header;
+        UP_ASSERT(readEncodedChunkHeader(header, encoded));
+        const float *lo = (const float *)&encoded[sizeof(EncodedChunkHeader)];
+        const float *width = lo + M;
+
+        // ranges that start and end in the middle of a byte
+        uint64_t ranges[4][2] = {{0, 1}, {1, 7}, {33, 50}, {N-3, 3}};
+        for (unsigned int r = 0; r < 4; r++)
+            {
+            uint64_t first_byte = 0;
+            uint64_t n_bytes = 0;
+            quantizedRowBytes(header, ranges[r][0], ranges[r][1], first_byte, n_bytes);
+            UP_ASSERT(quantizedDataOffset(M) + first_byte + n_bytes <= encoded.size());
+
+            // decode from a copy of only those bytes
+            vector<char> packed(encoded.begin() + quantizedDataOffset(M) + first_byte,
+                                encoded.begin() + quantizedDataOffset(M) + first_byte + n_bytes);
+            vector<float> rows(ranges[r][1]*M);
+            decodeQuantizedRows(&rows[0], header, lo, width, &packed[0], ranges[r][0], ranges[r][1]);
+            for (uint64_t i = 0; i < ranges[r][1]*M; i++)
+                UP_ASSERT_EQUAL(rows[i], ref[ranges[r][0]*M + i]);
+            }
+        }
+    }
+
+//! Test that decoded quaternions are scaled back to unit length
+UP_TEST( normalize_quaternions )
+    {
+    const uint64_t N = 100;
+    vector<float> data(N*4);
+    for (uint64_t i = 0; i < N; i++)
+        {
+        float a = float(i) * 0.1f;
+        data[i*4+0] = cos(a);
+        data[i*4+1] = sin(a) * 0.6f;
+        data[i*4+2] = sin(a) * 0.8f;
+        data[i*4+3] = 0.0f;
+        }
+
+    vector<char> encoded;
+    encodeQuantized(encoded, &data[0], N, 4, 8);
+    vector<float> out(N*4);
+    UP_ASSERT(decodeChunk(&out[0], encoded));
+    normalizeQuaternions(&out[0], N);
+
+    for (uint64_t i = 0; i < N; i++)
+        {
+        const float *q = &out[i*4];
+        float norm = sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+        UP_ASSERT(fabs(norm - 1.0f) < 1e-6f);
+        }
+
+    // zero quaternions are left unchanged
+    float zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    normalizeQuaternions(zero, 1);
+    for (unsigned int j = 0; j < 4; j++)
+        UP_ASSERT_EQUAL(zero[j], 0.0f);
+    }
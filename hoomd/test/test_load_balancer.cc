@@ -359,6 +359,116 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,0,1));
     }
 
+//! Tests particle redistribution with per-type weights
+template<class LB>
+void test_load_balancer_weights(std::shared_ptr<ExecutionConfiguration> exec_conf, const BoxDim& dest_box)
+{
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // create a system with sixteen particles of two types
+    BoxDim ref_box = BoxDim(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(16,          // number of particles
+                                                             dest_box,        // box dimensions
+                                                             2,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // every (y,z) quadrant has a row of four particles along x, the one at the smallest x is of type 1
+    for (unsigned int q=0; q < 4; ++q)
+        {
+        Scalar y = (q & 1) ? Scalar(0.5) : Scalar(-0.5);
+        Scalar z = (q & 2) ? Scalar(0.5) : Scalar(-0.5);
+        pdata->setPosition(4*q+0, TO_TRICLINIC(make_scalar3(-0.75,y,z)),false);
+        pdata->setPosition(4*q+1, TO_TRICLINIC(make_scalar3(-0.15,y,z)),false);
+        pdata->setPosition(4*q+2, TO_TRICLINIC(make_scalar3(0.25,y,z)),false);
+        pdata->setPosition(4*q+3, TO_TRICLINIC(make_scalar3(0.75,y,z)),false);
+        pdata->setType(4*q+0, 1);
+        }
+
+    SnapshotParticleData<Scalar> snap(16);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef,decomposition));
+    lb->setCommunicator(comm);
+    lb->enableDimension(1, false);
+    lb->enableDimension(2, false);
+    lb->setMaxIterations(100);
+
+    // migrate atoms
+    comm->migrateParticles();
+    const Index3D& di = decomposition->getDomainIndexer();
+    uint3 grid_pos = decomposition->getGridPos();
+    UP_ASSERT_EQUAL(pdata->getN(), 2);
+
+    // with unit weights the particle numbers are already balanced, and the cut does not move
+    for (unsigned int t=0; t < 10; ++t)
+        {
+        lb->update(t);
+        }
+    UP_ASSERT_EQUAL(pdata->getN(), 2);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(0)[1], 0.5, tol);
+
+    // a type 1 particle costs as much as three type 0 particles, so that the first two particles of a row
+    // are a load of 4 and the last two a load of 2
+    lb->setTypeWeight(1, Scalar(3.0));
+    for (unsigned int t=10; t < 20; ++t)
+        {
+        lb->update(t);
+        }
+
+    // the cut moves between the first two particles of every row, and every rank owns a load of 3
+    Scalar frac_x = decomposition->getCumulativeFractions(0)[1];
+    UP_ASSERT(frac_x > 0.125 && frac_x <= 0.425);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        Scalar load(0.0);
+        for (unsigned int i=0; i < pdata->getN(); ++i)
+            load += lb->getTypeWeight(__scalar_as_int(h_pos.data[i].w));
+        MY_CHECK_CLOSE(load, 3.0, tol);
+        }
+
+    if (grid_pos.x == 0)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 1);
+        }
+    else
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 3);
+        }
+
+    for (unsigned int q=0; q < 4; ++q)
+        {
+        unsigned int iy = (q & 1) ? 1 : 0;
+        unsigned int iz = (q & 2) ? 1 : 0;
+        UP_ASSERT_EQUAL(pdata->getOwnerRank(4*q+0), di(0,iy,iz));
+        UP_ASSERT_EQUAL(pdata->getOwnerRank(4*q+1), di(1,iy,iz));
+        UP_ASSERT_EQUAL(pdata->getOwnerRank(4*q+2), di(1,iy,iz));
+        UP_ASSERT_EQUAL(pdata->getOwnerRank(4*q+3), di(1,iy,iz));
+        }
+    }
+
 //! Tests basic particle redistribution
 UP_TEST( LoadBalancer_test_basic)
     {
@@ -395,6 +505,18 @@ UP_TEST( LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0,-.6,.7,.5));
     }
 
+//! Tests particle redistribution with per-type weights
+UP_TEST( LoadBalancer_test_weights)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    // cubic box
+    test_load_balancer_weights<LoadBalancer>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_weights<LoadBalancer>(exec_conf, BoxDim(1.0,.1,.2,.3));
+    // triclinic box 2
+    test_load_balancer_weights<LoadBalancer>(exec_conf, BoxDim(1.0,-.6,.7,.5));
+    }
+
 #ifdef ENABLE_CUDA
 //! Tests basic particle redistribution on the GPU
 UP_TEST( LoadBalancerGPU_test_basic)
@@ -431,6 +553,18 @@ UP_TEST( LoadBalancerGPU_test_ghost)
     // triclinic box 2
     test_load_balancer_ghost<LoadBalancerGPU>(exec_conf, BoxDim(1.0,-.6,.7,.5));
     }
+
+//! Tests particle redistribution with per-type weights on the GPU
+UP_TEST( LoadBalancerGPU_test_weights)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    // cubic box
+    test_load_balancer_weights<LoadBalancerGPU>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_weights<LoadBalancerGPU>(exec_conf, BoxDim(1.0,.1,.2,.3));
+    // triclinic box 2
+    test_load_balancer_weights<LoadBalancerGPU>(exec_conf, BoxDim(1.0,-.6,.7,.5));
+    }
 #endif // ENABLE_CUDA
 
 #endif // ENABLE_MPI
@@ -0,0 +1,148 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+/*! \file test_sfc_pack_updater.cc
+    \brief Unit tests for SFCPackUpdater
+    \ingroup unit_tests
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include "hoomd/SFCPackUpdater.h"
+#include "hoomd/RandomNumbers.h"
+
+using namespace std;
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+//! Thread counts to run the sort with
+static std::vector<unsigned int> get_num_threads()
+    {
+    #ifdef ENABLE_TBB
+    return std::vector<unsigned int>({1, 2, 3, 4});
+    #else
+    return std::vector<unsigned int>({1});
+    #endif
+    }
+
+//! Create a system with randomly placed particles
+std::shared_ptr<SystemDefinition> create_random_system(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                       unsigned int N,
+                                                       unsigned int dim)
+    {
+    Scalar L(20.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(L), 1, 0, 0, 0, 0, exec_conf));
+    sysdef->setNDimensions(dim);
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    hoomd::RandomGenerator rng(7, 7, 91);
+    hoomd::UniformDistribution<Scalar> uniform(-L/Scalar(2.0), L/Scalar(2.0));
+    for (unsigned int i = 0; i < N; i++)
+        {
+        h_pos.data[i].x = uniform(rng);
+        h_pos.data[i].y = uniform(rng);
+        h_pos.data[i].z = (dim == 2) ? Scalar(0.0) : uniform(rng);
+        }
+
+    return sysdef;
+    }
+
+//! Sort the particles and return the tags in memory order
+std::vector<unsigned int> sort_particles(std::shared_ptr<SystemDefinition> sysdef, unsigned int grid)
+    {
+    std::shared_ptr<SFCPackUpdater> sorter(new SFCPackUpdater(sysdef));
+    sorter->setGrid(grid);
+    sorter->update(0);
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    return std::vector<unsigned int>(h_tag.data, h_tag.data + pdata->getN());
+    }
+
+//! Checks that the radix sort orders 2D particles like std::sort on the bin index
+/*! In 2D, the particles are sorted on the row major bin index. A coarse grid puts many particles into the same bin,
+    which checks that the sort is stable.
+*/
+UP_TEST( SFCPackUpdater_radix_sort_2d )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    const unsigned int N = 1000;
+
+    unsigned int grids[2] = {16, 4096};
+    std::vector<unsigned int> num_threads = get_num_threads();
+    for (unsigned int g = 0; g < 2; g++)
+        {
+        for (unsigned int t = 0; t < num_threads.size(); t++)
+            {
+            #ifdef ENABLE_TBB
+            exec_conf->setNumThreads(num_threads[t]);
+            #endif
+            std::shared_ptr<SystemDefinition> sysdef = create_random_system(exec_conf, N, 2);
+            std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+            const BoxDim& box = pdata->getBox();
+            const unsigned int grid = grids[g];
+
+            // bin the particles in tag order, and sort the (bin, tag) pairs
+            std::vector< std::pair<unsigned int, unsigned int> > bins(N);
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+                for (unsigned int i = 0; i < N; i++)
+                    {
+                    Scalar3 p = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                    Scalar3 f = box.makeFraction(p, make_scalar3(0.0, 0.0, 0.0));
+                    unsigned int ib = (unsigned int)(f.x * grid) % grid;
+                    unsigned int jb = (unsigned int)(f.y * grid) % grid;
+                    bins[i] = std::pair<unsigned int, unsigned int>(ib*grid + jb, i);
+                    }
+                }
+            std::sort(bins.begin(), bins.end());
+
+            std::vector<unsigned int> order = sort_particles(sysdef, grid);
+            UP_ASSERT_EQUAL(order.size(), N);
+            for (unsigned int i = 0; i < N; i++)
+                UP_ASSERT_EQUAL(order[i], bins[i].second);
+            }
+        }
+    }
+
+//! Checks that the 3D sort order is a permutation that does not depend on the number of threads
+UP_TEST( SFCPackUpdater_radix_sort_3d )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    const unsigned int N = 1000;
+
+    std::vector<unsigned int> num_threads = get_num_threads();
+    std::vector<unsigned int> ref_order;
+    for (unsigned int t = 0; t < num_threads.size(); t++)
+        {
+        #ifdef ENABLE_TBB
+        exec_conf->setNumThreads(num_threads[t]);
+        #endif
+        std::shared_ptr<SystemDefinition> sysdef = create_random_system(exec_conf, N, 3);
+        std::vector<unsigned int> order = sort_particles(sysdef, 32);
+        UP_ASSERT_EQUAL(order.size(), N);
+
+        if (t == 0)
+            {
+            // every particle appears exactly once
+            std::vector<unsigned int> sorted_tags(order);
+            std::sort(sorted_tags.begin(), sorted_tags.end());
+            for (unsigned int i = 0; i < N; i++)
+                UP_ASSERT_EQUAL(sorted_tags[i], i);
+            ref_order = order;
+            }
+        else
+            {
+            for (unsigned int i = 0; i < N; i++)
+                UP_ASSERT_EQUAL(order[i], ref_order[i]);
+            }
+        }
+    }
@@ -236,6 +236,13 @@ class sort(_updater):
     Note:
         2D simulations do not use any additional memory and default to grid=4096.
 
+    The locality of the particle order is available as the log quantity ``sort_locality``: the mean distance between
+    particles that are adjacent in memory, in units of the mean interparticle spacing. It is close to one right after a
+    sort and grows as the particles diffuse. With ``adaptive=True``, a sort is only performed when the locality
+    exceeds *tolerance* times its value after the previous sort, and the period becomes the interval at which the
+    locality is checked. Set a shorter period when enabling adaptive sorting so that fast diffusing systems are still
+    sorted often enough. Calling :py:meth:`set_params()`, or changing the box, forces a sort at the next check.
+
     A sorter is created by default. To disable it or modify parameters, save the
     context and access the sorter through it::
 
@@ -262,14 +269,21 @@ class sort(_updater):
 
         self.setupUpdater(default_period);
 
-    def set_params(self, grid=None):
+        self.adaptive = False;
+        self.tolerance = 1.5;
+
+    def set_params(self, grid=None, adaptive=None, tolerance=None):
         R""" Change sorter parameters.
 
         Args:
             grid (int): New grid dimension (if set)
+            adaptive (bool): If True, only sort when the locality of the particle order has degraded (if set)
+            tolerance (float): Factor by which the locality may degrade before sorting in adaptive mode (if set)
 
         Examples::
             sorter.set_params(grid=128)
+            sorter.set_params(adaptive=True, tolerance=1.5)
+            sorter.set_period(20)
         """
 
         hoomd.util.print_status_line();
@@ -278,6 +292,13 @@ class sort(_updater):
         if grid is not None:
             self.cpp_updater.setGrid(grid);
 
+        if adaptive is not None or tolerance is not None:
+            if adaptive is not None:
+                self.adaptive = adaptive;
+            if tolerance is not None:
+                self.tolerance = tolerance;
+            self.cpp_updater.setAdaptive(self.adaptive, self.tolerance);
+
 class box_resize(_updater):
     R""" Rescale the system box size.
 
@@ -424,6 +445,20 @@ class balance(_updater):
     have significantly more pair force neighbors than others, this estimate of the load imbalance may not produce the
     optimal results.
 
+    When particles differ in cost, the number of particles can be replaced by a load. Each particle type can be given a
+    relative cost with *weights*, for example to account for shapes of different complexity in HPMC. With
+    *measure_time*, the wall clock time the integrator spent computing on each rank since the last balancing step
+    is used as the load of the rank, distributed over its particles in proportion to their weights. This captures
+    variations in cost that the particle count misses, such as dense regions with many pair force neighbors.
+    Communication time is not included in the measurement. Time measurement is only accurate when running on the CPU.
+    The load imbalance is then
+
+    .. math::
+
+        I = \frac{W(i)}{W / P}
+
+    where :math:`W(i)` is the load of processor :math:`i` and :math:`W` is the total load.
+
     A load balancing adjustment is only performed when the maximum load imbalance exceeds a *tolerance*. The ideal load
     balance is 1.0, so setting *tolerance* less than 1.0 will force an adjustment every *period*. The load balancer
     can attempt multiple iterations of balancing every *period*, and up to *maxiter* attempts can be made. The optimal
@@ -471,7 +506,7 @@ class balance(_updater):
         self.set_params(x,y,z,tolerance, maxiter)
         hoomd.util.unquiet_status()
 
-    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None):
+    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None, weights=None, measure_time=None):
         R""" Change load balancing parameters.
 
         Args:
@@ -480,12 +515,18 @@ class balance(_updater):
             z (bool): If True, balance in z dimension.
             tolerance (float): Load imbalance tolerance (if <= 1.0, balance every step).
             maxiter (int): Maximum number of iterations to attempt in a single step.
+            weights (dict): Relative cost of a particle, keyed by type name (types not given keep their weight, 1 by default).
+            measure_time (bool): If True, balance the compute time of the current integrator measured on each rank.
 
+        The integrator must be set before enabling *measure_time*. If the integrator is replaced, call
+        :py:meth:`set_params()` again.
 
         Examples::
 
             balance.set_params(x=True, y=False)
             balance.set_params(tolerance=0.02, maxiter=5)
+            balance.set_params(weights={'A': 1.0, 'B': 4.5})
+            balance.set_params(measure_time=True)
         """
         hoomd.util.print_status_line()
         self.check_initialization()
@@ -502,6 +543,18 @@ class balance(_updater):
         if maxiter is not None:
             self.maxiter = maxiter
             self.cpp_updater.setMaxIterations(self.maxiter)
+        if weights is not None:
+            pdata = hoomd.context.current.system_definition.getParticleData()
+            for name, weight in weights.items():
+                self.cpp_updater.setTypeWeight(pdata.getTypeByName(name), float(weight))
+        if measure_time is not None:
+            if measure_time:
+                if hoomd.context.current.integrator is None:
+                    hoomd.context.msg.error("update.balance: an integrator must be set to measure the compute time\n")
+                    raise RuntimeError('Error setting load balancing parameters')
+                self.cpp_updater.setIntegrator(hoomd.context.current.integrator.cpp_integrator)
+            else:
+                self.cpp_updater.setIntegrator(None)
 
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;